@@ -24,6 +24,7 @@
 #include "yb/client/table_handle.h"
 
 #include "yb/common/ql_value.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
@@ -38,6 +39,7 @@
 #include "yb/rocksdb/types.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_retention_policy.h"
 
 #include "yb/server/skewed_clock.h"
@@ -85,6 +87,7 @@ DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_backfill_sabotage_frequency);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_string(compression_type);
+DECLARE_bool(enable_load_balancing);
 
 namespace yb {
 namespace client {
@@ -1613,6 +1616,164 @@ TEST_F(QLTabletTest, FollowerRestartDuringWrite) {
   }
 }
 
+namespace {
+
+CHECKED_STATUS ChangeConfig(
+    const tablet::TabletPeerPtr& leader, consensus::ChangeConfigType type,
+    tserver::MiniTabletServer* server,
+    consensus::RaftPeerPB::MemberType member_type = consensus::RaftPeerPB::UNKNOWN_MEMBER_TYPE) {
+  consensus::ChangeConfigRequestPB req;
+  req.set_tablet_id(leader->tablet_id());
+  req.set_type(type);
+  auto* peer = req.mutable_server();
+  peer->set_permanent_uuid(server->server()->permanent_uuid());
+  if (type == consensus::ADD_SERVER) {
+    peer->set_member_type(member_type);
+    HostPortToPB(HostPort::FromBoundEndpoint(server->bound_rpc_addr()),
+                 peer->mutable_last_known_private_addr()->Add());
+  }
+  Synchronizer synchronizer;
+  boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+  RETURN_NOT_OK(leader->raft_consensus()->ChangeConfig(
+      req, synchronizer.AsStdStatusCallback(), &error_code));
+  return synchronizer.Wait();
+}
+
+Result<consensus::RaftPeerPB::MemberType> CommittedMemberType(
+    const tablet::TabletPeerPtr& leader, tserver::MiniTabletServer* server) {
+  for (const auto& peer : leader->raft_consensus()->CommittedConfig().peers()) {
+    if (peer.permanent_uuid() == server->server()->permanent_uuid()) {
+      return peer.member_type();
+    }
+  }
+  return STATUS_FORMAT(
+      NotFound, "$0 is not in the committed config", server->server()->permanent_uuid());
+}
+
+// Waits until the replica at the server is tombstoned after its removal from the config.
+CHECKED_STATUS WaitTombstoned(tserver::MiniTabletServer* server, const TabletId& tablet_id) {
+  return WaitFor([server, &tablet_id] {
+    tablet::TabletPeerPtr peer;
+    return !server->server()->tablet_manager()->LookupTablet(tablet_id, &peer) ||
+           peer->data_state() == tablet::TABLET_DATA_TOMBSTONED;
+  }, 30s, "Replica tombstoned");
+}
+
+// Waits until the replica at the server is bootstrapped with the specified member type.
+CHECKED_STATUS WaitReplicaRunning(
+    const tablet::TabletPeerPtr& leader, tserver::MiniTabletServer* server,
+    consensus::RaftPeerPB::MemberType member_type, tablet::TabletPeerPtr* peer) {
+  return WaitFor([&]() -> Result<bool> {
+    if (!server->server()->tablet_manager()->LookupTablet(leader->tablet_id(), peer) ||
+        (**peer).state() != tablet::RaftGroupStatePB::RUNNING) {
+      return false;
+    }
+    auto committed_member_type = CommittedMemberType(leader, server);
+    return committed_member_type.ok() && *committed_member_type == member_type;
+  }, 60s, Format("Replica running as $0", consensus::RaftPeerPB::MemberType_Name(member_type)));
+}
+
+} // namespace
+
+TEST_F(QLTabletTest, WitnessReplica) {
+  constexpr int kNumKeys = 100;
+
+  // Load balancer would add removed replicas back.
+  FLAGS_enable_load_balancing = false;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  ASSERT_NO_FATALS(FillTable(0, kNumKeys, table));
+
+  auto peers = ListTableActiveTabletLeadersPeers(cluster_.get(), table->id());
+  ASSERT_EQ(peers.size(), 1);
+  auto leader = peers.front();
+  const auto tablet_id = leader->tablet_id();
+  auto* leader_server = FindTabletLeader(cluster_.get(), tablet_id);
+  ASSERT_NE(leader_server, nullptr);
+  std::vector<tserver::MiniTabletServer*> followers;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    if (cluster_->mini_tablet_server(i) != leader_server) {
+      followers.push_back(cluster_->mini_tablet_server(i));
+    }
+  }
+  ASSERT_EQ(followers.size(), 2);
+  auto* witness_server = followers[0];
+  auto* data_server = followers[1];
+  LOG(INFO) << "Witness: " << witness_server->server()->permanent_uuid();
+
+  // Replace the data replica with a witness, so RF=3 is kept with 2 copies of the data.
+  ASSERT_OK(ChangeConfig(leader, consensus::REMOVE_SERVER, witness_server));
+  ASSERT_OK(WaitTombstoned(witness_server, tablet_id));
+  ASSERT_OK(ChangeConfig(
+      leader, consensus::ADD_SERVER, witness_server, consensus::RaftPeerPB::WITNESS));
+  tablet::TabletPeerPtr witness;
+  ASSERT_OK(WaitReplicaRunning(leader, witness_server, consensus::RaftPeerPB::WITNESS, &witness));
+  ASSERT_TRUE(witness->tablet()->is_witness());
+
+  auto session = CreateSession();
+  for (int i = kNumKeys; i != 2 * kNumKeys; ++i) {
+    SetValue(session, i, ValueForKey(i), table);
+  }
+  ASSERT_OK(cluster_->FlushTablets());
+
+  // Witness replicates the log, but does not have RocksDB.
+  ASSERT_OK(WaitFor([leader, witness] {
+    return witness->GetLatestLogEntryOpId() == leader->GetLatestLogEntryOpId();
+  }, 30s, "Witness replicated log"));
+  ASSERT_EQ(witness->tablet()->doc_db().regular, nullptr);
+  ASSERT_EQ(witness->tablet()->GetCurrentVersionNumSSTFiles(), 0);
+  ASSERT_FALSE(Env::Default()->FileExists(witness->tablet_metadata()->rocksdb_dir()));
+
+  // Follower read at the witness is rejected, so the client retries at a data replica.
+  {
+    tserver::ReadRequestPB req;
+    auto op = CreateReadOp(1, table);
+    std::string partition_key;
+    ASSERT_OK(op->GetPartitionKey(&partition_key));
+    auto* ql_batch = req.add_ql_batch();
+    *ql_batch = op->request();
+    const auto hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+    ql_batch->set_hash_code(hash_code);
+    ql_batch->set_max_hash_code(hash_code);
+    req.set_tablet_id(tablet_id);
+    req.set_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+
+    tserver::TabletServerServiceProxy proxy(
+        &witness_server->server()->proxy_cache(),
+        HostPort::FromBoundEndpoint(witness_server->bound_rpc_addr()));
+    rpc::RpcController controller;
+    controller.set_timeout(10s);
+    tserver::ReadResponsePB resp;
+    ASSERT_OK(proxy.Read(req, &resp, &controller));
+    ASSERT_TRUE(resp.has_error()) << resp.ShortDebugString();
+    ASSERT_EQ(resp.error().code(), tserver::TabletServerErrorPB::STALE_FOLLOWER);
+  }
+
+  // Leadership fails over to the other data replica, the witness votes but never leads.
+  leader_server->Shutdown();
+  ASSERT_OK(WaitFor([this, &tablet_id, data_server] {
+    return FindTabletLeader(cluster_.get(), tablet_id) == data_server;
+  }, 30s, "Data replica elected"));
+  for (int i = 2 * kNumKeys; i != 3 * kNumKeys; ++i) {
+    SetValue(session, i, ValueForKey(i), table);
+  }
+  ASSERT_NO_FATALS(VerifyTable(0, 3 * kNumKeys, table));
+  ASSERT_OK(leader_server->Start());
+
+  // Upgrade the witness to a full replica by removing it and adding it back as PRE_VOTER.
+  leader = ASSERT_RESULT(data_server->server()->tablet_manager()->LookupTablet(tablet_id));
+  ASSERT_OK(ChangeConfig(leader, consensus::REMOVE_SERVER, witness_server));
+  ASSERT_OK(WaitTombstoned(witness_server, tablet_id));
+  ASSERT_OK(ChangeConfig(
+      leader, consensus::ADD_SERVER, witness_server, consensus::RaftPeerPB::PRE_VOTER));
+  tablet::TabletPeerPtr upgraded;
+  ASSERT_OK(WaitReplicaRunning(leader, witness_server, consensus::RaftPeerPB::VOTER, &upgraded));
+  ASSERT_FALSE(upgraded->tablet()->is_witness());
+  ASSERT_NE(upgraded->tablet()->doc_db().regular, nullptr);
+  ASSERT_OK(WaitSync(0, 3 * kNumKeys, table));
+}
+
 TEST_F_EX(QLTabletTest, DataBlockKeyValueEncoding, QLTabletRf1Test) {
   constexpr auto kNumRows = 4000;
   constexpr auto kNumRowsPerBatch = 100;
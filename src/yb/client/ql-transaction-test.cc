@@ -53,11 +53,13 @@ DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
+DECLARE_bool(enable_wait_queues);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(TEST_delay_init_tablet_peer_ms);
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(max_wait_for_conflicting_transactions_ms);
 DECLARE_int32(remote_bootstrap_max_chunk_size);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
@@ -410,6 +412,36 @@ TEST_F(QLTransactionTest, InsertUpdate) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+// Transaction that writes to a single tablet right before commit, should not write intents.
+TEST_F(QLTransactionTest, SingleShardFastPath) {
+  constexpr int32_t kKey = 1;
+  constexpr int32_t kValue = 42;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  txn->SetLastFlushBeforeCommit();
+  ASSERT_OK(WriteRow(session, kKey, kValue));
+  ASSERT_EQ(CountIntents(cluster_.get()), 0);
+  ASSERT_OK(txn->CommitFuture().get());
+
+  VERIFY_ROW(CreateSession(), kKey, kValue);
+
+  // Transaction that already wrote something should use regular path for the last flush.
+  txn = CreateTransaction();
+  session = CreateSession(txn);
+  ASSERT_OK(WriteRow(session, kKey, kValue + 1));
+  txn->SetLastFlushBeforeCommit();
+  ASSERT_OK(WriteRow(session, kKey + 1, kValue));
+  ASSERT_GT(CountIntents(cluster_.get()), 0);
+  ASSERT_OK(txn->CommitFuture().get());
+
+  session = CreateSession();
+  VERIFY_ROW(session, kKey, kValue + 1);
+  VERIFY_ROW(session, kKey + 1, kValue);
+
+  AssertNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Cleanup) {
   WriteData();
   VerifyData();
@@ -566,6 +598,150 @@ TEST_F(QLTransactionTest, ConflictResolution) {
   }
 }
 
+// With wait queues, writers of the same key wait for each other instead of aborting, so all of
+// them commit.
+TEST_F(QLTransactionTest, WaitQueueSerializesWriters) {
+  constexpr int32_t kKey = 1;
+  constexpr int kNumWriters = 5;
+
+  FLAGS_enable_wait_queues = true;
+  FLAGS_max_wait_for_conflicting_transactions_ms = 60000;
+  // Writers don't conflict with transactions committed after their read time, so they could
+  // proceed once the blocker is committed.
+  SetIsolationLevel(IsolationLevel::SERIALIZABLE_ISOLATION);
+
+  auto blocker = CreateTransaction();
+  ASSERT_OK(WriteRow(CreateSession(blocker), kKey, 0));
+
+  std::atomic<int> num_written{0};
+  std::vector<Status> statuses(kNumWriters);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumWriters; ++i) {
+    threads.emplace_back([this, i, &num_written, &statuses] {
+      auto txn = CreateTransaction();
+      auto write_result = WriteRow(CreateSession(txn), kKey, i + 1);
+      if (!write_result.ok()) {
+        statuses[i] = write_result.status();
+        return;
+      }
+      num_written.fetch_add(1, std::memory_order_acq_rel);
+      statuses[i] = txn->CommitFuture().get();
+    });
+  }
+
+  // Writers wait while the blocker is running.
+  std::this_thread::sleep_for(2s);
+  ASSERT_EQ(num_written.load(std::memory_order_acquire), 0);
+
+  // Each commit lets the next writer through.
+  ASSERT_OK(blocker->CommitFuture().get());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& status : statuses) {
+    ASSERT_OK(status);
+  }
+  ASSERT_EQ(num_written.load(std::memory_order_acquire), kNumWriters);
+
+  auto value = ASSERT_RESULT(SelectRow(CreateSession(), kKey));
+  ASSERT_GT(value, 0);
+  ASSERT_LE(value, kNumWriters);
+}
+
+TEST_F(QLTransactionTest, WaitQueueReleasesLocksWhileWaiting) {
+  constexpr int32_t kKey = 1;
+
+  FLAGS_enable_wait_queues = true;
+  FLAGS_max_wait_for_conflicting_transactions_ms = 60000;
+  SetIsolationLevel(IsolationLevel::SERIALIZABLE_ISOLATION);
+
+  auto blocker = CreateTransaction();
+  auto blocker_session = CreateSession(blocker);
+  ASSERT_OK(WriteRow(blocker_session, kKey, 1));
+
+  Status waiter_status;
+  std::thread waiter_thread([this, &waiter_status] {
+    auto txn = CreateTransaction();
+    auto write_result = WriteRow(CreateSession(txn), kKey, 2);
+    waiter_status = write_result.ok() ? txn->CommitFuture().get() : write_result.status();
+  });
+
+  // Let the waiter start waiting for the blocker.
+  std::this_thread::sleep_for(1s);
+
+  // The waiter does not hold the lock on the key while waiting, so the blocker could write the same
+  // key again without waiting for the waiter.
+  auto start = CoarseMonoClock::now();
+  ASSERT_OK(WriteRow(blocker_session, kKey, 3));
+  ASSERT_LT(CoarseMonoClock::now() - start, 10s);
+  ASSERT_OK(blocker->CommitFuture().get());
+
+  waiter_thread.join();
+  ASSERT_OK(waiter_status);
+  auto value = ASSERT_RESULT(SelectRow(CreateSession(), kKey));
+  ASSERT_EQ(2, value);
+}
+
+TEST_F(QLTransactionTest, WaitQueueDetectsDeadlockAcrossTablets) {
+  constexpr int32_t kMaxKey = 100;
+
+  FLAGS_enable_wait_queues = true;
+  FLAGS_max_wait_for_conflicting_transactions_ms = 60000;
+  SetIsolationLevel(IsolationLevel::SERIALIZABLE_ISOLATION);
+
+  // Pick keys from different tablets, so the deadlock could not be detected by a single tablet.
+  auto session = CreateSession();
+  const int32_t key1 = 0;
+  auto op1 = ASSERT_RESULT(WriteRow(session, key1, 0));
+  int32_t key2 = -1;
+  for (int32_t key = key1 + 1; key <= kMaxKey && key2 < 0; ++key) {
+    auto op = ASSERT_RESULT(WriteRow(session, key, 0));
+    if (op->tablet()->tablet_id() != op1->tablet()->tablet_id()) {
+      key2 = key;
+    }
+  }
+  ASSERT_GE(key2, 0);
+
+  auto txn1 = CreateTransaction();
+  auto session1 = CreateSession(txn1);
+  auto txn2 = CreateTransaction();
+  auto session2 = CreateSession(txn2);
+  ASSERT_OK(WriteRow(session1, key1, 1));
+  ASSERT_OK(WriteRow(session2, key2, 2));
+
+  // txn1 waits for txn2 on the tablet of key2, while txn2 waits for txn1 on the tablet of key1.
+  auto start = CoarseMonoClock::now();
+  auto future1 = std::async(std::launch::async, [this, session1, key2] {
+    return ResultToStatus(WriteRow(session1, key2, 1));
+  });
+  auto future2 = std::async(std::launch::async, [this, session2, key1] {
+    return ResultToStatus(WriteRow(session2, key1, 2));
+  });
+
+  // The master finds the cycle and fails the wait of one of the transactions.
+  ASSERT_OK(WaitFor([&future1, &future2] {
+    return future1.wait_for(0s) == std::future_status::ready ||
+           future2.wait_for(0s) == std::future_status::ready;
+  }, 30s, "Deadlock detected"));
+  ASSERT_LT(CoarseMonoClock::now() - start,
+            FLAGS_max_wait_for_conflicting_transactions_ms * 1ms);
+  const bool txn1_failed = future1.wait_for(0s) == std::future_status::ready;
+  auto& victim_future = txn1_failed ? future1 : future2;
+  auto& winner_future = txn1_failed ? future2 : future1;
+  auto victim_status = victim_future.get();
+  ASSERT_TRUE(victim_status.IsTryAgain()) << victim_status;
+
+  // The client aborts the victim after the conflict, which lets the other transaction through.
+  (txn1_failed ? txn1 : txn2)->Abort();
+  ASSERT_OK(winner_future.get());
+  auto& winner = txn1_failed ? txn2 : txn1;
+  ASSERT_OK(winner->CommitFuture().get());
+
+  const int32_t winner_value = txn1_failed ? 2 : 1;
+  ASSERT_EQ(winner_value, ASSERT_RESULT(SelectRow(CreateSession(), key1)));
+  ASSERT_EQ(winner_value, ASSERT_RESULT(SelectRow(CreateSession(), key2)));
+}
+
 TEST_F(QLTransactionTest, SimpleWriteConflict) {
   auto transaction = CreateTransaction();
   ASSERT_OK(WriteRows(CreateSession(transaction)));
@@ -32,6 +32,7 @@
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/scheduler.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
@@ -62,6 +63,13 @@ DEFINE_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
 DECLARE_uint64(max_clock_skew_usec);
 
+DEFINE_bool(enable_single_shard_transaction_fast_path, true,
+            "Execute writes of transaction, that touch a single tablet and are flushed right "
+            "before commit, as a single shard operation. "
+            "See YBTransaction::SetLastFlushBeforeCommit.");
+TAG_FLAG(enable_single_shard_transaction_fast_path, advanced);
+TAG_FLAG(enable_single_shard_transaction_fast_path, runtime);
+
 DEFINE_test_flag(int32, transaction_inject_flushed_delay_ms, 0,
                  "Inject delay before processing flushed operations by transaction.");
 
@@ -303,6 +311,30 @@ class YBTransaction::Impl final {
 
     {
       UNIQUE_LOCK(lock, mutex_);
+      if (single_shard_ || (initial && CouldUseSingleShardUnlocked(*ops_info))) {
+        Status status;
+        if (single_shard_ && initial) {
+          // Ops of the single shard flush are already committed, so only this flush is failed.
+          // Transaction itself is not failed, so commit still reports that they are committed.
+          status = STATUS(IllegalState, "Flush after single shard flush of transaction");
+          LOG_WITH_PREFIX(DFATAL) << status;
+        } else if (!single_shard_) {
+          VLOG_WITH_PREFIX(2) << "Prepare, single shard";
+          TRACE_TO(trace_, "Single shard");
+          single_shard_ = true;
+        }
+        lock.unlock();
+        if (status.ok()) {
+          // Operations are sent without transaction metadata, so they are non transactional.
+          ops_info->metadata = {};
+          return true;
+        }
+        if (waiter) {
+          waiter(status);
+        }
+        return false;
+      }
+
       const bool defer = !ready_;
 
       if (!defer || initial) {
@@ -372,6 +404,27 @@ class YBTransaction::Impl final {
     return true;
   }
 
+  void SetLastFlushBeforeCommit() EXCLUDES(mutex_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_flush_before_commit_ = true;
+  }
+
+  // Whether ops could be executed as single shard operation, instead of writing intents.
+  bool CouldUseSingleShardUnlocked(const InFlightOpsGroupsWithMetadata& ops_info) REQUIRES(mutex_) {
+    if (!last_flush_before_commit_ ||
+        !GetAtomicFlag(&FLAGS_enable_single_shard_transaction_fast_path)) {
+      return false;
+    }
+    // Transaction should not have any other state, that should be committed with those ops.
+    if (child_ || !tablets_.empty() || subtransaction_opt_ != boost::none ||
+        read_point_.GetReadTime() ||
+        state_.load(std::memory_order_acquire) != TransactionState::kRunning) {
+      return false;
+    }
+    return ops_info.groups.size() == 1 &&
+           ops_info.groups.front().begin->yb_op->group() == OpGroup::kWrite;
+  }
+
   void ExpectOperations(size_t count) EXCLUDES(mutex_) {
     std::lock_guard<std::mutex> lock(mutex_);
     running_requests_ += count;
@@ -416,7 +469,9 @@ class YBTransaction::Impl final {
         }
         const std::string* prev_tablet_id = nullptr;
         for (const auto& op : ops) {
-          if (op.yb_op->applied() && op.yb_op->should_add_intents(metadata_.isolation)) {
+          // Single shard operations do not write intents, so there is nothing to commit.
+          if (!single_shard_ && op.yb_op->applied() &&
+              op.yb_op->should_add_intents(metadata_.isolation)) {
             const std::string& tablet_id = op.tablet->tablet_id();
             if (prev_tablet_id == nullptr || tablet_id != *prev_tablet_id) {
               prev_tablet_id = &tablet_id;
@@ -425,7 +480,8 @@ class YBTransaction::Impl final {
           }
         }
       } else {
-        if (status.IsTryAgain()) {
+        // Failed single shard operation did not write anything, so there is nothing to abort.
+        if (status.IsTryAgain() && !single_shard_) {
           auto state = state_.load(std::memory_order_acquire);
           VLOG_WITH_PREFIX(4) << "Abort desired, state: " << AsString(state);
           if (state == TransactionState::kRunning) {
@@ -1257,6 +1313,10 @@ class YBTransaction::Impl final {
   size_t running_requests_ GUARDED_BY(mutex_) = 0;
   // Set to true after commit record is replicated. Used only during transaction sealing.
   bool commit_replicated_ = false;
+  // See YBTransaction::SetLastFlushBeforeCommit.
+  bool last_flush_before_commit_ GUARDED_BY(mutex_) = false;
+  // Ops of this transaction were executed as single shard operation.
+  bool single_shard_ GUARDED_BY(mutex_) = false;
 };
 
 CoarseTimePoint AdjustDeadline(CoarseTimePoint deadline) {
@@ -1312,6 +1372,10 @@ void YBTransaction::ExpectOperations(size_t count) {
   impl_->ExpectOperations(count);
 }
 
+void YBTransaction::SetLastFlushBeforeCommit() {
+  impl_->SetLastFlushBeforeCommit();
+}
+
 void YBTransaction::Flushed(
     const internal::InFlightOps& ops, const ReadHybridTime& used_read_time, const Status& status) {
   impl_->Flushed(ops, used_read_time, status);
@@ -129,6 +129,13 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   // number of ops.
   void ExpectOperations(size_t count);
 
+  // Notifies transaction that the next flush is the last one before commit.
+  // If nothing was written or read in this transaction yet, and this flush contains writes to a
+  // single tablet only, they are executed as a single shard operation. So they are written directly
+  // to regular DB by one Raft operation, and commit does not have to contact status tablet.
+  // Caller should not flush anything else in this transaction after that, such flush fails.
+  void SetLastFlushBeforeCommit();
+
   // Notifies transaction that specified ops were flushed with some status.
   void Flushed(
       const internal::InFlightOps& ops, const ReadHybridTime& used_read_time, const Status& status);
@@ -100,6 +100,19 @@ class YQLStorageIf {
                                      const ReadHybridTime& read_time,
                                      const QLValuePB& ybctid,
                                      common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
+
+  // Create iterator for querying multiple rows by ybctid. Rows should be looked up with SeekTuple
+  // in increasing order of ybctid, starting from min_ybctid and up to max_ybctid, so that a single
+  // iterator is shared by all lookups.
+  virtual CHECKED_STATUS GetIterator(uint64 stmt_id,
+                                     const Schema& projection,
+                                     const Schema& schema,
+                                     const TransactionOperationContextOpt& txn_op_context,
+                                     CoarseTimePoint deadline,
+                                     const ReadHybridTime& read_time,
+                                     const QLValuePB& min_ybctid,
+                                     const QLValuePB& max_ybctid,
+                                     common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
 };
 
 }  // namespace common
@@ -31,6 +31,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
+#include "yb/util/status_callback.h"
 #include "yb/util/strongly_typed_bool.h"
 #include "yb/util/strongly_typed_uuid.h"
 #include "yb/util/tostring.h"
@@ -158,6 +159,15 @@ class TransactionStatusManager {
 
   virtual void Cleanup(TransactionIdSet&& set) = 0;
 
+  // Invokes callback when any of blockers is finished on this tablet, or deadline is reached.
+  // Returns false, without invoking callback, when waiting is not supported or would result in
+  // a deadlock.
+  virtual bool WaitForTransactions(
+      const TransactionId& waiter, const std::vector<TransactionId>& blockers,
+      CoarseTimePoint deadline, StdStatusCallback callback) {
+    return false;
+  }
+
   // For each pair fills second with priority of transaction with id equals to first.
   virtual void FillPriorities(
       boost::container::small_vector_base<std::pair<TransactionId, uint64_t>>* inout) = 0;
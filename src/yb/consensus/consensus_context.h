@@ -46,6 +46,12 @@ class ConsensusContext {
 
   virtual bool ShouldApplyWrite() = 0;
 
+  // Invoked on follower with consecutive committed write operations, before they are applied one
+  // by one. Implementation could write their data to storage in a single batch, so applying each
+  // of them only has to update in-memory state.
+  // Returns index of the last operation whose data is written, or 0 if none of them is written.
+  virtual int64_t ApplyWritesInBatch(const ConsensusRounds& rounds) { return 0; }
+
   // Performs steps to prepare request for peer.
   // For instance it could enqueue some operations to the Raft.
   //
@@ -24,6 +24,8 @@ namespace consensus {
 class Consensus;
 class ConsensusContext;
 class ConsensusRoundCallback;
+class MultiRaftHeartbeatBatcher;
+class MultiRaftManager;
 class PeerProxyFactory;
 class PeerMessageQueue;
 class RaftConfigPB;
@@ -76,6 +78,17 @@ typedef std::vector<ReplicateMsgPtr> ReplicateMsgs;
 YB_STRONGLY_TYPED_BOOL(TEST_SuppressVoteRequest);
 YB_STRONGLY_TYPED_BOOL(PreElection);
 
+// Kind of the update request sent by the leader to a peer.
+YB_DEFINE_ENUM(
+    PeerRequestKind,
+    // No other requests are in flight, starts right after the last op acked by the peer.
+    (kRegular)
+    // Sent while pipelined requests are in flight, continues after the last op sent to the peer.
+    (kRegularContinuation)
+    // Sent while another request is in flight, continues after the last op sent to the peer and
+    // does not carry leader leases.
+    (kPipelined));
+
 } // namespace consensus
 
 } // namespace yb
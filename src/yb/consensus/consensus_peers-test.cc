@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <chrono>
 
 #include <gtest/gtest.h>
@@ -55,6 +56,8 @@ using namespace std::chrono_literals;
 
 METRIC_DECLARE_entity(tablet);
 
+DECLARE_int32(consensus_max_inflight_requests_per_peer);
+
 namespace yb {
 namespace consensus {
 
@@ -71,6 +74,29 @@ const char* kTabletId = "test-peers-tablet";
 const char* kLeaderUuid = "peer-0";
 const char* kFollowerUuid = "peer-1";
 
+// Proxy that responds after the specified network round trip time. Unlike NoOpTestPeerProxy, it
+// allows several requests to be in flight at the same time.
+class RoundTripPeerProxy : public NoOpTestPeerProxy {
+ public:
+  RoundTripPeerProxy(ThreadPool* pool, ThreadPool* delay_pool, const RaftPeerPB& peer_pb,
+                     MonoDelta round_trip_time)
+      : NoOpTestPeerProxy(pool, peer_pb), delay_pool_(delay_pool),
+        round_trip_time_(round_trip_time) {}
+
+ protected:
+  void RegisterCallbackAndRespond(Method method, const rpc::ResponseCallback& callback) override {
+    auto round_trip_time = round_trip_time_;
+    WARN_NOT_OK(delay_pool_->SubmitFunc([callback, round_trip_time] {
+      SleepFor(round_trip_time);
+      callback();
+    }), "Submit failed");
+  }
+
+ private:
+  ThreadPool* const delay_pool_;
+  const MonoDelta round_trip_time_;
+};
+
 class ConsensusPeersTest : public YBTest {
  public:
   ConsensusPeersTest()
@@ -144,6 +170,65 @@ class ConsensusPeersTest : public YBTest {
     return proxy_ptr;
   }
 
+  // Appends ops one by one at a fixed rate, while the single remote peer responds after a fixed
+  // round trip time. Reports the time it takes to replicate each op.
+  void BenchmarkReplicationLatency(int max_inflight_requests) {
+    FLAGS_consensus_max_inflight_requests_per_peer = max_inflight_requests;
+    constexpr int kNumOps = 200;
+    constexpr int kTerm = 2;
+    const MonoDelta kRoundTripTime = 5ms;
+    const MonoDelta kAppendInterval = 1ms;
+
+    std::unique_ptr<ThreadPool> delay_pool;
+    ASSERT_OK(ThreadPoolBuilder("delay").set_max_threads(kNumOps).Build(&delay_pool));
+
+    RaftPeerPB peer_pb;
+    peer_pb.set_permanent_uuid(kFollowerUuid);
+    std::shared_ptr<Peer> remote_peer = ASSERT_RESULT(Peer::NewRemotePeer(
+        peer_pb, kTabletId, kLeaderUuid,
+        PeerProxyPtr(new RoundTripPeerProxy(
+            raft_pool_.get(), delay_pool.get(), peer_pb, kRoundTripTime)),
+        message_queue_.get(), raft_pool_token_.get(), nullptr /* consensus */, messenger_.get()));
+    auto se = ScopeExit([&remote_peer, &delay_pool] {
+      remote_peer->Close();
+      delay_pool->Shutdown();
+    });
+    remote_peer->SetTermForTest(kTerm);
+
+    std::vector<MonoTime> append_times;
+    std::vector<MonoDelta> latencies;
+    int64_t replicated_index = 0;
+    auto next_append = MonoTime::Now();
+    while (replicated_index < kNumOps) {
+      auto now = MonoTime::Now();
+      if (append_times.size() < kNumOps && now >= next_append) {
+        append_times.push_back(now);
+        ASSERT_OK(message_queue_->TEST_AppendOperation(
+            CreateDummyReplicate(kTerm, append_times.size(), clock_->Now(), 0)));
+        ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+        next_append += kAppendInterval;
+      }
+      auto majority_replicated_index = consensus_->majority_replicated_op_id().index;
+      now = MonoTime::Now();
+      while (replicated_index < majority_replicated_index) {
+        latencies.push_back(now - append_times[replicated_index]);
+        ++replicated_index;
+      }
+      ASSERT_LE(now - append_times.front(), MonoDelta(30s))
+          << "Replicated only " << replicated_index;
+      std::this_thread::sleep_for(100us);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    MonoDelta total = MonoDelta::kZero;
+    for (const auto& latency : latencies) {
+      total += latency;
+    }
+    LOG(INFO) << "Max inflight requests: " << max_inflight_requests
+              << ", avg latency: " << total / kNumOps
+              << ", p99 latency: " << latencies[kNumOps * 99 / 100];
+  }
+
   void CheckLastLogEntry(int term, int index) {
     ASSERT_EQ(log_->GetLatestEntryOpId(), yb::OpId(term, index));
   }
@@ -403,5 +488,13 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+TEST_F(ConsensusPeersTest, ReplicationLatency) {
+  BenchmarkReplicationLatency(1);
+}
+
+TEST_F(ConsensusPeersTest, PipelinedReplicationLatency) {
+  BenchmarkReplicationLatency(4);
+}
+
 }  // namespace consensus
 }  // namespace yb
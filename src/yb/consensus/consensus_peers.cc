@@ -47,6 +47,7 @@
 #include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/strings/substitute.h"
@@ -80,6 +81,9 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_int32(consensus_max_inflight_requests_per_peer);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_int32(raft_quiescent_heartbeat_interval_ms);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -110,6 +114,13 @@ using rpc::PeriodicTimer;
 using rpc::RpcController;
 using strings::Substitute;
 
+struct Peer::PipelinedRequest {
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  rpc::RpcController controller;
+  bool in_flight = false;
+};
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, ThreadPoolToken* raft_pool_token, Consensus* consensus,
@@ -137,6 +148,9 @@ Status Peer::Init() {
       messenger_,
       [weak_peer]() {
         if (auto p = weak_peer.lock()) {
+          if (p->SkipQuiescentHeartbeat()) {
+            return;
+          }
           Status s = p->SignalRequest(RequestTriggerMode::kAlwaysSend);
         }
       },
@@ -151,6 +165,9 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_lock = LockPerforming(std::try_to_lock);
   if (!performing_lock.owns_lock()) {
+    if (trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      return SchedulePipelinedRequests();
+    }
     return Status::OK();
   }
 
@@ -217,9 +234,11 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   int64_t commit_index_before = request_.has_committed_op_id() ?
       request_.committed_op_id().index() : kMinimumOpIdIndex;
   ReplicateMsgsHolder msgs_holder;
+  const auto kind = num_pipelined_in_flight_ != 0 ? PeerRequestKind::kRegularContinuation
+                                                  : PeerRequestKind::kRegular;
   Status s = queue_->RequestForPeer(
       peer_pb_.permanent_uuid(), &request_, &msgs_holder, &needs_remote_bootstrap,
-      &member_type, &last_exchange_successful);
+      &member_type, &last_exchange_successful, kind);
   int64_t commit_index_after = request_.has_committed_op_id() ?
       request_.committed_op_id().index() : kMinimumOpIdIndex;
 
@@ -323,9 +342,175 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   needs_cleanup = false;
   msgs_holder.ReleaseOps();
 
+  // Heartbeats could be batched with heartbeats of other tablets to the same server.
+  if (!req_has_ops && trigger_mode == RequestTriggerMode::kAlwaysSend &&
+      proxy_->UpdateBatchedAsync(
+          &request_, &response_, std::bind(&Peer::DoProcessResponse, retain_self, _1))) {
+    return;
+  }
+
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
+
+  if (req_has_ops) {
+    SendPipelinedRequests();
+  }
+}
+
+bool Peer::SkipQuiescentHeartbeat() {
+  if (!queue_->IsQuiescent()) {
+    next_quiescent_heartbeat_ = CoarseTimePoint::min();
+    return false;
+  }
+  auto now = CoarseMonoClock::now();
+  if (now < next_quiescent_heartbeat_) {
+    return true;
+  }
+  next_quiescent_heartbeat_ =
+      now + GetAtomicFlag(&FLAGS_raft_quiescent_heartbeat_interval_ms) * 1ms;
+  return false;
+}
+
+Status Peer::SchedulePipelinedRequests() {
+  if (FLAGS_consensus_max_inflight_requests_per_peer <= 1 ||
+      pipelined_send_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+    return Status::OK();
+  }
+
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      pipelined_send_scheduled_.store(false, std::memory_order_release);
+      return STATUS(IllegalState, "Peer was closed.");
+    }
+    using_thread_pool_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  auto status = raft_pool_token_->SubmitFunc(
+      std::bind(&Peer::SendPipelinedRequests, shared_from_this()));
+  using_thread_pool_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!status.ok()) {
+    pipelined_send_scheduled_.store(false, std::memory_order_release);
+  }
+  return status;
+}
+
+void Peer::SendPipelinedRequests() {
+  pipelined_send_scheduled_.store(false, std::memory_order_release);
+  const auto max_pipelined_requests = FLAGS_consensus_max_inflight_requests_per_peer - 1;
+  if (max_pipelined_requests <= 0) {
+    return;
+  }
+
+  std::vector<PipelinedRequest*> requests_to_send;
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock() || state_ != kPeerRunning || failed_attempts_ > 0) {
+      return;
+    }
+
+    while (num_pipelined_in_flight_ < static_cast<size_t>(max_pipelined_requests)) {
+      PipelinedRequest* pipelined_request = nullptr;
+      for (const auto& request : pipelined_requests_) {
+        if (!request->in_flight) {
+          pipelined_request = request.get();
+          break;
+        }
+      }
+      if (!pipelined_request) {
+        pipelined_requests_.push_back(std::make_unique<PipelinedRequest>());
+        pipelined_request = pipelined_requests_.back().get();
+      }
+
+      auto& request = pipelined_request->request;
+      ReplicateMsgsHolder msgs_holder;
+      bool needs_remote_bootstrap = false;
+      auto status = queue_->RequestForPeer(
+          peer_pb_.permanent_uuid(), &request, &msgs_holder, &needs_remote_bootstrap,
+          nullptr /* member_type */, nullptr /* last_exchange_successful */,
+          PeerRequestKind::kPipelined);
+      if (!status.ok()) {
+        VLOG_WITH_PREFIX(1) << "Could not obtain pipelined request from queue for peer: "
+                            << status;
+        break;
+      }
+      // Regular request takes care of remote bootstrap and of peers that are not in sync.
+      if (needs_remote_bootstrap || request.ops().empty()) {
+        break;
+      }
+
+      if (request.tablet_id().empty()) {
+        request.set_tablet_id(tablet_id_);
+        request.set_caller_uuid(leader_uuid_);
+        request.set_dest_uuid(peer_pb_.permanent_uuid());
+      }
+
+      msgs_holder.ReleaseOps();
+      pipelined_request->in_flight = true;
+      ++num_pipelined_in_flight_;
+      requests_to_send.push_back(pipelined_request);
+    }
+
+    if (!requests_to_send.empty()) {
+      heartbeater_->Snooze();
+    }
+  }
+
+  for (auto* pipelined_request : requests_to_send) {
+    VLOG_WITH_PREFIX(2) << "Sending pipelined request with " << pipelined_request->request.ops_size()
+                        << " ops";
+    pipelined_request->controller.set_invoke_callback_mode(
+        rpc::InvokeCallbackMode::kThreadPoolHigh);
+    proxy_->UpdateAsync(
+        &pipelined_request->request, RequestTriggerMode::kNonEmptyOnly,
+        &pipelined_request->response, &pipelined_request->controller,
+        std::bind(&Peer::ProcessPipelinedResponse, shared_from_this(), pipelined_request));
+  }
+}
+
+void Peer::ProcessPipelinedResponse(PipelinedRequest* pipelined_request) {
+  auto& request = pipelined_request->request;
+  const auto& response = pipelined_request->response;
+  request.mutable_ops()->ExtractSubrange(0, request.ops().size(), nullptr /* elements */);
+
+  Status status = pipelined_request->controller.status();
+  if (status.ok()) {
+    status = pipelined_request->controller.thread_pool_failure();
+  }
+  pipelined_request->controller.Reset();
+
+  bool more_pending;
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return;
+    }
+    pipelined_request->in_flight = false;
+    --num_pipelined_in_flight_;
+
+    if (status.ok() && response.has_propagated_hybrid_time()) {
+      queue_->clock()->Update(HybridTime(response.propagated_hybrid_time()));
+    }
+
+    // Errors are handled by the regular request, here we just restart the pipeline.
+    if (!status.ok() || response.has_error() ||
+        (response.status().has_error() &&
+            response.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
+      YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 5)
+          << "Pipelined request failed: " << (status.ok() ? response.ShortDebugString()
+                                                          : status.ToString());
+      queue_->RequestFailed(peer_pb_.permanent_uuid());
+      return;
+    }
+
+    more_pending = queue_->ResponseFromPeer(
+        peer_pb_.permanent_uuid(), response, PeerRequestKind::kPipelined);
+  }
+
+  if (more_pending) {
+    WARN_NOT_OK(SignalRequest(RequestTriggerMode::kNonEmptyOnly),
+                LogPrefix() + "Failed to signal request");
+  }
 }
 
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
@@ -349,6 +534,12 @@ void Peer::ProcessResponse() {
   }
   controller_.Reset();
 
+  DoProcessResponse(status);
+}
+
+void Peer::DoProcessResponse(const Status& status) {
+  DCHECK(performing_mutex_.is_locked()) << "Got a response when nothing was pending";
+
   auto performing_lock = LockPerforming(std::adopt_lock);
 
   auto processing_lock = StartProcessingUnlocked();
@@ -471,6 +662,7 @@ void Peer::ProcessRemoteBootstrapResponse() {
 void Peer::ProcessResponseError(const Status& status) {
   DCHECK(performing_mutex_.is_locked());
   failed_attempts_++;
+  queue_->RequestFailed(peer_pb_.permanent_uuid());
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5) << "Couldn't send request. "
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
       << " Already tried " << failed_attempts_ << " times. State: " << state_;
@@ -525,8 +717,10 @@ void Peer::CleanRequestOps() {
   request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -538,6 +732,16 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::UpdateBatchedAsync(const ConsensusRequestPB* request,
+                                      ConsensusResponsePB* response,
+                                      StdStatusCallback callback) {
+  if (!multi_raft_batcher_ || !FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return false;
+  }
+  multi_raft_batcher_->AddRequestToBatch(request, response, std::move(callback));
+  return true;
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -570,13 +774,16 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto batcher = multi_raft_manager_ ? multi_raft_manager_->AddOrGetBatcher(hostport) : nullptr;
+  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy), std::move(batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
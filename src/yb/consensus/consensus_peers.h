@@ -52,6 +52,7 @@
 #include "yb/util/net/net_util.h"
 #include "yb/util/semaphore.h"
 #include "yb/util/status.h"
+#include "yb/util/status_callback.h"
 
 namespace yb {
 class HostPort;
@@ -114,6 +115,12 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// When consensus_max_inflight_requests_per_peer is greater than 1, the peer also sends pipelined
+// requests while the regular request is in flight. Pipelined requests continue after the last op
+// sent to the peer, so the leader does not wait for the round trip before sending the next batch.
+// They don't carry leader leases, so leases are still extended only by the regular requests.
+// If any request fails, the queue restarts sending from the last op acked by the peer.
+//
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -171,10 +178,29 @@ class Peer : public std::enable_shared_from_this<Peer> {
  private:
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
+  // Returns true if the leader is quiescent and it is not yet time for the next quiescent
+  // heartbeat, so the regular heartbeat should be skipped.
+  bool SkipQuiescentHeartbeat();
+
   // Signals that a response was received from the peer. This method does response handling that
   // requires IO or may block.
   void ProcessResponse();
 
+  // Handles response to the update request, status is the status of the RPC that carried it.
+  void DoProcessResponse(const Status& status);
+
+  struct PipelinedRequest;
+
+  // Submits SendPipelinedRequests() to the thread pool, unless it is already submitted.
+  CHECKED_STATUS SchedulePipelinedRequests();
+
+  // Sends pipelined requests while there are ops that were not sent to the peer yet, and the number
+  // of requests in flight does not exceed consensus_max_inflight_requests_per_peer.
+  void SendPipelinedRequests();
+
+  // Signals that a response to the pipelined request was received from the peer.
+  void ProcessPipelinedResponse(PipelinedRequest* pipelined_request);
+
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
   //
@@ -227,10 +253,21 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // single request outstanding at a time, and to wait for the outstanding requests at Close().
   AtomicTryMutex performing_mutex_;
 
+  // Requests sent while the regular request is in flight, protected by peer_lock_.
+  std::vector<std::unique_ptr<PipelinedRequest>> pipelined_requests_;
+  size_t num_pipelined_in_flight_ = 0;
+
+  // Whether SendPipelinedRequests() is already submitted to the thread pool.
+  std::atomic<bool> pipelined_send_scheduled_{false};
+
   // Heartbeater for remote peer implementations.  This will send status only requests to the remote
   // peers whenever we go more than 'FLAGS_raft_heartbeat_interval_ms' without sending actual data.
   std::shared_ptr<rpc::PeriodicTimer> heartbeater_;
 
+  // When the next heartbeat should be sent while the leader is quiescent. Accessed only from the
+  // heartbeater callback.
+  CoarseTimePoint next_quiescent_heartbeat_ = CoarseTimePoint::min();
+
   // Thread pool used to construct requests to this peer.
   ThreadPoolToken* raft_pool_token_;
 
@@ -262,6 +299,15 @@ class PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) = 0;
 
+  // Sends a request without ops, asynchronously, batching it with requests of other tablets to the
+  // same server. Callback receives status of the RPC.
+  // Returns false if the proxy does not batch requests, then UpdateAsync should be used instead.
+  virtual bool UpdateBatchedAsync(const ConsensusRequestPB* request,
+                                  ConsensusResponsePB* response,
+                                  StdStatusCallback callback) {
+    return false;
+  }
+
   // Sends a RequestConsensusVote to a remote peer.
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
@@ -312,7 +358,8 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -320,6 +367,10 @@ class RpcPeerProxy : public PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) override;
 
+  virtual bool UpdateBatchedAsync(const ConsensusRequestPB* request,
+                                  ConsensusResponsePB* response,
+                                  StdStatusCallback callback) override;
+
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
                                          rpc::RpcController* controller,
@@ -345,12 +396,14 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -362,6 +415,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
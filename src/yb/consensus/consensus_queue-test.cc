@@ -54,6 +54,8 @@
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_int32(consensus_max_batch_size_bytes);
+DECLARE_int32(consensus_max_inflight_requests_per_peer);
+DECLARE_int32(raft_quiescence_idle_ms);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -423,6 +425,141 @@ TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   ASSERT_EQ(queue_->TEST_GetLastAppliedOpId(), expected);
 }
 
+// Tests that pipelined requests continue after the last op sent to the peer, and that acks
+// received out of order don't move the peer watermark backward.
+TEST_F(ConsensusQueueTest, TestPipelinedRequests) {
+  google::FlagSaver saver;
+  FLAGS_consensus_max_inflight_requests_per_peer = 3;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId());
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 10);
+  WaitForLocalPeerToAckIndex(10);
+
+  // Nothing is pipelined until the peer accepts ops from the regular request.
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgsHolder pipelined_refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */,
+      PeerRequestKind::kPipelined));
+  ASSERT_EQ(0, pipelined_request.ops_size());
+
+  ReplicateMsgsHolder refs;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(10, request.ops_size());
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(10));
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  refs.Reset();
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 11, 10);
+  WaitForLocalPeerToAckIndex(20);
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(10, request.ops_size());
+  ASSERT_TRUE(request.has_leader_lease_duration_ms());
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 21, 10);
+  WaitForLocalPeerToAckIndex(30);
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */,
+      PeerRequestKind::kPipelined));
+  ASSERT_EQ(10, pipelined_request.ops_size());
+  ASSERT_EQ(20, pipelined_request.preceding_id().index());
+  ASSERT_EQ(21, pipelined_request.ops(0).id().index());
+  ASSERT_FALSE(pipelined_request.has_leader_lease_duration_ms());
+
+  // Response to the pipelined request arrives before the response to the regular one.
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(30));
+  queue_->ResponseFromPeer(response.responder_uuid(), response, PeerRequestKind::kPipelined);
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(20));
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+
+  auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(MakeOpIdForIndex(30), peer.last_received);
+  ASSERT_EQ(31, peer.next_index);
+
+  // Rejection of the older request arrives after the newer ops were acked, and is ignored as well.
+  RefuseWithLogPropertyMismatch(&response, MakeOpIdPbForIndex(20), MakeOpIdPbForIndex(20));
+  ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid(), response));
+  peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(MakeOpIdForIndex(30), peer.last_received);
+  ASSERT_EQ(31, peer.next_index);
+
+  // Once nothing is pipelined, rejection moves the peer watermark backward, e.g. after the peer
+  // lost ops that were not flushed to its log.
+  pipelined_refs.Reset();
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  RefuseWithLogPropertyMismatch(&response, MakeOpIdPbForIndex(15), MakeOpIdPbForIndex(15));
+  ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid(), response));
+  peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(MakeOpIdForIndex(15), peer.last_received);
+  ASSERT_EQ(16, peer.next_index);
+}
+
+TEST_F(ConsensusQueueTest, TestQuiescence) {
+  google::FlagSaver saver;
+  FLAGS_raft_quiescence_idle_ms = 100;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId());
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 10);
+  WaitForLocalPeerToAckIndex(10);
+
+  // The tablet is idle, but the peer does not have all operations yet.
+  SleepFor(MonoDelta::FromMilliseconds(200));
+  ASSERT_FALSE(queue_->IsQuiescent());
+
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(10));
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  queue_->raft_pool_observers_token_->Wait();
+  ASSERT_EQ(queue_->TEST_GetCommittedIndex(), MakeOpIdForIndex(10));
+  ASSERT_TRUE(queue_->IsQuiescent());
+
+  ReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(0, request.ops_size());
+  ASSERT_TRUE(request.has_quiescent_heartbeat_interval_ms());
+
+  ASSERT_TRUE(queue_->WakeUp());
+  ASSERT_FALSE(queue_->IsQuiescent());
+  ASSERT_FALSE(queue_->WakeUp());
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_FALSE(request.has_quiescent_heartbeat_interval_ms());
+
+  // Reads served by the leader keep the tablet awake, so it does not lose its lease.
+  for (int i = 0; i != 4; ++i) {
+    SleepFor(MonoDelta::FromMilliseconds(50));
+    queue_->NotifyActivity();
+    ASSERT_FALSE(queue_->IsQuiescent());
+  }
+  SleepFor(MonoDelta::FromMilliseconds(200));
+  ASSERT_TRUE(queue_->IsQuiescent());
+
+  // New operations keep the tablet awake.
+  SleepFor(MonoDelta::FromMilliseconds(200));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 11, 1);
+  WaitForLocalPeerToAckIndex(11);
+  ASSERT_FALSE(queue_->IsQuiescent());
+}
+
 TEST_F(ConsensusQueueTest, TestQueueAdvancesCommittedIndex) {
   queue_->Init(OpId::Min());
   queue_->SetLeaderMode(
@@ -509,6 +646,49 @@ TEST_F(ConsensusQueueTest, TestQueueAdvancesCommittedIndex) {
   ASSERT_EQ(queue_->TEST_GetLastAppliedOpId(), expected_op_id);
 }
 
+// StepDown picks the leadership transfer protege using GetUpToDatePeer and CanPeerBecomeLeader.
+// Witness does not have tablet data, so it should never be picked, even when it is more up to date
+// than the voters.
+TEST_F(ConsensusQueueTest, TestWitnessIsNotPickedAsProtege) {
+  auto config = BuildRaftConfigPBForTests(3);
+  config.mutable_peers(2)->set_member_type(RaftPeerPB::WITNESS);
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(OpId::Min(), OpId::Min().term, OpId::Min(), config);
+  queue_->TrackPeer("peer-1");
+  queue_->TrackPeer("peer-2");
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 10);
+  WaitForLocalPeerToAckIndex(10);
+
+  ConsensusResponsePB response;
+  response.set_responder_term(1);
+
+  // Witness acks all operations, so together with the local peer it forms a majority.
+  response.set_responder_uuid("peer-2");
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(10), OpId::Min().index);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+
+  // Voter lags behind the witness.
+  response.set_responder_uuid("peer-1");
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(5), OpId::Min().index);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+
+  queue_->raft_pool_observers_token_->Wait();
+  ASSERT_EQ(queue_->TEST_GetMajorityReplicatedOpId(), MakeOpIdForIndex(10));
+
+  ASSERT_EQ(queue_->GetUpToDatePeer(), "peer-1");
+  ASSERT_FALSE(queue_->CanPeerBecomeLeader("peer-2"));
+  ASSERT_FALSE(queue_->CanPeerBecomeLeader("peer-1"));
+
+  // Once the voter catches up, it could become leader, while witness still could not.
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(10), OpId::Min().index);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+
+  ASSERT_EQ(queue_->GetUpToDatePeer(), "peer-1");
+  ASSERT_TRUE(queue_->CanPeerBecomeLeader("peer-1"));
+  ASSERT_FALSE(queue_->CanPeerBecomeLeader("peer-2"));
+}
+
 // In this test we append a sequence of operations to a log
 // and then start tracking a peer whose first required operation
 // is before the first operation in the queue.
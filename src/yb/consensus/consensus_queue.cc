@@ -82,6 +82,12 @@ DEFINE_int32(consensus_max_batch_size_bytes, 4_MB,
 TAG_FLAG(consensus_max_batch_size_bytes, advanced);
 TAG_FLAG(consensus_max_batch_size_bytes, runtime);
 
+DEFINE_int32(consensus_max_inflight_requests_per_peer, 1,
+             "The maximum number of update requests that the leader could have in flight to a "
+             "single peer. Each request carries at most consensus_max_batch_size_bytes of ops, "
+             "so it also limits the amount of not yet acked data sent to the peer.");
+TAG_FLAG(consensus_max_inflight_requests_per_peer, advanced);
+
 DEFINE_int32(follower_unavailable_considered_failed_sec, 900,
              "Seconds that a leader is unable to successfully heartbeat to a "
              "follower after which the follower is considered to be failed and "
@@ -113,6 +119,20 @@ DEFINE_int32(consensus_lagging_follower_threshold, 10,
 TAG_FLAG(consensus_lagging_follower_threshold, advanced);
 TAG_FLAG(consensus_lagging_follower_threshold, runtime);
 
+DEFINE_int32(raft_quiescence_idle_ms, 0,
+             "Leader puts the tablet to the quiescent state, when there were no writes to it for "
+             "this amount of time and all peers have all operations. Quiescent leader sends "
+             "heartbeats only once per raft_quiescent_heartbeat_interval_ms and does not extend "
+             "its lease until the next read or write. 0 disables quiescence.");
+TAG_FLAG(raft_quiescence_idle_ms, advanced);
+TAG_FLAG(raft_quiescence_idle_ms, runtime);
+
+DEFINE_int32(raft_quiescent_heartbeat_interval_ms, 10000,
+             "Heartbeat interval of the quiescent leader. Followers of the quiescent tablet detect "
+             "leader failure after this interval times leader_failure_max_missed_heartbeat_periods.");
+TAG_FLAG(raft_quiescent_heartbeat_interval_ms, advanced);
+TAG_FLAG(raft_quiescent_heartbeat_interval_ms, runtime);
+
 DEFINE_test_flag(bool, disallow_lmp_failures, false,
                  "Whether we disallow PRECEDING_ENTRY_DIDNT_MATCH failures for non new peers.");
 
@@ -169,10 +189,10 @@ std::string PeerMessageQueue::TrackedPeer::ToString() const {
   return Format(
       "{ peer: $0 is_new: $1 last_received: $2 next_index: $3 last_known_committed_idx: $4 "
       "is_last_exchange_successful: $5 needs_remote_bootstrap: $6 member_type: $7 "
-      "num_sst_files: $8 last_applied: $9 }",
+      "num_sst_files: $8 last_applied: $9 last_sent_index: $10 }",
       uuid, is_new, last_received, next_index, last_known_committed_idx,
       is_last_exchange_successful, needs_remote_bootstrap, RaftPeerPB::MemberType_Name(member_type),
-      num_sst_files, last_applied);
+      num_sst_files, last_applied, last_sent_index);
 }
 
 void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
@@ -247,6 +267,7 @@ void PeerMessageQueue::SetLeaderMode(const OpId& committed_op_id,
       << queue_state_.active_config->ShortDebugString();
   queue_state_.majority_size_ = MajoritySize(CountVoters(*queue_state_.active_config));
   queue_state_.mode = Mode::LEADER;
+  NotifyActivity();
 
   LOG_WITH_PREFIX_UNLOCKED(INFO) << "Queue going to LEADER mode. State: "
       << queue_state_.ToString();
@@ -393,6 +414,7 @@ Status PeerMessageQueue::AppendOperations(const ReplicateMsgs& msgs,
     std::unique_lock<simple_spinlock> lock(queue_lock_);
 
     last_id = OpId::FromPB(msgs.back()->id());
+    NotifyActivity();
 
     if (last_id.term > queue_state_.current_term) {
       queue_state_.current_term = last_id.term;
@@ -430,7 +452,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         ReplicateMsgsHolder* msgs_holder,
                                         bool* needs_remote_bootstrap,
                                         RaftPeerPB::MemberType* member_type,
-                                        bool* last_exchange_successful) {
+                                        bool* last_exchange_successful,
+                                        PeerRequestKind kind) {
   static constexpr uint64_t kSendUnboundedLogOps = std::numeric_limits<uint64_t>::max();
   DCHECK(request->ops().empty()) << request->ShortDebugString();
 
@@ -440,6 +463,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   bool is_new;
   int64_t previously_sent_index;
   uint64_t num_log_ops_to_send;
+  bool continue_pipeline = false;
   HybridTime propagated_safe_time;
 
   // Should be before now_ht, i.e. not greater than propagated_hybrid_time.
@@ -459,8 +483,25 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
 
     HybridTime now_ht;
 
+    // Continue after the last sent op only while the peer accepts our ops, otherwise the regular
+    // request resends them starting from next_index.
+    continue_pipeline = kind != PeerRequestKind::kRegular && !peer->is_new &&
+                        peer->is_last_exchange_successful && !peer->needs_remote_bootstrap &&
+                        peer->last_sent_index >= peer->next_index - 1;
+    if (kind == PeerRequestKind::kPipelined && !continue_pipeline) {
+      *needs_remote_bootstrap = false;
+      return Status::OK();
+    }
+
     is_new = peer->is_new;
-    if (!is_new) {
+    if (kind == PeerRequestKind::kPipelined) {
+      // Lease sent to the follower is accounted only when the response to the request that carried
+      // it is received. So pipelined requests don't carry leases, otherwise response to an older
+      // request could extend the lease up to the value that the follower did not receive yet.
+      now_ht = clock_->Now();
+      request->clear_leader_lease_duration_ms();
+      request->clear_ht_lease_expiration();
+    } else if (!is_new) {
       now_ht = clock_->Now();
 
       auto ht_lease_expiration_micros = now_ht.GetPhysicalValueMicros() +
@@ -513,14 +554,24 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     queue_state_.committed_op_id.ToPB(request->mutable_committed_op_id());
 
     request->set_caller_term(queue_state_.current_term);
+    if (IsQuiescentUnlocked()) {
+      request->set_quiescent_heartbeat_interval_ms(
+          GetAtomicFlag(&FLAGS_raft_quiescent_heartbeat_interval_ms));
+    } else {
+      request->clear_quiescent_heartbeat_interval_ms();
+    }
     unreachable_time =
         MonoTime::Now().GetDeltaSince(peer->last_successful_communication_time);
     if (member_type) *member_type = peer->member_type;
     if (last_exchange_successful) *last_exchange_successful = peer->is_last_exchange_successful;
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
-    previously_sent_index = peer->next_index - 1;
-    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
+    previously_sent_index = continue_pipeline ? peer->last_sent_index : peer->next_index - 1;
+    peer->last_sent_index = previously_sent_index;
+    if (continue_pipeline) {
+      // Ops up to next_index were not rejected by the peer yet, so there is nothing to back off.
+      num_log_ops_to_send = kSendUnboundedLogOps;
+    } else if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
       num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
@@ -530,9 +581,11 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       num_log_ops_to_send = kSendUnboundedLogOps;
     }
 
-    peer->current_retransmissions++;
+    if (kind != PeerRequestKind::kPipelined) {
+      peer->current_retransmissions++;
+    }
 
-    if (peer->member_type == RaftPeerPB::VOTER) {
+    if (IsVoterMemberType(peer->member_type)) {
       is_voter = true;
     }
   }
@@ -596,7 +649,12 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         return STATUS(NotFound, "Peer not tracked.");
       }
 
-      peer->last_num_messages_sent = result->messages.size();
+      if (kind != PeerRequestKind::kPipelined) {
+        peer->last_num_messages_sent = result->messages.size();
+      }
+      peer->last_sent_index = previously_sent_index + result->messages.size();
+      // Regular request is sent only when no pipelined requests are in flight.
+      peer->has_pipelined_requests = kind != PeerRequestKind::kRegular;
     }
 
     ScopedTrackedConsumption consumption;
@@ -745,7 +803,8 @@ Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
     return STATUS(IllegalState, "Peer does not need to remotely bootstrap", uuid);
   }
 
-  if (peer->member_type == RaftPeerPB::VOTER || peer->member_type == RaftPeerPB::OBSERVER) {
+  if (peer->member_type == RaftPeerPB::VOTER || peer->member_type == RaftPeerPB::OBSERVER ||
+      peer->member_type == RaftPeerPB::WITNESS) {
     LOG(INFO) << "Remote bootstrapping peer " << uuid << " with type "
               << RaftPeerPB::MemberType_Name(peer->member_type);
   }
@@ -758,6 +817,7 @@ Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
   *req->mutable_source_broadcast_addr() = local_peer_pb_.last_known_broadcast_addr();
   *req->mutable_source_cloud_info() = local_peer_pb_.cloud_info();
   req->set_caller_term(queue_state_.current_term);
+  req->set_witness(peer->member_type == RaftPeerPB::WITNESS);
   peer->needs_remote_bootstrap = false; // Now reset the flag.
   return Status::OK();
 }
@@ -1050,6 +1110,35 @@ void PeerMessageQueue::NotifyPeerIsResponsiveDespiteError(const std::string& pee
   peer->last_successful_communication_time = MonoTime::Now();
 }
 
+bool PeerMessageQueue::IsQuiescent() const {
+  LockGuard lock(queue_lock_);
+  return IsQuiescentUnlocked();
+}
+
+bool PeerMessageQueue::IsQuiescentUnlocked() const {
+  auto idle_ms = GetAtomicFlag(&FLAGS_raft_quiescence_idle_ms);
+  if (idle_ms <= 0 || queue_state_.mode != Mode::LEADER) {
+    return false;
+  }
+  if (CoarseMonoClock::now() <
+          last_activity_time_.load(std::memory_order_acquire) + idle_ms * 1ms) {
+    return false;
+  }
+  // Followers that miss some operations need regular requests to catch up.
+  return queue_state_.all_replicated_op_id == queue_state_.last_appended &&
+         queue_state_.committed_op_id == queue_state_.last_appended;
+}
+
+bool PeerMessageQueue::WakeUp() {
+  LockGuard lock(queue_lock_);
+  if (!IsQuiescentUnlocked()) {
+    return false;
+  }
+  LOG_WITH_PREFIX_UNLOCKED(INFO) << "Waking up quiescent tablet";
+  NotifyActivity();
+  return true;
+}
+
 void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
   LockGuard scoped_lock(queue_lock_);
   DCHECK_NE(State::kQueueConstructed, queue_state_.state);
@@ -1063,9 +1152,19 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
   peer->ResetLastRequest();
 }
 
+void PeerMessageQueue::RequestFailed(const std::string& peer_uuid) {
+  LockGuard scoped_lock(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
+  if (PREDICT_FALSE(queue_state_.state != State::kQueueOpen || peer == nullptr)) {
+    return;
+  }
+
+  peer->last_sent_index = kInvalidOpIdIndex;
+}
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
-                                        const ConsensusResponsePB& response) {
+                                        const ConsensusResponsePB& response,
+                                        PeerRequestKind kind) {
   DCHECK(response.IsInitialized()) << "Error: Uninitialized: "
       << response.InitializationErrorString() << ". Response: " << response.ShortDebugString();
 
@@ -1120,7 +1219,9 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     peer->is_new = false;
     peer->last_successful_communication_time = MonoTime::Now();
 
-    peer->ResetLastRequest();
+    if (kind != PeerRequestKind::kPipelined) {
+      peer->ResetLastRequest();
+    }
 
     if (response.has_status()) {
       const auto& status = response.status();
@@ -1133,6 +1234,20 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       DCHECK(status.has_last_received_current_leader());
       DCHECK(status.has_last_committed_idx());
 
+      // Response to the older request could arrive after the response to the newer one, that
+      // already acked more ops. The follower does not lose ops acked in the current term, so such
+      // response does not tell anything new about the follower log.
+      const bool stale_response = peer->has_pipelined_requests &&
+                                  status.last_received().index() < peer->last_received.index;
+      if (stale_response && status.has_error() &&
+          status.error().code() == ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH) {
+        // Rejection of the older request should not rewind next_index below the acked ops.
+        VLOG_WITH_PREFIX_UNLOCKED(2) << "Ignoring stale error response "
+                                     << status.ShortDebugString() << " from peer: "
+                                     << peer->ToString();
+        return true;
+      }
+
       peer->last_known_committed_idx = status.last_committed_idx();
       peer->last_applied = OpId::FromPB(status.last_applied());
 
@@ -1144,7 +1259,13 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       bool peer_has_prefix_of_log = IsOpInLog(yb::OpId::FromPB(status.last_received()));
       if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
-        peer->last_received = OpId::FromPB(status.last_received());
+        auto last_received = OpId::FromPB(status.last_received());
+        if (stale_response) {
+          VLOG_WITH_PREFIX_UNLOCKED(2) << "Ignoring stale ack " << last_received << " from peer: "
+                                       << peer->ToString();
+          last_received = peer->last_received;
+        }
+        peer->last_received = last_received;
         peer->next_index = peer->last_received.index + 1;
 
       } else if (!OpIdEquals(status.last_received_current_leader(), MinimumOpId())) {
@@ -1165,6 +1286,8 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
       if (PREDICT_FALSE(status.has_error())) {
         peer->is_last_exchange_successful = false;
+        // Ops that are in flight will be rejected as well, so resend them from next_index.
+        peer->last_sent_index = kInvalidOpIdIndex;
         switch (status.error().code()) {
           case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
             DCHECK(status.has_last_received());
@@ -1214,7 +1337,11 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     // If our log has the next request for the peer or if the peer's committed index is lower than
     // our own, set 'more_pending' to true.
-    result = log_cache_.HasOpBeenWritten(peer->next_index) ||
+    auto next_index_to_send = peer->next_index;
+    if (FLAGS_consensus_max_inflight_requests_per_peer > 1) {
+      next_index_to_send = std::max(next_index_to_send, peer->last_sent_index + 1);
+    }
+    result = log_cache_.HasOpBeenWritten(next_index_to_send) ||
         (peer->last_known_committed_idx < queue_state_.committed_op_id.index);
 
     mode_copy = queue_state_.mode;
@@ -1222,14 +1349,17 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       auto new_majority_replicated_opid = OpIdWatermark();
       if (new_majority_replicated_opid != OpId::Min()) {
         if (new_majority_replicated_opid.index == MaximumOpId().index()) {
-          queue_state_.majority_replicated_op_id = local_peer_->last_received;
-        } else {
-          queue_state_.majority_replicated_op_id = new_majority_replicated_opid;
+          new_majority_replicated_opid = local_peer_->last_received;
         }
+        // Stale acks could not move the watermark back.
+        queue_state_.majority_replicated_op_id = std::max(
+            queue_state_.majority_replicated_op_id, new_majority_replicated_opid);
       }
 
-      peer->leader_lease_expiration.OnReplyFromFollower();
-      peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      if (kind != PeerRequestKind::kPipelined) {
+        peer->leader_lease_expiration.OnReplyFromFollower();
+        peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      }
 
       majority_replicated.op_id = queue_state_.majority_replicated_op_id;
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
@@ -1505,6 +1635,10 @@ bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
     LOG(ERROR) << "Invalid peer UUID: " << peer_uuid;
     return false;
   }
+  if (IsWitnessUnlocked(peer_uuid)) {
+    LOG(INFO) << "Peer " << peer_uuid << " cannot become Leader as it is a witness";
+    return false;
+  }
   const bool peer_can_be_leader = peer->last_received >= queue_state_.majority_replicated_op_id;
   if (!peer_can_be_leader) {
     LOG(INFO) << Format(
@@ -1514,6 +1648,11 @@ bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
   return peer_can_be_leader;
 }
 
+bool PeerMessageQueue::IsWitnessUnlocked(const std::string& peer_uuid) const {
+  return queue_state_.active_config &&
+         IsRaftConfigWitness(peer_uuid, *queue_state_.active_config);
+}
+
 OpId PeerMessageQueue::PeerLastReceivedOpId(const TabletServerId& uuid) const {
   std::lock_guard<simple_spinlock> lock(queue_lock_);
   TrackedPeer* peer = FindPtrOrNull(peers_map_, uuid);
@@ -1531,7 +1670,8 @@ string PeerMessageQueue::GetUpToDatePeer() const {
   {
     std::lock_guard<simple_spinlock> lock(queue_lock_);
     for (const PeersMap::value_type& entry : peers_map_) {
-      if (local_peer_uuid_ == entry.first) {
+      // Witness does not have tablet data, so it could not become a leader.
+      if (local_peer_uuid_ == entry.first || IsWitnessUnlocked(entry.first)) {
         continue;
       }
       if (highest_op_id > entry.second->last_received) {
@@ -33,6 +33,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_QUEUE_H_
 #define YB_CONSENSUS_CONSENSUS_QUEUE_H_
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -137,6 +138,14 @@ class PeerMessageQueue {
     // Next index to send to the peer.  This corresponds to "nextIndex" as specified in Raft.
     int64_t next_index = kInvalidOpIdIndex;
 
+    // Index of the last op sent to the peer by requests that are still in flight. Pipelined
+    // requests continue after it, instead of next_index.
+    int64_t last_sent_index = kInvalidOpIdIndex;
+
+    // Whether pipelined requests could be in flight to the peer, so responses to them and to the
+    // regular request could arrive out of order.
+    bool has_pipelined_requests = false;
+
     // Number of ops starting from next_index_ to retransmit.
     int64_t last_num_messages_sent = -1;
 
@@ -271,7 +280,8 @@ class PeerMessageQueue {
       ReplicateMsgsHolder* msgs_holder,
       bool* needs_remote_bootstrap,
       RaftPeerPB::MemberType* member_type = nullptr,
-      bool* last_exchange_successful = nullptr);
+      bool* last_exchange_successful = nullptr,
+      PeerRequestKind kind = PeerRequestKind::kRegular);
 
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
@@ -287,11 +297,33 @@ class PeerMessageQueue {
 
   // Updates the request queue with the latest response of a peer, returns whether this peer has
   // more requests pending.
+  // Responses to requests of different kinds could arrive out of order, so acks for ops that are
+  // older than already acked ones are ignored when pipelining is enabled.
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
-                                const ConsensusResponsePB& response);
+                                const ConsensusResponsePB& response,
+                                PeerRequestKind kind = PeerRequestKind::kRegular);
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
+  // Returns true if this is the leader of a tablet that did not have writes for
+  // raft_quiescence_idle_ms, and all peers have all operations. Quiescent leader heartbeats rarely
+  // and does not keep its lease.
+  bool IsQuiescent() const;
+
+  // Brings quiescent leader back to the regular mode, until the tablet is idle again.
+  // Returns true if the leader was quiescent.
+  bool WakeUp();
+
+  // Notifies the queue that the leader served a request, so the tablet is not idle and should keep
+  // its lease.
+  void NotifyActivity() {
+    last_activity_time_.store(CoarseMonoClock::now(), std::memory_order_release);
+  }
+
+  // Notifies the queue that a request to the peer failed, so the following requests should be
+  // sent starting from the last op acked by the peer, instead of continuing the pipeline.
+  void RequestFailed(const std::string& peer_uuid);
+
   // Closes the queue, peers are still allowed to call UntrackPeer() and ResponseFromPeer() but no
   // additional peers can be tracked or messages queued.
   virtual void Close();
@@ -500,6 +532,11 @@ class PeerMessageQueue {
   // Updates op id replicated on each node.
   void UpdateAllReplicatedOpId(OpId* result) REQUIRES(queue_lock_);
 
+  bool IsQuiescentUnlocked() const REQUIRES(queue_lock_);
+
+  // Returns true if the specified peer is a witness in the active config.
+  bool IsWitnessUnlocked(const std::string& peer_uuid) const REQUIRES(queue_lock_);
+
   // Updates op ID applied on each node.
   void UpdateAllAppliedOpId(OpId* result) REQUIRES(queue_lock_);
 
@@ -544,6 +581,10 @@ class PeerMessageQueue {
   PeersMap peers_map_;
   TrackedPeer* local_peer_ = nullptr;
 
+  // Time of the last append, leader read or wake up, used to detect that the tablet is idle.
+  // Updated without queue_lock_ on reads.
+  std::atomic<CoarseTimePoint> last_activity_time_{CoarseTimePoint()};
+
   using LockType = simple_spinlock;
   using LockGuard = std::lock_guard<LockType>;
   mutable LockType queue_lock_; // TODO: rename
@@ -53,6 +53,7 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_bool(log_reader_mmap_closed_segments);
 
 namespace yb {
 namespace log {
@@ -1179,6 +1180,38 @@ TEST_F(LogTest, TestReadReplicatesHighIndex) {
   ASSERT_EQ(kSequenceLength, repls.size());
 }
 
+// Ops read from closed segments through their memory mapping should be the same as ones read
+// using regular file reads.
+TEST_F(LogTest, TestReadReplicatesFromMappedSegments) {
+  const int kNumEntriesPerBatch = 10;
+
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+
+  OpIdPB op_id = MakeOpId(1, 1);
+  int num_entries = 0;
+  while (log_->num_segments() < 4) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+  }
+
+  auto* reader = log_->GetLogReader();
+  ReplicateMsgs mapped_repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(1, num_entries, LogReader::kNoSizeLimit,
+                                          &mapped_repls));
+  ASSERT_EQ(num_entries, mapped_repls.size());
+
+  FLAGS_log_reader_mmap_closed_segments = false;
+  ReplicateMsgs repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(1, num_entries, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(num_entries, repls.size());
+
+  for (int i = 0; i != num_entries; ++i) {
+    ASSERT_EQ(i + 1, mapped_repls[i]->id().index());
+    ASSERT_EQ(repls[i]->SerializeAsString(), mapped_repls[i]->SerializeAsString());
+  }
+}
+
 TEST_F(LogTest, AllocateSegmentAndRollOver) {
   constexpr auto kNumIters = 10;
 
@@ -192,6 +192,9 @@ using strings::Substitute;
 
 namespace {
 
+// Append buffer that grew larger than this, because of a huge batch, is released after the write.
+constexpr size_t kMaxRetainedAppendBufferSize = 4_MB;
+
 bool IsMarkerType(LogEntryTypePB type) {
   return type == LogEntryTypePB::ROLLOVER_MARKER ||
          type == LogEntryTypePB::FLUSH_MARKER;
@@ -218,8 +221,8 @@ class LogEntryBatch {
   friend class Log;
   friend class MultiThreadedLogTest;
 
-  // Serializes contents of the entry to an internal buffer.
-  CHECKED_STATUS Serialize();
+  // Serializes contents of the entry to the provided buffer, that should outlive data() usage.
+  CHECKED_STATUS Serialize(faststring* buffer);
 
   // Sets the callback that will be invoked after the entry is
   // appended and synced to disk
@@ -250,7 +253,7 @@ class LogEntryBatch {
   // Returns a Slice representing the serialized contents of the entry.
   Slice data() const {
     DCHECK_EQ(state_, kEntrySerialized);
-    return Slice(buffer_);
+    return data_;
   }
 
   bool IsMarker() const;
@@ -298,8 +301,8 @@ class LogEntryBatch {
   // Callback to be invoked upon the entries being written and synced to disk.
   StatusCallback callback_;
 
-  // Buffer to which 'phys_entries_' are serialized by call to 'Serialize()'
-  faststring buffer_;
+  // Serialized contents of 'entry_batch_pb_', points to the buffer passed to 'Serialize()'.
+  Slice data_;
 
   // Offset into the log file for this entry batch.
   int64_t offset_;
@@ -761,7 +764,12 @@ Status Log::DoAppend(LogEntryBatch* entry_batch,
                      bool caller_owns_operation,
                      bool skip_wal_write) {
   if (!skip_wal_write) {
-    RETURN_NOT_OK(entry_batch->Serialize());
+    RETURN_NOT_OK(entry_batch->Serialize(&append_buffer_));
+    auto se = ScopeExit([this] {
+      if (append_buffer_.capacity() > kMaxRetainedAppendBufferSize) {
+        delete[] append_buffer_.release();
+      }
+    });
     Slice entry_batch_data = entry_batch->data();
     LOG_IF(DFATAL, entry_batch_data.size() <= 0 && !entry_batch->IsMarker())
         << "Cannot call DoAppend() with no data";
@@ -1586,9 +1594,10 @@ bool LogEntryBatch::IsSingleEntryOfType(LogEntryTypePB type) const {
   return count() == 1 && entry_batch_pb_.entry(0).type() == type;
 }
 
-Status LogEntryBatch::Serialize() {
+Status LogEntryBatch::Serialize(faststring* buffer) {
   DCHECK_EQ(state_, kEntryReady);
-  buffer_.clear();
+  buffer->clear();
+  data_ = Slice();
   // *_MARKER LogEntries are markers and are not serialized.
   if (PREDICT_FALSE(IsMarker())) {
     total_size_bytes_ = 0;
@@ -1596,10 +1605,19 @@ Status LogEntryBatch::Serialize() {
     return Status::OK();
   }
   DCHECK_NE(entry_batch_pb_.mono_time(), 0);
+  DCHECK(entry_batch_pb_.IsInitialized());
+  // Sizes are computed only once here, since for large batches walking all replicate messages is
+  // comparable with the serialization itself.
   total_size_bytes_ = entry_batch_pb_.ByteSize();
-  buffer_.reserve(total_size_bytes_);
+  buffer->resize(total_size_bytes_);
 
-  pb_util::AppendToString(entry_batch_pb_, &buffer_);
+  auto* end = entry_batch_pb_.SerializeWithCachedSizesToArray(buffer->data());
+  if (PREDICT_FALSE(static_cast<size_t>(end - buffer->data()) != total_size_bytes_)) {
+    return STATUS_FORMAT(
+        Corruption, "Serialized log entry batch size mismatch: $0 vs $1",
+        end - buffer->data(), total_size_bytes_);
+  }
+  data_ = Slice(buffer->data(), total_size_bytes_);
 
   state_ = kEntrySerialized;
   return Status::OK();
@@ -51,6 +51,7 @@
 #include "yb/gutil/spinlock.h"
 #include "yb/util/async_util.h"
 #include "yb/util/blocking_queue.h"
+#include "yb/util/faststring.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
@@ -428,6 +429,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // The currently active segment being written.
   std::unique_ptr<WritableLogSegment> active_segment_;
 
+  // Buffer that entry batches are serialized to before write to the active segment. Reused across
+  // batches to avoid allocation per append, accessed only by the thread performing DoAppend.
+  faststring append_buffer_;
+
   // The current (active) segment sequence number. Initialized in the Log constructor based on
   // LogOptions.
   std::atomic<uint64_t> active_segment_sequence_number_;
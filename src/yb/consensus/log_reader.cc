@@ -407,7 +407,16 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
   CHECK_GT(index_entry.offset_in_segment, 0);
   int64_t offset = index_entry.offset_in_segment;
   ScopedLatencyMetric scoped(read_batch_latency_.get());
-  RETURN_NOT_OK_PREPEND(segment->ReadEntryHeaderAndBatch(&offset, tmp_buf, batch),
+  // Closed segments are read through their memory mapping, so a follower that is caught up from
+  // disk does not issue a pair of preads and copy every batch into the temporary buffer.
+  auto read_result = segment->ReadMappedEntryHeaderAndBatch(&offset, batch);
+  Status s;
+  if (!read_result.ok()) {
+    s = read_result.status();
+  } else if (!*read_result) {
+    s = segment->ReadEntryHeaderAndBatch(&offset, tmp_buf, batch);
+  }
+  RETURN_NOT_OK_PREPEND(s,
                         Substitute("Failed to read LogEntry for index $0 from log segment "
                                    "$1 offset $2",
                                    index,
@@ -415,7 +424,7 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
                                    index_entry.offset_in_segment));
 
   if (bytes_read_) {
-    bytes_read_->IncrementBy(kEntryHeaderSize + tmp_buf->length());
+    bytes_read_->IncrementBy(offset - index_entry.offset_in_segment);
     entries_read_->IncrementBy(batch->entry_size());
   }
 
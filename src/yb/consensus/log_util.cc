@@ -92,6 +92,14 @@ TAG_FLAG(log_async_preallocate_segments, advanced);
 
 DECLARE_string(fs_data_dirs);
 
+DEFINE_bool(log_reader_mmap_closed_segments, true,
+            "Memory map closed WAL segments to read entries from them by log index, e.g. when "
+            "lagging followers are caught up from disk. Encrypted segments are never mapped. "
+            "I/O error while reading a mapped segment crashes the process with SIGBUS, instead "
+            "of failing the read.");
+TAG_FLAG(log_reader_mmap_closed_segments, advanced);
+TAG_FLAG(log_reader_mmap_closed_segments, runtime);
+
 DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is required."
     "In case you cannot write using O_DIRECT in WAL and data directories and this flag is set true"
     "the system will deliberately crash with the appropriate error. If this flag is set false, "
@@ -772,29 +780,90 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   if (!s.ok()) return STATUS(IOError, Substitute("Could not read entry. Cause: $0",
                                                  s.ToString()));
 
+  RETURN_NOT_OK(ParseEntryBatch(*offset, header, entry_batch_slice, entry_batch));
+  *offset += entry_batch_slice.size();
+  return Status::OK();
+}
+
+Status ReadableLogSegment::ParseEntryBatch(int64_t offset,
+                                           const EntryHeader& header,
+                                           const Slice& data,
+                                           LogEntryBatchPB* entry_batch) {
   // Verify the CRC.
-  uint32_t read_crc = crc::Crc32c(entry_batch_slice.data(), entry_batch_slice.size());
+  uint32_t read_crc = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(read_crc != header.msg_crc)) {
     return STATUS(Corruption, Substitute("Entry CRC mismatch in byte range $0-$1: "
                                          "expected CRC=$2, computed=$3",
-                                         *offset, *offset + header.msg_length,
+                                         offset, offset + header.msg_length,
                                          header.msg_crc, read_crc));
   }
 
-
   LogEntryBatchPB read_entry_batch;
-  s = pb_util::ParseFromArray(&read_entry_batch,
-                              entry_batch_slice.data(),
-                              header.msg_length);
+  Status s = pb_util::ParseFromArray(&read_entry_batch, data.data(), header.msg_length);
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
 
-  *offset += entry_batch_slice.size();
   entry_batch->Swap(&read_entry_batch);
   return Status::OK();
 }
 
+Slice ReadableLogSegment::MappedData() {
+  std::call_once(mapped_data_once_, [this] {
+    // The segment that is being written to does not have footer.
+    if (!HasFooter()) {
+      return;
+    }
+    // Files that could not be mapped, e.g. encrypted ones or files of test environments, are read
+    // as usual.
+    auto result = readable_file_->MapForRead();
+    if (result.ok()) {
+      mapped_data_ = *result;
+    } else if (!result.status().IsNotSupported()) {
+      LOG(WARNING) << "Failed to map " << path_ << ": " << result.status();
+    }
+  });
+  return mapped_data_;
+}
+
+Result<bool> ReadableLogSegment::ReadMappedEntryHeaderAndBatch(
+    int64_t* offset, LogEntryBatchPB* batch) {
+  if (!GetAtomicFlag(&FLAGS_log_reader_mmap_closed_segments)) {
+    return false;
+  }
+  auto data = MappedData();
+  if (data.empty()) {
+    return false;
+  }
+
+  const int64_t limit = std::min<int64_t>(readable_up_to(), data.size());
+  if (PREDICT_FALSE(*offset + kEntryHeaderSize > limit)) {
+    return STATUS_FORMAT(Corruption,
+                         "Could not read log entry header from offset $0 in $1: "
+                         "log only readable up to offset $2",
+                         *offset, path_, limit);
+  }
+
+  EntryHeader header;
+  RETURN_NOT_OK(DecodeEntryHeader(Slice(data.data() + *offset, kEntryHeaderSize), &header));
+  const int64_t batch_offset = *offset + kEntryHeaderSize;
+
+  if (header.msg_length == 0) {
+    return STATUS(Corruption, "Invalid 0 entry length");
+  }
+  if (PREDICT_FALSE(header.msg_length + batch_offset > limit)) {
+    return STATUS_FORMAT(Corruption,
+                         "Could not read $0-byte log entry from offset $1 in $2: "
+                         "log only readable up to offset $3",
+                         header.msg_length, batch_offset, path_, limit);
+  }
+
+  RETURN_NOT_OK(ParseEntryBatch(
+      batch_offset, header, Slice(data.data() + batch_offset, header.msg_length), batch));
+  *offset = batch_offset + header.msg_length;
+  return true;
+}
+
 const LogSegmentHeaderPB& ReadableLogSegment::header() const {
   DCHECK(header_.IsInitialized());
   return header_;
@@ -874,12 +943,10 @@ Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
   uint32_t header_crc = crc::Crc32c(&header_buf, 8);
   InlineEncodeFixed32(&header_buf[8], header_crc);
 
-  // Write the header to the file, followed by the batch data itself.
-  RETURN_NOT_OK(writable_file_->Append(Slice(header_buf, sizeof(header_buf))));
-  written_offset_ += sizeof(header_buf);
-
-  RETURN_NOT_OK(writable_file_->Append(data));
-  written_offset_ += data.size();
+  // Write the header to the file, followed by the batch data itself, with a single gathered write.
+  const Slice slices[] = { Slice(header_buf, sizeof(header_buf)), data };
+  RETURN_NOT_OK(writable_file_->AppendSlices(slices, arraysize(slices)));
+  written_offset_ += sizeof(header_buf) + data.size();
 
   return Status::OK();
 }
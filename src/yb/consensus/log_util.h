@@ -36,6 +36,7 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -317,6 +318,18 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                                          faststring* tmp_buf,
                                          LogEntryBatchPB* batch);
 
+  // Same as ReadEntryHeaderAndBatch, but decodes the entry directly from the memory mapped segment
+  // file, avoiding read syscalls and the copy to a temporary buffer.
+  // Returns false if the segment could not be mapped, so the caller should use regular reads.
+  // Only closed segments are mapped, because they are never modified. The file is mapped through
+  // RandomAccessFile::MapForRead, so encrypted segments are not mapped.
+  // An I/O error while reading the mapping is delivered as SIGBUS and is fatal.
+  Result<bool> ReadMappedEntryHeaderAndBatch(int64_t* offset, LogEntryBatchPB* batch);
+
+  // Returns memory mapped content of the segment file, mapping it on the first call.
+  // Returns empty slice if segment cannot be mapped.
+  Slice MappedData();
+
   // Reads a log entry header from the segment.
   // Also increments the passed offset* by the length of the entry.
   CHECKED_STATUS ReadEntryHeader(int64_t *offset, EntryHeader* header);
@@ -335,6 +348,12 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                                 faststring* tmp_buf,
                                 LogEntryBatchPB* entry_batch);
 
+  // Verifies the CRC of the entry batch located at 'offset' and decodes it into 'entry_batch'.
+  CHECKED_STATUS ParseEntryBatch(int64_t offset,
+                                 const EntryHeader& header,
+                                 const Slice& data,
+                                 LogEntryBatchPB* entry_batch);
+
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
   const std::string path_;
@@ -370,6 +389,11 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   // the offset of the first entry in the log.
   int64_t first_entry_offset_;
 
+  // Read only mapping of the closed segment file, used by LogReader for random access reads.
+  // Created lazily by MappedData(), owned by readable_file_.
+  std::once_flag mapped_data_once_;
+  Slice mapped_data_;
+
   DISALLOW_COPY_AND_ASSIGN(ReadableLogSegment);
 };
 
@@ -0,0 +1,184 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+using namespace std::placeholders;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Send heartbeats of tablet leaders hosted on this server to the same tablet server in "
+            "a single MultiRaftUpdateConsensus RPC. Should be enabled only when all tablet servers "
+            "of the cluster support this RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_batch_window_ms, 5,
+             "Max time heartbeat waits in a batch for heartbeats of other tablets, before the batch "
+             "is sent.");
+TAG_FLAG(multi_raft_batch_window_ms, advanced);
+TAG_FLAG(multi_raft_batch_window_ms, runtime);
+
+DEFINE_int32(multi_raft_batch_size, 256,
+             "Max number of heartbeats in a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+TAG_FLAG(multi_raft_batch_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(const HostPort& hostport,
+                                                     rpc::ProxyCache* proxy_cache,
+                                                     rpc::Messenger* messenger)
+    : hostport_(hostport),
+      messenger_(messenger),
+      consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Scheduled flush and RPC in flight retain the batcher, so there is no pending batch here.
+  DCHECK(!current_batch_);
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB* request,
+                                                  ConsensusResponsePB* response,
+                                                  StdStatusCallback callback) {
+  MultiRaftBatchPtr batch_to_send;
+  MultiRaftBatchPtr batch_to_schedule;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<MultiRaftBatch>();
+      batch_to_schedule = current_batch_;
+    }
+    current_batch_->request.add_consensus_request()->CopyFrom(*request);
+    current_batch_->response_callback_data.push_back({response, std::move(callback)});
+    if (current_batch_->request.consensus_request_size() >= FLAGS_multi_raft_batch_size) {
+      batch_to_send = std::move(current_batch_);
+      batch_to_schedule = nullptr;
+    }
+  }
+
+  if (batch_to_send) {
+    SendBatch(batch_to_send);
+    return;
+  }
+
+  if (!batch_to_schedule) {
+    return;
+  }
+
+  auto task_id = messenger_->ScheduleOnReactor(
+      std::bind(&MultiRaftHeartbeatBatcher::FlushBatch, shared_from_this(), batch_to_schedule, _1),
+      MonoDelta::FromMilliseconds(FLAGS_multi_raft_batch_window_ms), SOURCE_LOCATION(),
+      messenger_);
+  if (task_id == rpc::kInvalidTaskId) {
+    FlushBatch(batch_to_schedule, STATUS(Aborted, "Messenger closing"));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushBatch(const MultiRaftBatchPtr& batch, const Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Batch could be already sent because it reached the size limit.
+    if (current_batch_ != batch) {
+      return;
+    }
+    current_batch_ = nullptr;
+  }
+
+  if (!status.ok()) {
+    FailBatch(batch, status);
+    return;
+  }
+
+  SendBatch(batch);
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const MultiRaftBatchPtr& batch) {
+  VLOG(4) << "Sending " << batch->request.consensus_request_size() << " heartbeats to "
+          << hostport_;
+  batch->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  // Peers process responses with IO and locking, so they should not run on the reactor thread.
+  batch->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  consensus_proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::ProcessBatchResponse, shared_from_this(), batch));
+}
+
+void MultiRaftHeartbeatBatcher::ProcessBatchResponse(const MultiRaftBatchPtr& batch) {
+  auto status = batch->controller.status();
+  if (status.ok()) {
+    status = batch->controller.thread_pool_failure();
+  }
+  auto& callbacks = batch->response_callback_data;
+  if (status.ok() &&
+      batch->response.consensus_response_size() != static_cast<int>(callbacks.size())) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses in MultiRaftUpdateConsensus: $0, expected: $1",
+        batch->response.consensus_response_size(), callbacks.size());
+    LOG(DFATAL) << status;
+  }
+  if (!status.ok()) {
+    FailBatch(batch, status);
+    return;
+  }
+
+  for (size_t i = 0; i != callbacks.size(); ++i) {
+    callbacks[i].response->Swap(batch->response.mutable_consensus_response(i));
+    callbacks[i].callback(Status::OK());
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FailBatch(const MultiRaftBatchPtr& batch, const Status& status) {
+  for (const auto& data : batch->response_callback_data) {
+    data.callback(status);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftManager::~MultiRaftManager() {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[hostport];
+  auto result = weak_batcher.lock();
+  if (!result) {
+    result = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+    weak_batcher = result;
+    // Batchers of tablet servers that are not peers anymore expire, so drop them while we are here.
+    for (auto it = batchers_.begin(); it != batchers_.end();) {
+      if (it->second.expired()) {
+        it = batchers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace consensus
+}  // namespace yb
@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus_fwd.h"
+
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+namespace consensus {
+
+// Batches heartbeats, i.e. update requests without ops, that leaders of different tablets send to
+// the same tablet server, into a single MultiRaftUpdateConsensus RPC.
+//
+// A node hosting thousands of tablet leaders would otherwise send thousands of tiny RPCs per
+// heartbeat interval to each of its peers. The batch is sent when multi_raft_batch_size requests
+// were collected, or multi_raft_batch_window_ms after the first request was added to it.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(const HostPort& hostport,
+                            rpc::ProxyCache* proxy_cache,
+                            rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds request to the current batch. Request is copied, so the caller could reuse it right after
+  // this call. Response should stay alive until callback is invoked. Callback receives status of
+  // the RPC that carried the request, response is filled only when this status is OK.
+  void AddRequestToBatch(const ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         StdStatusCallback callback);
+
+ private:
+  struct ResponseCallbackData {
+    ConsensusResponsePB* response;
+    StdStatusCallback callback;
+  };
+
+  struct MultiRaftBatch {
+    MultiRaftConsensusRequestPB request;
+    MultiRaftConsensusResponsePB response;
+    rpc::RpcController controller;
+    std::vector<ResponseCallbackData> response_callback_data;
+  };
+
+  typedef std::shared_ptr<MultiRaftBatch> MultiRaftBatchPtr;
+
+  // Invoked by the reactor when batch window expires.
+  void FlushBatch(const MultiRaftBatchPtr& batch, const Status& status);
+
+  void SendBatch(const MultiRaftBatchPtr& batch);
+
+  void ProcessBatchResponse(const MultiRaftBatchPtr& batch);
+
+  // Invokes all callbacks of the batch with the specified status.
+  static void FailBatch(const MultiRaftBatchPtr& batch, const Status& status);
+
+  const HostPort hostport_;
+  rpc::Messenger* const messenger_;
+  ConsensusServiceProxyPtr consensus_proxy_;
+
+  std::mutex mutex_;
+  MultiRaftBatchPtr current_batch_;
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Keeps one heartbeat batcher per remote tablet server, so leaders of all tablets hosted on this
+// node share it.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  ~MultiRaftManager();
+
+  // Returns batcher for requests to the specified tablet server, creating it if necessary.
+  // Batcher is alive while at least one peer proxy refers it.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+}  // namespace consensus
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -81,5 +81,38 @@ TEST(QuorumUtilTest, TestMemberExtraction) {
   ASSERT_EQ("B", peer_pb.permanent_uuid());
 }
 
+TEST(QuorumUtilTest, TestWitness) {
+  RaftConfigPB config;
+  SetPeerInfo("A", RaftPeerPB::VOTER, config.add_peers());
+  SetPeerInfo("B", RaftPeerPB::VOTER, config.add_peers());
+  SetPeerInfo("C", RaftPeerPB::WITNESS, config.add_peers());
+  SetPeerInfo("D", RaftPeerPB::PRE_VOTER, config.add_peers());
+
+  // Witness votes and counts towards majority.
+  ASSERT_EQ(3, CountVoters(config));
+  ASSERT_EQ(2, MajoritySize(CountVoters(config)));
+  ASSERT_TRUE(IsRaftConfigVoter("C", config));
+  ASSERT_TRUE(IsRaftConfigWitness("C", config));
+  ASSERT_FALSE(IsRaftConfigWitness("A", config));
+  ASSERT_FALSE(IsRaftConfigVoter("D", config));
+
+  ConsensusStatePB cstate;
+  cstate.set_current_term(1);
+  *cstate.mutable_config() = config;
+  cstate.mutable_config()->set_opid_index(1);
+  for (auto& peer : *cstate.mutable_config()->mutable_peers()) {
+    auto* addr = peer.add_last_known_private_addr();
+    addr->set_host(peer.permanent_uuid());
+    addr->set_port(9100);
+  }
+  ASSERT_EQ(RaftPeerPB::FOLLOWER, GetConsensusRole("C", cstate));
+
+  // Witness could not be a leader.
+  cstate.set_leader_uuid("C");
+  ASSERT_NOK(VerifyConsensusState(cstate, COMMITTED_QUORUM));
+  cstate.set_leader_uuid("A");
+  ASSERT_OK(VerifyConsensusState(cstate, COMMITTED_QUORUM));
+}
+
 } // namespace consensus
 } // namespace yb
@@ -56,10 +56,23 @@ bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config) {
   return false;
 }
 
+bool IsVoterMemberType(RaftPeerPB::MemberType member_type) {
+  return member_type == RaftPeerPB::VOTER || member_type == RaftPeerPB::WITNESS;
+}
+
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config) {
   for (const RaftPeerPB& peer : config.peers()) {
     if (peer.permanent_uuid() == uuid) {
-      return peer.member_type() == RaftPeerPB::VOTER;
+      return IsVoterMemberType(peer.member_type());
+    }
+  }
+  return false;
+}
+
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config) {
+  for (const RaftPeerPB& peer : config.peers()) {
+    if (peer.permanent_uuid() == uuid) {
+      return peer.member_type() == RaftPeerPB::WITNESS;
     }
   }
   return false;
@@ -147,7 +160,7 @@ bool RemoveFromRaftConfig(RaftConfigPB* config, const ChangeConfigRequestPB& req
 }
 
 int CountVoters(const RaftConfigPB& config) {
-  return CountMemberType(config, RaftPeerPB::VOTER);
+  return CountMemberType(config, RaftPeerPB::VOTER) + CountMemberType(config, RaftPeerPB::WITNESS);
 }
 
 int CountVotersInTransition(const RaftConfigPB& config) {
@@ -197,7 +210,9 @@ RaftPeerPB::Role GetConsensusRole(const std::string& permanent_uuid,
   for (const RaftPeerPB& peer : cstate.config().peers()) {
     if (peer.permanent_uuid() == permanent_uuid) {
       switch (peer.member_type()) {
+        // WITNESS never becomes a leader, but otherwise participates in consensus as a follower.
         case RaftPeerPB::VOTER:
+        case RaftPeerPB::WITNESS:
           return RaftPeerPB::FOLLOWER;
 
         // PRE_VOTER, PRE_OBSERVER peers are considered LEARNERs.
@@ -278,7 +293,7 @@ Status VerifyConsensusState(const ConsensusStatePB& cstate, RaftConfigState type
   RETURN_NOT_OK(VerifyRaftConfig(cstate.config(), type));
 
   if (cstate.has_leader_uuid() && !cstate.leader_uuid().empty()) {
-    if (!IsRaftConfigVoter(cstate.leader_uuid(), cstate.config())) {
+    if (GetConsensusMemberType(cstate.leader_uuid(), cstate) != RaftPeerPB::VOTER) {
       return STATUS(IllegalState,
           Substitute("Leader with UUID $0 is not a VOTER in the config! Consensus state: $1",
                      cstate.leader_uuid(), cstate.ShortDebugString()));
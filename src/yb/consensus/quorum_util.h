@@ -52,7 +52,11 @@ enum RaftConfigState {
 };
 
 bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config);
+
+// Voters are VOTER and WITNESS peers, i.e. peers that vote in elections and count towards majority.
+bool IsVoterMemberType(RaftPeerPB::MemberType member_type);
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config);
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config);
 
 // Get the specified member of the config.
 // Returns Status::NotFound if a member with the specified uuid could not be
@@ -88,7 +92,7 @@ int CountMemberType(const RaftConfigPB& config,
                     const RaftPeerPB::MemberType member_type,
                     const std::string& ignore_uuid = "");
 
-// Counts the number of voters in the configuration.
+// Counts the number of voters, including witnesses, in the configuration.
 int CountVoters(const RaftConfigPB& config);
 
 // Counts the number of servers that are in transition (being bootstrapped) to become voters.
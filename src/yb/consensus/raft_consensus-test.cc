@@ -104,14 +104,16 @@ class MockQueue : public PeerMessageQueue {
                                             RestartSafeCoarseTimePoint time));
   MOCK_METHOD1(TrackPeer, void(const string&));
   MOCK_METHOD1(UntrackPeer, void(const string&));
-  MOCK_METHOD6(RequestForPeer, Status(const std::string& uuid,
+  MOCK_METHOD7(RequestForPeer, Status(const std::string& uuid,
                                       ConsensusRequestPB* request,
                                       ReplicateMsgsHolder* msgs_holder,
                                       bool* needs_remote_bootstrap,
                                       RaftPeerPB::MemberType* member_type,
-                                      bool* last_exchange_successful));
-  MOCK_METHOD2(ResponseFromPeer, bool(const std::string& peer_uuid,
-                                      const ConsensusResponsePB& response));
+                                      bool* last_exchange_successful,
+                                      PeerRequestKind kind));
+  MOCK_METHOD3(ResponseFromPeer, bool(const std::string& peer_uuid,
+                                      const ConsensusResponsePB& response,
+                                      PeerRequestKind kind));
   MOCK_METHOD0(Close, void());
 };
 
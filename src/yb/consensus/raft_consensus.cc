@@ -319,9 +319,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests) {
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-      messenger, proxy_cache, local_peer_pb.cloud_info());
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -582,6 +583,12 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
           "Not starting $0: Node is currently a non-participant in the raft config: $1",
           election_name, state_->GetActiveConfigUnlocked());
     }
+    if (IsRaftConfigWitness(state_->GetPeerUuid(), state_->GetActiveConfigUnlocked())) {
+      // Witness does not have tablet data, so it should never become a leader.
+      VLOG_WITH_PREFIX(1) << "Not starting " << election_name << " -- witness";
+      SnoozeFailureDetector(DO_NOT_LOG);
+      return Status::OK();
+    }
 
     // Default is to start the election now. But if we are starting a pending election, see if
     // there is an op id pending upon indeed and if it has been committed to the log. The op id
@@ -1926,8 +1933,13 @@ Result<RaftConsensus::UpdateReplicaResult> RaftConsensus::UpdateReplica(
 
   // Snooze the failure detector as soon as we decide to accept the message.
   // We are guaranteed to be acting as a FOLLOWER at this point by the above
-  // sanity check.
-  SnoozeFailureDetector(DO_NOT_LOG);
+  // sanity check. Quiescent leader heartbeats rarely, so wait for it correspondingly longer.
+  SnoozeFailureDetector(
+      DO_NOT_LOG,
+      request->has_quiescent_heartbeat_interval_ms()
+          ? MonoDelta::FromMilliseconds(FLAGS_leader_failure_max_missed_heartbeat_periods *
+                                        request->quiescent_heartbeat_interval_ms())
+          : MonoDelta());
 
   auto now = MonoTime::Now();
 
@@ -2472,11 +2484,14 @@ Status RaftConsensus::ChangeConfig(const ChangeConfigRequestPB& req,
                         Substitute("Server must have member_type specified. Request: $0",
                                    req.ShortDebugString()));
         }
+        // Witness does not need data to be bootstrapped before it could vote, so it is added
+        // directly.
         if (server.member_type() != RaftPeerPB::PRE_VOTER &&
-            server.member_type() != RaftPeerPB::PRE_OBSERVER) {
+            server.member_type() != RaftPeerPB::PRE_OBSERVER &&
+            server.member_type() != RaftPeerPB::WITNESS) {
           return STATUS(InvalidArgument,
-              Substitute("Server with UUID $0 must be of member_type PRE_VOTER or PRE_OBSERVER. "
-                         "member_type received: $1", server_uuid,
+              Substitute("Server with UUID $0 must be of member_type PRE_VOTER, PRE_OBSERVER or "
+                         "WITNESS. member_type received: $1", server_uuid,
                          RaftPeerPB::MemberType_Name(server.member_type())));
         }
         if (server.last_known_private_addr().empty()) {
@@ -2865,7 +2880,20 @@ RaftPeerPB::Role RaftConsensus::role() const {
 }
 
 LeaderState RaftConsensus::GetLeaderState(bool allow_stale) const {
-  return state_->GetLeaderState(allow_stale);
+  auto result = state_->GetLeaderState(allow_stale);
+  // Quiescent leader heartbeats rarely and so does not keep its lease. Lease checks of reads and
+  // writes count as activity, so the tablet that is only read from does not become quiescent.
+  // The first request after the idle period wakes the tablet up and renews the lease, it is
+  // retried by the client meanwhile.
+  if (result.status == LeaderStatus::LEADER_AND_READY) {
+    if (!allow_stale) {
+      queue_->NotifyActivity();
+    }
+  } else if (result.status == LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE &&
+             queue_->WakeUp()) {
+    peer_manager_->SignalRequest(RequestTriggerMode::kAlwaysSend);
+  }
+  return result;
 }
 
 std::string RaftConsensus::LogPrefix() {
@@ -118,7 +118,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   // Creates RaftConsensus.
   RaftConsensus(
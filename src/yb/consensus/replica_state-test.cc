@@ -31,6 +31,7 @@
 //
 #include "yb/consensus/replica_state.h"
 
+#include <set>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -41,6 +42,8 @@
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int32(max_follower_apply_batch_size);
+
 namespace yb {
 namespace consensus {
 
@@ -49,11 +52,43 @@ using std::vector;
 // TODO: Share a test harness with ConsensusMetadataTest?
 const char* kTabletId = "TestTablet";
 
+class NoOpRoundCallback : public ConsensusRoundCallback {
+ public:
+  void AddedToLeader(const OpId& op_id, const OpId& committed_op_id) override {}
+
+  void ReplicationFinished(
+      const Status& status, int64_t leader_term, OpIds* applied_op_ids) override {}
+};
+
+// Remembers indexes of operations passed to ApplyWritesInBatch.
+class BatchRecordingOperationFactory : public MockOperationFactory {
+ public:
+  int64_t ApplyWritesInBatch(const ConsensusRounds& rounds) override {
+    std::vector<int64_t> indexes;
+    int64_t written_index = 0;
+    bool stopped = false;
+    for (const auto& round : rounds) {
+      const auto index = round->id().index;
+      indexes.push_back(index);
+      stopped = stopped || non_batchable_indexes.count(index);
+      if (!stopped) {
+        written_index = index;
+      }
+    }
+    batches.push_back(std::move(indexes));
+    return written_index;
+  }
+
+  std::vector<std::vector<int64_t>> batches;
+  // Writing of the batch stops at these operations, like at transactional writes in tablet.
+  std::set<int64_t> non_batchable_indexes;
+};
+
 class RaftConsensusStateTest : public YBTest {
  public:
   RaftConsensusStateTest()
     : fs_manager_(env_.get(), GetTestPath("fs_root"), "tserver_test"),
-      operation_factory_(new MockOperationFactory()) {
+      operation_factory_(new BatchRecordingOperationFactory()) {
   }
 
   void SetUp() override {
@@ -82,9 +117,22 @@ class RaftConsensusStateTest : public YBTest {
   }
 
  protected:
+  Status AddPendingOperation(int64_t index, OperationType op_type) {
+    auto replicate = std::make_shared<ReplicateMsg>();
+    replicate->set_op_type(op_type);
+    replicate->mutable_id()->set_term(kMinimumTerm + 1);
+    replicate->mutable_id()->set_index(index);
+    if (op_type == WRITE_OP) {
+      replicate->mutable_write_request()->set_tablet_id(kTabletId);
+    }
+    auto round = make_scoped_refptr<ConsensusRound>(nullptr /* consensus */, replicate);
+    round->SetCallback(std::make_unique<NoOpRoundCallback>());
+    return state_->AddPendingOperation(round, OperationMode::kFollower);
+  }
+
   FsManager fs_manager_;
   RaftConfigPB config_;
-  std::unique_ptr<MockOperationFactory> operation_factory_;
+  std::unique_ptr<BatchRecordingOperationFactory> operation_factory_;
   std::unique_ptr<ReplicaState> state_;
 };
 
@@ -129,5 +177,61 @@ TEST_F(RaftConsensusStateTest, TestPersistentWrites) {
   ASSERT_EQ(2, state_->GetCommittedConfigUnlocked().opid_index());
 }
 
+// Test that follower passes consecutive committed writes to ApplyWritesInBatch, splitting them
+// at non-write operations, at the batch size limit and at the committed op id.
+TEST_F(RaftConsensusStateTest, FollowerApplyBatchBoundaries) {
+  FLAGS_max_follower_apply_batch_size = 3;
+
+  ReplicaState::UniqueLock lock;
+  ASSERT_OK(state_->LockForUpdate(&lock));
+
+  // Operations 1-5 and 7-10 are writes, operation 6 is a no-op.
+  for (int64_t index = 1; index <= 10; ++index) {
+    ASSERT_OK(AddPendingOperation(index, index == 6 ? NO_OP : WRITE_OP));
+  }
+
+  ASSERT_TRUE(ASSERT_RESULT(state_->AdvanceCommittedOpIdUnlocked(
+      OpId(kMinimumTerm + 1, 8), CouldStop::kFalse)));
+  std::vector<std::vector<int64_t>> expected_batches = {{1, 2, 3}, {4, 5}, {7, 8}};
+  ASSERT_EQ(expected_batches, operation_factory_->batches);
+  ASSERT_EQ(8, state_->GetCommittedOpIdUnlocked().index);
+
+  // Single committed write is applied as usual.
+  ASSERT_TRUE(ASSERT_RESULT(state_->AdvanceCommittedOpIdUnlocked(
+      OpId(kMinimumTerm + 1, 9), CouldStop::kFalse)));
+  ASSERT_EQ(expected_batches, operation_factory_->batches);
+
+  // Batching is disabled by setting the limit below 2.
+  FLAGS_max_follower_apply_batch_size = 1;
+  ASSERT_OK(AddPendingOperation(11, WRITE_OP));
+  ASSERT_TRUE(ASSERT_RESULT(state_->AdvanceCommittedOpIdUnlocked(
+      OpId(kMinimumTerm + 1, 11), CouldStop::kFalse)));
+  ASSERT_EQ(expected_batches, operation_factory_->batches);
+  ASSERT_EQ(11, state_->GetCommittedOpIdUnlocked().index);
+}
+
+// Test that when the batch is written only partially, the next batch starts right after the last
+// written operation.
+TEST_F(RaftConsensusStateTest, FollowerApplyBatchAfterNonBatchableWrite) {
+  FLAGS_max_follower_apply_batch_size = 3;
+  operation_factory_->non_batchable_indexes = {1, 5};
+
+  ReplicaState::UniqueLock lock;
+  ASSERT_OK(state_->LockForUpdate(&lock));
+
+  for (int64_t index = 1; index <= 8; ++index) {
+    ASSERT_OK(AddPendingOperation(index, WRITE_OP));
+  }
+
+  ASSERT_TRUE(ASSERT_RESULT(state_->AdvanceCommittedOpIdUnlocked(
+      OpId(kMinimumTerm + 1, 8), CouldStop::kFalse)));
+  // Batches starting with non batchable operations write nothing, so the next batch starts right
+  // after such operation instead of after the whole window.
+  std::vector<std::vector<int64_t>> expected_batches = {
+      {1, 2, 3}, {2, 3, 4}, {5, 6, 7}, {6, 7, 8}};
+  ASSERT_EQ(expected_batches, operation_factory_->batches);
+  ASSERT_EQ(8, state_->GetCommittedOpIdUnlocked().index);
+}
+
 }  // namespace consensus
 }  // namespace yb
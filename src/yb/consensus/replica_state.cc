@@ -62,6 +62,12 @@ DEFINE_int32(inject_delay_commit_pre_voter_to_voter_secs, 0,
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, unsafe);
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, hidden);
 
+DEFINE_int32(max_follower_apply_batch_size, 64,
+             "Maximum number of consecutive committed write operations whose data a follower "
+             "writes to RocksDB in a single batch. Values less than 2 disable batching.");
+TAG_FLAG(max_follower_apply_batch_size, advanced);
+TAG_FLAG(max_follower_apply_batch_size, runtime);
+
 namespace yb {
 namespace consensus {
 
@@ -831,6 +837,8 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     max_allowed_op_id.index = std::numeric_limits<int64_t>::max();
   }
   auto leader_term = GetLeaderStateUnlocked().term;
+  const bool is_follower = GetActiveRoleUnlocked() != RaftPeerPB::LEADER;
+  int64_t batch_applied_index = 0;
 
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
@@ -860,6 +868,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
             << prev_id << " of " << committed_op_id;
         break;
       }
+      if (is_follower && current_id.index > batch_applied_index) {
+        batch_applied_index = ApplyWritesInBatchUnlocked(committed_op_id);
+      }
     } else if (current_id.index > max_allowed_op_id.index ||
                current_id.term > max_allowed_op_id.term) {
       max_allowed_op_id = safe_op_id_waiter_->WaitForSafeOpIdToApply(current_id);
@@ -905,6 +916,28 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   return status;
 }
 
+int64_t ReplicaState::ApplyWritesInBatchUnlocked(const yb::OpId& committed_op_id) {
+  const size_t max_batch_size = std::max(
+      GetAtomicFlag(&FLAGS_max_follower_apply_batch_size), 0);
+  ConsensusRounds rounds;
+  for (const auto& round : pending_operations_) {
+    if (rounds.size() >= max_batch_size ||
+        round->id().index > committed_op_id.index ||
+        round->replicate_msg()->op_type() != OperationType::WRITE_OP) {
+      break;
+    }
+    rounds.push_back(round);
+  }
+  if (rounds.empty()) {
+    return 0;
+  }
+  // Single operation is applied as usual.
+  const int64_t written_index = rounds.size() > 1 ? context_->ApplyWritesInBatch(rounds) : 0;
+  // Context could stop at the operation that could not be written in batch, e.g. transactional
+  // one. Such operation is applied as usual, and the next batch starts after it.
+  return std::max(written_index, rounds.front()->id().index);
+}
+
 void ReplicaState::ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round) {
   DCHECK(round->replicate_msg()->change_config_record().has_old_config());
   DCHECK(round->replicate_msg()->change_config_record().has_new_config());
@@ -439,6 +439,12 @@ class ReplicaState {
 
   void SetLastCommittedIndexUnlocked(const yb::OpId& committed_op_id);
 
+  // Passes consecutive write operations from the head of pending operations, up to and including
+  // committed_op_id, to ConsensusContext::ApplyWritesInBatch.
+  // Returns index of the last operation written by the batch, or of the first passed operation if
+  // none of them was written. So the next batch starts right after the returned index.
+  int64_t ApplyWritesInBatchUnlocked(const yb::OpId& committed_op_id);
+
   // Applies committed config change.
   void ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round);
 
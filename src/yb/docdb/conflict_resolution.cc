@@ -25,9 +25,12 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/lock_batch.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
@@ -35,6 +38,18 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DEFINE_bool(enable_wait_queues, false,
+            "Whether transaction that conflicts with running transactions should wait for them "
+            "to finish, instead of aborting them or failing by priority.");
+TAG_FLAG(enable_wait_queues, advanced);
+TAG_FLAG(enable_wait_queues, runtime);
+
+DEFINE_int32(max_wait_for_conflicting_transactions_ms, 1000,
+             "Max time transaction waits for conflicting transactions to finish, before falling "
+             "back to priority based conflict resolution.");
+TAG_FLAG(max_wait_for_conflicting_transactions_ms, advanced);
+TAG_FLAG(max_wait_for_conflicting_transactions_ms, runtime);
+
 namespace yb {
 namespace docdb {
 
@@ -92,6 +107,12 @@ class ConflictResolverContext {
 
   virtual bool IgnoreConflictsWith(const TransactionId& other) = 0;
 
+  // Invoked before conflicts are read again, after waiting for conflicting transactions.
+  virtual void ConflictsReset() = 0;
+
+  // Whether we could wait for conflicting transactions to finish.
+  virtual bool CanWait() const = 0;
+
   virtual TransactionId transaction_id() const = 0;
 
   virtual std::string ToString() const = 0;
@@ -109,10 +130,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
                    TransactionStatusManager* status_manager,
                    PartialRangeKeyIntents partial_range_key_intents,
                    std::unique_ptr<ConflictResolverContext> context,
+                   LockBatch* lock_batch,
+                   CoarseTimePoint deadline,
                    ResolutionCallback callback)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
         partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
-        callback_(std::move(callback)) {}
+        lock_batch_(lock_batch), deadline_(deadline), callback_(std::move(callback)) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
@@ -295,12 +318,82 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
+    if (VERIFY_RESULT(WaitForRemainingTransactions())) {
+      return false;
+    }
+
     RETURN_NOT_OK(context_->CheckPriority(this, RemainingTransactions()));
 
     AbortTransactions();
     return false;
   }
 
+  // Returns true if resolution will be continued when any of remaining transactions finishes.
+  // Waits are rejected on deadlock within this tablet and after max wait time, so resolution falls
+  // back to aborting conflicting transactions by priority.
+  //
+  // Locks are released for the time of the wait. Otherwise a blocker that writes the same keys
+  // again would wait for these locks, and this wait is not visible in the wait-for graph.
+  Result<bool> WaitForRemainingTransactions() {
+    if (!context_->CanWait()) {
+      return false;
+    }
+    auto now = CoarseMonoClock::now();
+    if (wait_deadline_ == CoarseTimePoint()) {
+      wait_deadline_ = now + 1ms * FLAGS_max_wait_for_conflicting_transactions_ms;
+    }
+    if (now >= wait_deadline_) {
+      return false;
+    }
+    std::vector<TransactionId> blockers;
+    blockers.reserve(remaining_transactions_);
+    for (const auto& transaction : RemainingTransactions()) {
+      blockers.push_back(transaction.id);
+    }
+    TRACE("Waiting for $0 transactions", blockers.size());
+    // Locks are released before the wait is registered, because the wait could finish right away.
+    if (lock_batch_) {
+      lock_batch_->Unlock();
+    }
+    auto self = shared_from_this();
+    if (status_manager().WaitForTransactions(
+            context_->transaction_id(), blockers, wait_deadline_, [self](const Status& status) {
+          self->WaitDone(status);
+        })) {
+      return true;
+    }
+    if (lock_batch_) {
+      RETURN_NOT_OK(lock_batch_->Relock(deadline_));
+    }
+    return false;
+  }
+
+  void WaitDone(const Status& status) {
+    VLOG_WITH_PREFIX(4) << "Wait done: " << status;
+    // After timeout resolution is continued, and falls back to aborting by priority.
+    if (!status.ok() && !status.IsTimedOut()) {
+      InvokeCallback(status);
+      return;
+    }
+    if (!lock_batch_) {
+      DoResolveConflicts();
+      return;
+    }
+    auto lock_status = lock_batch_->Relock(deadline_);
+    if (!lock_status.ok()) {
+      InvokeCallback(lock_status);
+      return;
+    }
+    // Conflicting intents could be written while locks were released, so conflicts are read again.
+    TRACE("Locks obtained after wait");
+    conflicts_.clear();
+    transactions_.clear();
+    remaining_transactions_ = 0;
+    intent_iter_.Reset();
+    context_->ConflictsReset();
+    Resolve();
+  }
+
   // Returns true when there are no conflicts left.
   Result<bool> CheckLocalCommits() {
     return DoCleanup([this](auto* transaction) -> Result<bool> {
@@ -468,6 +561,10 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   RequestScope request_scope_;
   PartialRangeKeyIntents partial_range_key_intents_;
   std::unique_ptr<ConflictResolverContext> context_;
+  // Locks of the operation, released while waiting for conflicting transactions. Could be null.
+  LockBatch* lock_batch_;
+  // Deadline for obtaining locks again after the wait.
+  CoarseTimePoint deadline_;
   ResolutionCallback callback_;
 
   BoundedRocksDbIterator intent_iter_;
@@ -480,6 +577,9 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   size_t remaining_transactions_;
 
   std::atomic<int> pending_requests_{0};
+
+  // Time until we could wait for conflicting transactions, unset before the first wait.
+  CoarseTimePoint wait_deadline_;
 };
 
 struct IntentData {
@@ -672,6 +772,10 @@ class ConflictResolverContextBase : public ConflictResolverContext {
     return conflicts_metric_;
   }
 
+  void ConflictsReset() override {
+    fetched_metadata_for_transactions_ = false;
+  }
+
  protected:
   CHECKED_STATUS CheckPriorityInternal(
       ConflictResolver* resolver,
@@ -851,6 +955,10 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     return other == *transaction_id_;
   }
 
+  bool CanWait() const override {
+    return GetAtomicFlag(&FLAGS_enable_wait_queues);
+  }
+
   TransactionId transaction_id() const override {
     return *transaction_id_;
   }
@@ -932,6 +1040,11 @@ class OperationConflictResolverContext : public ConflictResolverContextBase {
     return false;
   }
 
+  // Single shard operations are not expected to wait, they abort conflicting transactions.
+  bool CanWait() const override {
+    return false;
+  }
+
   TransactionId transaction_id() const override {
     return TransactionId::Nil();
   }
@@ -960,13 +1073,16 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 LockBatch* lock_batch,
+                                 CoarseTimePoint deadline,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   TRACE("ResolveTransactionConflicts");
   auto context = std::make_unique<TransactionConflictResolverContext>(
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context), lock_batch, deadline,
+      std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
@@ -982,8 +1098,10 @@ void ResolveOperationConflicts(const DocOperations& doc_ops,
   TRACE("ResolveOperationConflicts");
   auto context = std::make_unique<OperationConflictResolverContext>(&doc_ops, resolution_ht,
                                                                     conflicts_metric);
+  // Single shard operations do not wait for conflicting transactions, so locks are not released.
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context),
+      nullptr /* lock_batch */, CoarseTimePoint() /* deadline */, std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
@@ -50,6 +50,8 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// lock_batch - locks of write_batch keys. They are released while waiting for conflicting
+//              transactions, and obtained again until deadline before conflicts are read again.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
                                  HybridTime resolution_ht,
@@ -58,6 +60,8 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 LockBatch* lock_batch,
+                                 CoarseTimePoint deadline,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
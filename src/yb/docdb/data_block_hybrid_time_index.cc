@@ -0,0 +1,129 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/data_block_hybrid_time_index.h"
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/util/coding.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Block properties format: kFormatVersion byte, varint min hybrid time, varint difference between
+// max and min hybrid times.
+constexpr uint8_t kFormatVersion = 1;
+
+class DocHybridTimeDataBlockPropertiesCollector : public rocksdb::DataBlockPropertiesCollector {
+ public:
+  void AddKey(const Slice& key) override {
+    if (!valid_) {
+      return;
+    }
+    Slice user_key = rocksdb::ExtractUserKey(key);
+    if (user_key.starts_with(ValueTypeAsChar::kTransactionApplyState)) {
+      valid_ = false;
+      return;
+    }
+    auto doc_ht = DocHybridTime::DecodeFromEnd(&user_key);
+    if (!doc_ht.ok()) {
+      valid_ = false;
+      return;
+    }
+    const auto ht = doc_ht->hybrid_time();
+    if (!min_.is_valid() || ht < min_) {
+      min_ = ht;
+    }
+    if (!max_.is_valid() || ht > max_) {
+      max_ = ht;
+    }
+  }
+
+  void FinishBlock(std::string* dest) override {
+    if (valid_ && min_.is_valid()) {
+      dest->push_back(static_cast<char>(kFormatVersion));
+      rocksdb::PutVarint64(dest, min_.ToUint64());
+      rocksdb::PutVarint64(dest, max_.ToUint64() - min_.ToUint64());
+    }
+    valid_ = true;
+    min_ = HybridTime::kInvalid;
+    max_ = HybridTime::kInvalid;
+  }
+
+ private:
+  bool valid_ = true;
+  HybridTime min_;
+  HybridTime max_;
+};
+
+class DocHybridTimeDataBlockPropertiesCollectorFactory
+    : public rocksdb::DataBlockPropertiesCollectorFactory {
+ public:
+  std::unique_ptr<rocksdb::DataBlockPropertiesCollector> CreateCollector() const override {
+    return std::make_unique<DocHybridTimeDataBlockPropertiesCollector>();
+  }
+};
+
+class DocHybridTimeDataBlockFilter : public rocksdb::DataBlockFilter {
+ public:
+  explicit DocHybridTimeDataBlockFilter(HybridTime max_hybrid_time)
+      : max_hybrid_time_(max_hybrid_time) {}
+
+  bool Filter(const Slice& block_properties) const override {
+    auto range = DecodeDataBlockHybridTimeRange(block_properties);
+    // Properties of unknown format could not be used to skip the block.
+    return !range.ok() || range->min <= max_hybrid_time_;
+  }
+
+ private:
+  const HybridTime max_hybrid_time_;
+};
+
+} // namespace
+
+std::shared_ptr<rocksdb::DataBlockPropertiesCollectorFactory>
+    DocHybridTimeDataBlockPropertiesCollectorFactory() {
+  static std::shared_ptr<rocksdb::DataBlockPropertiesCollectorFactory> instance =
+      std::make_shared<docdb::DocHybridTimeDataBlockPropertiesCollectorFactory>();
+  return instance;
+}
+
+Result<DataBlockHybridTimeRange> DecodeDataBlockHybridTimeRange(const Slice& block_properties) {
+  Slice input = block_properties;
+  if (input.empty() || input[0] != kFormatVersion) {
+    return STATUS_FORMAT(
+        NotSupported, "Unknown data block properties format: $0",
+        block_properties.ToDebugHexString());
+  }
+  input.remove_prefix(1);
+  uint64_t min = 0;
+  uint64_t delta = 0;
+  if (!rocksdb::GetVarint64(&input, &min) || !rocksdb::GetVarint64(&input, &delta)) {
+    return STATUS_FORMAT(
+        Corruption, "Bad data block hybrid time range: $0", block_properties.ToDebugHexString());
+  }
+  return DataBlockHybridTimeRange{HybridTime(min), HybridTime(min + delta)};
+}
+
+std::shared_ptr<rocksdb::DataBlockFilter> CreateDocHybridTimeDataBlockFilter(
+    HybridTime max_hybrid_time) {
+  return std::make_shared<DocHybridTimeDataBlockFilter>(max_hybrid_time);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,53 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DATA_BLOCK_HYBRID_TIME_INDEX_H_
+#define YB_DOCDB_DATA_BLOCK_HYBRID_TIME_INDEX_H_
+
+#include <memory>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/rocksdb/options.h"
+#include "yb/rocksdb/table.h"
+
+#include "yb/util/result.h"
+
+namespace yb {
+namespace docdb {
+
+// Range of hybrid times of the records stored in a data block.
+struct DataBlockHybridTimeRange {
+  HybridTime min;
+  HybridTime max;
+};
+
+// Returns factory of collectors that store min and max hybrid time of the regular DB records in
+// the data index entry of each data block. Properties are not stored for blocks containing keys
+// without hybrid time, e.g. transaction apply state records.
+std::shared_ptr<rocksdb::DataBlockPropertiesCollectorFactory>
+    DocHybridTimeDataBlockPropertiesCollectorFactory();
+
+// Decodes hybrid time range stored by the collector above.
+Result<DataBlockHybridTimeRange> DecodeDataBlockHybridTimeRange(const Slice& block_properties);
+
+// Returns filter that skips data blocks with all records written after max_hybrid_time.
+// Such blocks are not visible to the reads with global limit less than or equal to
+// max_hybrid_time, so they don't even have to be read from disk.
+std::shared_ptr<rocksdb::DataBlockFilter> CreateDocHybridTimeDataBlockFilter(
+    HybridTime max_hybrid_time);
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_DATA_BLOCK_HYBRID_TIME_INDEX_H_
@@ -402,8 +402,7 @@ std::string EncodeSimpleSubDocKeyWithDifferentNonHashPart(const std::string& has
   return EncodeSubDocKey(hash_key, "another_range_key", "another_sub_key", 55555L);
 }
 
-TEST_F(DocKeyTest, TestKeyMatching) {
-  DocDbAwareV2FilterPolicy policy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+void TestKeyMatching(const DocDbAwareFilterPolicyBase& policy) {
   std::string keys[] = { "foo", "bar", "test" };
   std::string absent_key = "fake";
 
@@ -430,6 +429,16 @@ TEST_F(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocKeyTest, TestKeyMatching) {
+  TestKeyMatching(
+      DocDbAwareV2FilterPolicy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr));
+}
+
+TEST_F(DocKeyTest, TestKeyMatchingRibbon) {
+  TestKeyMatching(DocDbAwareV3RibbonFilterPolicy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr));
+}
+
 TEST_F(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
@@ -1158,6 +1158,11 @@ DocDbAwareV3FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
 }
 
+const rocksdb::FilterPolicy::KeyTransformer*
+DocDbAwareV3RibbonFilterPolicy::GetKeyTransformer() const {
+  return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
+}
+
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
     std::string bytes;
@@ -834,10 +834,10 @@ std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
 class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  explicit DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareFilterPolicyBase(rocksdb::NewFixedSizeFilterPolicy(
+            filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+            logger)) {}
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -849,6 +849,11 @@ class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
 
   FilterType GetFilterType() const override;
 
+ protected:
+  // Takes ownership of builtin_policy.
+  explicit DocDbAwareFilterPolicyBase(const rocksdb::FilterPolicy* builtin_policy)
+      : builtin_policy_(builtin_policy) {}
+
  private:
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
 };
@@ -893,6 +898,21 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// Uses the same key transformation as DocDbAwareV3FilterPolicy, but builds fixed-size Ribbon
+// filter blocks instead of Bloom filter blocks. The name differs, so SST files know which of the
+// two policies should be used to read their filter blocks.
+class DocDbAwareV3RibbonFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  DocDbAwareV3RibbonFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareFilterPolicyBase(rocksdb::NewFixedSizeRibbonFilterPolicy(
+            filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+            logger)) {}
+
+  const char* Name() const override { return "DocKeyV3RibbonFilter"; }
+
+  const KeyTransformer* GetKeyTransformer() const override;
+};
+
 // Optional inclusive lower bound and exclusive upper bound for keys served by DocDB.
 // Could be used to split tablet without doing actual splitting of RocksDB files.
 // DocDBCompactionFilter also respects these bounds, so it will filter out non-relevant keys
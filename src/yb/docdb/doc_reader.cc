@@ -25,6 +25,7 @@
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/subdoc_reader.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -128,6 +129,45 @@ CHECKED_STATUS DocDBTableReader::InitForKey(const Slice& sub_doc_key) {
   return Status::OK();
 }
 
+template <class Consumer>
+Result<bool> DocDBTableReader::ReadProjection(
+    const std::vector<PrimitiveValue>& projection, KeyBytes* key_bytes,
+    const Consumer& consumer) {
+  bool doc_found = false;
+  const size_t subdocument_key_size = key_bytes->size();
+  // The live packed row means that the document exists, even if all projected columns are null.
+  PackedRowDecoder packed_row;
+  const bool has_packed_row = !subdoc_reader_builder_.packed_row().empty();
+  if (has_packed_row) {
+    RETURN_NOT_OK(packed_row.Init(subdoc_reader_builder_.packed_row()));
+    doc_found = true;
+  }
+  for (size_t i = 0; i != projection.size(); ++i) {
+    // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
+    // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
+    // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
+    projection[i].AppendToKey(key_bytes);
+    key_bytes->Reserve(key_bytes->size() + kMaxBytesPerEncodedHybridTime + 1);
+    // This seek is to initialize the iterator for BuildSubDocument call.
+    iter_->SeekForward(key_bytes);
+    SubDocument descendant;
+    auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(*key_bytes));
+    RETURN_NOT_OK(reader->Get(&descendant));
+    if (has_packed_row) {
+      RETURN_NOT_OK(ApplyPackedColumn(
+          packed_row, *key_bytes, subdocument_key_size, &descendant));
+    }
+    doc_found = doc_found || (
+        descendant.value_type() != ValueType::kInvalid
+        && descendant.value_type() != ValueType::kTombstone);
+    consumer(i, std::move(descendant));
+
+    // Restore subdocument key by truncating the appended subkey.
+    key_bytes->Truncate(subdocument_key_size);
+  }
+  return doc_found;
+}
+
 Result<bool> DocDBTableReader::Get(
     const Slice& root_doc_key, const vector<PrimitiveValue>* projection, SubDocument* result) {
   RETURN_NOT_OK(InitForKey(root_doc_key));
@@ -138,27 +178,10 @@ Result<bool> DocDBTableReader::Get(
   key_bytes.Reserve(root_doc_key.size() + kMaxBytesPerEncodedHybridTime + 32);
   key_bytes.AppendRawBytes(root_doc_key);
   if (projection != nullptr) {
-    bool doc_found = false;
-    const size_t subdocument_key_size = key_bytes.size();
-    for (const PrimitiveValue& subkey : *projection) {
-      // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
-      // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
-      // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
-      subkey.AppendToKey(&key_bytes);
-      key_bytes.Reserve(key_bytes.size() + kMaxBytesPerEncodedHybridTime + 1);
-      // This seek is to initialize the iterator for BuildSubDocument call.
-      iter_->SeekForward(&key_bytes);
-      SubDocument descendant;
-      auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
-      RETURN_NOT_OK(reader->Get(&descendant));
-      doc_found = doc_found || (
-          descendant.value_type() != ValueType::kInvalid
-          && descendant.value_type() != ValueType::kTombstone);
-      result->SetChild(subkey, std::move(descendant));
-
-      // Restore subdocument key by truncating the appended subkey.
-      key_bytes.Truncate(subdocument_key_size);
-    }
+    auto doc_found = VERIFY_RESULT(ReadProjection(
+        *projection, &key_bytes, [projection, result](size_t idx, SubDocument&& column) {
+      result->SetChild((*projection)[idx], std::move(column));
+    }));
     if (doc_found) {
       iter_->SeekOutOfSubDoc(root_doc_key);
       return true;
@@ -181,5 +204,70 @@ Result<bool> DocDBTableReader::Get(
       && result->value_type() != ValueType::kTombstone;
 }
 
+Result<bool> DocDBTableReader::GetProjection(
+    const Slice& root_doc_key, const std::vector<PrimitiveValue>& projection,
+    std::vector<SubDocument>* columns) {
+  RETURN_NOT_OK(InitForKey(root_doc_key));
+  KeyBytes key_bytes;
+  key_bytes.Reserve(root_doc_key.size() + kMaxBytesPerEncodedHybridTime + 32);
+  key_bytes.AppendRawBytes(root_doc_key);
+  columns->resize(projection.size());
+  auto doc_found = VERIFY_RESULT(ReadProjection(
+      projection, &key_bytes, [columns](size_t idx, SubDocument&& column) {
+    (*columns)[idx] = std::move(column);
+  }));
+  if (doc_found) {
+    iter_->SeekOutOfSubDoc(root_doc_key);
+    return true;
+  }
+
+  // None of the projected columns is live, so we have to check whether the row has other columns.
+  // Projected columns are taken from the whole row in this case, the same way as Get does.
+  iter_->Seek(key_bytes);
+  auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
+  SubDocument row;
+  RETURN_NOT_OK(reader->Get(&row));
+  if (row.value_type() == ValueType::kInvalid || row.value_type() == ValueType::kTombstone) {
+    return false;
+  }
+  for (size_t i = 0; i != projection.size(); ++i) {
+    auto* column = row.GetChild(projection[i]);
+    (*columns)[i] = column ? std::move(*column) : SubDocument();
+  }
+  return true;
+}
+
+Status DocDBTableReader::ApplyPackedColumn(
+    const PackedRowDecoder& packed_row, const KeyBytes& column_key, size_t doc_key_size,
+    SubDocument* column) {
+  // Any live value read for the column was written after the row was packed, since older values
+  // are overwritten by the packed row.
+  if (column->value_type() != ValueType::kInvalid &&
+      column->value_type() != ValueType::kTombstone) {
+    return Status::OK();
+  }
+  Slice encoded_subkey = column_key.AsSlice();
+  encoded_subkey.remove_prefix(doc_key_size);
+  auto encoded_value = packed_row.FindValue(encoded_subkey);
+  if (encoded_value.empty()) {
+    return Status::OK();
+  }
+  if (column->value_type() == ValueType::kTombstone) {
+    // Tombstone could be either an explicit delete of the column after the row was packed, or
+    // result of an older value being overwritten by the packed row.
+    DocHybridTime column_write_time = subdoc_reader_builder_.packed_row_write_time();
+    RETURN_NOT_OK(iter_->FindLatestRecord(column_key, &column_write_time, nullptr));
+    if (column_write_time != subdoc_reader_builder_.packed_row_write_time()) {
+      return Status::OK();
+    }
+  }
+  PrimitiveValue value;
+  RETURN_NOT_OK(value.DecodeFromValue(encoded_value));
+  value.SetWriteTime(
+      subdoc_reader_builder_.packed_row_write_time().hybrid_time().GetPhysicalValueMicros());
+  *column = SubDocument(std::move(value));
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
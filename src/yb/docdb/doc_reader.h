@@ -41,6 +41,7 @@ namespace yb {
 namespace docdb {
 
 class IntentAwareIterator;
+class PackedRowDecoder;
 
 // Returns the whole SubDocument below some node identified by subdocument_key.
 // subdocument_key should not have a timestamp.
@@ -95,6 +96,15 @@ class DocDBTableReader {
       const Slice& root_doc_key, const std::vector<PrimitiveValue>* projection,
       SubDocument* result);
 
+  // Same as Get with projection, but instead of building the row SubDocument, stores the value
+  // read for projection[i] to (*columns)[i]. Columns that were not found are left with
+  // ValueType::kInvalid (or kTombstone if they were deleted). Only the projected columns are
+  // looked up, unless none of them is found, in which case the whole row is read to decide whether
+  // it exists.
+  Result<bool> GetProjection(
+      const Slice& root_doc_key, const std::vector<PrimitiveValue>& projection,
+      std::vector<SubDocument>* columns);
+
  private:
   // Initializes the reader to read a row at sub_doc_key by seeking to and reading obsolescence info
   // at that row.
@@ -104,6 +114,20 @@ class DocDBTableReader {
   // seek_fwd_suffices_ flag.
   void SeekTo(const Slice& subdoc_key);
 
+  // Reads each column from projection below the row key stored in key_bytes, passing its index in
+  // projection and value to consumer. Returns true if some of the projected columns or the packed
+  // row is live.
+  template <class Consumer>
+  Result<bool> ReadProjection(
+      const std::vector<PrimitiveValue>& projection, KeyBytes* key_bytes,
+      const Consumer& consumer);
+
+  // Fills column read from column_key with the value from packed_row, unless the column was
+  // written after the row was packed.
+  CHECKED_STATUS ApplyPackedColumn(
+      const PackedRowDecoder& packed_row, const KeyBytes& column_key, size_t doc_key_size,
+      SubDocument* column);
+
   // Owned by caller.
   IntentAwareIterator* iter_;
   DeadlineInfo deadline_info_;
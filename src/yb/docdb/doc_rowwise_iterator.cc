@@ -50,7 +50,13 @@
 #include "yb/util/slice.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/util/flag_tags.h"
 
+DEFINE_bool(docdb_rowwise_iterator_projection_fast_path, true,
+            "Read projected columns of each row directly into a vector indexed by projection "
+            "position, instead of building a SubDocument for the row.");
+TAG_FLAG(docdb_rowwise_iterator_projection_fast_path, advanced);
+TAG_FLAG(docdb_rowwise_iterator_projection_fast_path, runtime);
 
 using std::string;
 
@@ -483,13 +489,29 @@ DocRowwiseIterator::DocRowwiseIterator(
       doc_db_(doc_db),
       has_bound_key_(false),
       pending_op_(pending_op_counter),
-      done_(false) {
+      done_(false),
+      use_projection_fast_path_(FLAGS_docdb_rowwise_iterator_projection_fast_path) {
   projection_subkeys_.reserve(projection.num_columns() + 1);
   projection_subkeys_.push_back(PrimitiveValue::kLivenessColumn);
   for (size_t i = projection_.num_key_columns(); i < projection.num_columns(); i++) {
     projection_subkeys_.emplace_back(projection.column_id(i));
   }
   std::sort(projection_subkeys_.begin(), projection_subkeys_.end());
+
+  liveness_column_index_ = ProjectionSubKeyIndex(PrimitiveValue::kLivenessColumn);
+  projection_column_indexes_.reserve(projection.num_columns() - projection.num_key_columns());
+  for (size_t i = projection_.num_key_columns(); i < projection.num_columns(); i++) {
+    projection_column_indexes_.push_back(
+        ProjectionSubKeyIndex(PrimitiveValue(projection.column_id(i))));
+  }
+}
+
+size_t DocRowwiseIterator::ProjectionSubKeyIndex(const PrimitiveValue& subkey) const {
+  auto it = std::lower_bound(projection_subkeys_.begin(), projection_subkeys_.end(), subkey);
+  if (it == projection_subkeys_.end() || *it != subkey) {
+    return projection_subkeys_.size();
+  }
+  return it - projection_subkeys_.begin();
 }
 
 DocRowwiseIterator::~DocRowwiseIterator() {
@@ -614,6 +636,40 @@ Status DocRowwiseIterator::Init(const common::PgsqlScanSpec& spec) {
   return DoInit(dynamic_cast<const DocPgsqlScanSpec&>(spec));
 }
 
+Status DocRowwiseIterator::InitForTupleLookups(
+    const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key, rocksdb::QueryId query_id) {
+  ignore_ttl_ = true;
+  is_forward_scan_ = true;
+  tuple_lookups_query_id_ = query_id;
+
+  // Keys of the upper_doc_key row have upper_doc_key as a prefix, so bound is made strictly
+  // greater than all of them.
+  bound_key_ = upper_doc_key;
+  bound_key_.AppendValueType(ValueType::kMaxByte);
+  has_bound_key_ = true;
+
+  CreateTupleLookupIterator(lower_doc_key);
+  db_iter_->Seek(lower_doc_key);
+  return Status::OK();
+}
+
+void DocRowwiseIterator::CreateTupleLookupIterator(const Slice& filter_key) {
+  // Bloom filter is checked once per SST file when the iterator is created, so it is used for all
+  // rows that share the key prefix used by bloom filter with filter_key.
+  tuple_lookups_filter_key_.Reset(filter_key);
+  doc_reader_.reset();
+  db_iter_ = CreateIntentAwareIterator(
+      doc_db_,
+      BloomFilterMode::USE_BLOOM_FILTER,
+      tuple_lookups_filter_key_.AsSlice(),
+      *tuple_lookups_query_id_,
+      txn_op_context_,
+      deadline_,
+      read_time_);
+  db_iter_->SetUpperbound(bound_key_);
+  row_ready_ = false;
+}
+
 Status DocRowwiseIterator::AdvanceIteratorToNextDesiredRow() const {
   if (scan_choices_) {
     if (!IsNextStaticColumn()
@@ -724,8 +780,14 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       }
     }
 
-    row_ = SubDocument();
-    auto doc_found_res = doc_reader_->Get(sub_doc_key, &projection_subkeys_, &row_);
+    Result<bool> doc_found_res(false);
+    if (use_projection_fast_path_) {
+      doc_found_res = doc_reader_->GetProjection(
+          sub_doc_key, projection_subkeys_, &projected_columns_);
+    } else {
+      row_ = SubDocument();
+      doc_found_res = doc_reader_->Get(sub_doc_key, &projection_subkeys_, &row_);
+    }
     if (!doc_found_res.ok()) {
       has_next_status_ = doc_found_res.status();
       return has_next_status_;
@@ -823,10 +885,19 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
         "range", &decoder, table_row));
   }
 
+  const bool same_projection = &projection == &projection_;
   for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
     const auto& column_id = projection.column_id(i);
     const auto ql_type = projection.column(i).type();
-    const SubDocument* column_value = row_.GetChild(PrimitiveValue(column_id));
+    const SubDocument* column_value;
+    if (!use_projection_fast_path_) {
+      column_value = row_.GetChild(PrimitiveValue(column_id));
+    } else if (same_projection) {
+      column_value = &projected_columns_[
+          projection_column_indexes_[i - projection.num_key_columns()]];
+    } else {
+      column_value = ProjectedColumn(ProjectionSubKeyIndex(PrimitiveValue(column_id)));
+    }
     if (column_value != nullptr) {
       QLTableColumn& column = table_row->AllocColumn(column_id);
       SubDocument::ToQLValuePB(*column_value, ql_type, &column.value);
@@ -841,8 +912,14 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+const SubDocument* DocRowwiseIterator::ProjectedColumn(size_t subkey_index) const {
+  return subkey_index < projected_columns_.size() ? &projected_columns_[subkey_index] : nullptr;
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
-  const SubDocument* subdoc = row_.GetChild(PrimitiveValue::kLivenessColumn);
+  const SubDocument* subdoc = use_projection_fast_path_
+      ? ProjectedColumn(liveness_column_index_)
+      : row_.GetChild(PrimitiveValue::kLivenessColumn);
   return subdoc != nullptr && subdoc->value_type() != ValueType::kInvalid;
 }
 
@@ -897,10 +974,16 @@ Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
       tuple_key_->Truncate(1 + size);
     }
     tuple_key_->AppendRawBytes(tuple_id);
-    db_iter_->Seek(*tuple_key_);
-  } else {
-    db_iter_->Seek(tuple_id);
   }
+  const Slice seek_key = tuple_key_ ? tuple_key_->AsSlice() : tuple_id;
+
+  // Iterator of tuple lookups filters SST files by bloom filter of the rows with the same key
+  // prefix, so a new one is created for rows with another prefix, e.g. another hash code.
+  if (tuple_lookups_query_id_ &&
+      !VERIFY_RESULT(HashedOrFirstRangeComponentsEqual(tuple_lookups_filter_key_, seek_key))) {
+    CreateTupleLookupIterator(seek_key);
+  }
+  db_iter_->Seek(seek_key);
 
   iter_key_.Clear();
   row_ready_ = false;
@@ -71,6 +71,13 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   CHECKED_STATUS Init(const common::QLScanSpec& spec);
   CHECKED_STATUS Init(const common::PgsqlScanSpec& spec);
 
+  // Init iterator for looking up multiple rows with SeekTuple, in increasing order of their keys.
+  // All looked up rows should belong to the range [lower_doc_key, upper_doc_key].
+  // Consecutive rows that share the key prefix used by bloom filter are looked up through the same
+  // RocksDB iterator, and SST files are filtered by bloom filter for each such group of rows.
+  CHECKED_STATUS InitForTupleLookups(
+      const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key, rocksdb::QueryId query_id);
+
   // This must always be called before NextRow. The implementation actually finds the
   // first row to scan, and NextRow expects the RocksDB iterator to already be properly
   // positioned.
@@ -125,6 +132,10 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
       const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
       const KeyBytes& upper_doc_key);
 
+  // Creates iterator of tuple lookups that uses bloom filter for rows with the key prefix of
+  // filter_key.
+  void CreateTupleLookupIterator(const Slice& filter_key);
+
   // Get the non-key column values of a QL row.
   CHECKED_STATUS GetValues(const Schema& projection, vector<SubDocument>* values);
 
@@ -161,6 +172,13 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Returns index of subkey in projection_subkeys_, or projection_subkeys_.size() if absent.
+  size_t ProjectionSubKeyIndex(const PrimitiveValue& subkey) const;
+
+  // Returns value of the column read by the projection fast path, or nullptr if subkey_index is
+  // out of range.
+  const SubDocument* ProjectedColumn(size_t subkey_index) const;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -216,12 +234,30 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
 
   mutable std::vector<PrimitiveValue> projection_subkeys_;
 
+  // When set, HasNext reads the projected columns into projected_columns_ instead of building
+  // the whole row_ SubDocument, and DoNextRow picks column values by their index.
+  const bool use_projection_fast_path_;
+
+  // Values of the columns read by HasNext, at the same positions as in projection_subkeys_.
+  mutable std::vector<SubDocument> projected_columns_;
+
+  // Index in projection_subkeys_ of each non-key column of projection_.
+  std::vector<size_t> projection_column_indexes_;
+
+  // Index of the liveness column in projection_subkeys_.
+  size_t liveness_column_index_;
+
   // Used for keeping track of errors in HasNext.
   mutable Status has_next_status_;
 
   // Key for seeking a YSQL tuple. Used only when the table has a cotable id.
   boost::optional<KeyBytes> tuple_key_;
 
+  // Set by InitForTupleLookups. Query id and bloom filter key of the current iterator of tuple
+  // lookups.
+  boost::optional<rocksdb::QueryId> tuple_lookups_query_id_;
+  KeyBytes tuple_lookups_filter_key_;
+
   mutable std::unique_ptr<DocDBTableReader> doc_reader_ = nullptr;
 
   mutable bool ignore_ttl_ = false;
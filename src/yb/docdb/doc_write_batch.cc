@@ -384,6 +384,20 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   return SetPrimitive(doc_path, value, &iter);
 }
 
+Status DocWriteBatch::SetPackedRow(const Slice& encoded_doc_key, std::string packed_row) {
+  if (put_batch_.size() > numeric_limits<IntraTxnWriteId>::max()) {
+    return STATUS_SUBSTITUTE(
+        NotSupported,
+        "Trying to add more than $0 key/value pairs in the same single-shard txn.",
+        numeric_limits<IntraTxnWriteId>::max());
+  }
+  const auto write_id = static_cast<IntraTxnWriteId>(put_batch_.size());
+  put_batch_.emplace_back(encoded_doc_key.ToBuffer(), std::move(packed_row));
+  cache_.Put(KeyBytes(encoded_doc_key), DocHybridTime(HybridTime::kMax, write_id),
+             ValueType::kPackedRow);
+  return Status::OK();
+}
+
 Status DocWriteBatch::ExtendSubDocument(
     const DocPath& doc_path,
     const SubDocument& value,
@@ -186,6 +186,10 @@ class DocWriteBatch {
                         read_ht, deadline, query_id, user_timestamp);
   }
 
+  // Writes a packed row (see packed_row.h) as the value of the whole document. Existing columns of
+  // the document written before this call are overwritten by it.
+  CHECKED_STATUS SetPackedRow(const Slice& encoded_doc_key, std::string packed_row);
+
   void Clear();
   bool IsEmpty() const { return put_batch_.empty(); }
 
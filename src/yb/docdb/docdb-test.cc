@@ -34,6 +34,7 @@
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/walltime.h"
 #include "yb/tablet/tablet_options.h"
@@ -682,6 +683,116 @@ TEST_F(DocDBTestQl, ColocatedTableTombstoneTest) {
   VerifySubDocument(SubDocKey(doc_key_1), 1500_usec_ht, "1");
 }
 
+TEST_F(DocDBTestQl, PackedRow) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  // Written before the row was packed, so should be hidden by the packed row.
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, PrimitiveValue(ColumnId(30))), PrimitiveValue("old"), 500_usec_ht));
+
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(PrimitiveValue::kLivenessColumn, PrimitiveValue());
+  packer.AddValue(PrimitiveValue(ColumnId(30)), PrimitiveValue(3));
+  packer.AddValue(PrimitiveValue(ColumnId(10)), PrimitiveValue(1));
+  packer.AddValue(PrimitiveValue(ColumnId(20)), PrimitiveValue("value"));
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPackedRow(encoded_doc_key, packer.Complete()));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, 1000_usec_ht));
+
+  // Columns updated after the row was packed.
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, PrimitiveValue(ColumnId(10))), PrimitiveValue(2), 2000_usec_ht));
+  ASSERT_OK(DeleteSubDoc(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(20))), 2000_usec_ht));
+
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+      SubDocKey(DocKey([], ["mydockey", 123456]), [HT{ physical: 1000 }]) -> \
+          PACKED_ROW[1]{ SystemColumnId(0): null; ColumnId(10): 1; ColumnId(20): "value"; \
+          ColumnId(30): 3 }
+      SubDocKey(DocKey([], ["mydockey", 123456]), [ColumnId(10); HT{ physical: 2000 }]) -> 2
+      SubDocKey(DocKey([], ["mydockey", 123456]), [ColumnId(20); HT{ physical: 2000 }]) -> DEL
+      SubDocKey(DocKey([], ["mydockey", 123456]), [ColumnId(30); HT{ physical: 500 }]) -> "old"
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 700_usec_ht, R"#(
+{
+  ColumnId(30): "old"
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 1500_usec_ht, R"#(
+{
+  SystemColumnId(0): null,
+  ColumnId(10): 1,
+  ColumnId(20): "value",
+  ColumnId(30): 3
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 4000_usec_ht, R"#(
+{
+  SystemColumnId(0): null,
+  ColumnId(10): 2,
+  ColumnId(30): 3
+}
+      )#");
+
+  // The same through the projection used by row iterators.
+  SubDocument doc_from_rocksdb;
+  bool subdoc_found_in_rocksdb = false;
+  const vector<PrimitiveValue> projection = {
+    PrimitiveValue(ColumnId(10)),
+    PrimitiveValue(ColumnId(20)),
+    PrimitiveValue(ColumnId(30))
+  };
+  GetSubDocQl(
+      doc_db(), SubDocKey(doc_key).EncodeWithoutHt(), &doc_from_rocksdb,
+      &subdoc_found_in_rocksdb, kNonTransactionalOperationContext,
+      ReadHybridTime::SingleTime(4000_usec_ht), &projection);
+  ASSERT_TRUE(subdoc_found_in_rocksdb);
+  ASSERT_STR_EQ_VERBOSE_TRIMMED(R"#(
+{
+  ColumnId(10): 2,
+  ColumnId(20): DEL,
+  ColumnId(30): 3
+}
+  )#", doc_from_rocksdb.ToString());
+}
+
+TEST_F(DocDBTestQl, PackedRowCompactionRemovesDeletedColumns) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(PrimitiveValue::kLivenessColumn, PrimitiveValue());
+  packer.AddValue(PrimitiveValue(ColumnId(10)), PrimitiveValue(1));
+  packer.AddValue(PrimitiveValue(ColumnId(20)), PrimitiveValue("value"));
+  packer.AddValue(PrimitiveValue(ColumnId(30)), PrimitiveValue(3));
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPackedRow(encoded_doc_key, packer.Complete()));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, 1000_usec_ht));
+
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, PrimitiveValue(ColumnId(10))), PrimitiveValue(2), 2000_usec_ht));
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, PrimitiveValue(ColumnId(20))), PrimitiveValue("new_value"),
+      2000_usec_ht));
+
+  retention_policy_->AddDeletedColumn(ColumnId(20));
+  FullyCompactHistoryBefore(3000_usec_ht);
+
+  // Column 20 is removed both from the packed row and from the later update, while the update of
+  // column 10 is kept as a separate record.
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+      SubDocKey(DocKey([], ["mydockey", 123456]), [HT{ physical: 1000 }]) -> \
+          PACKED_ROW[1]{ SystemColumnId(0): null; ColumnId(10): 1; ColumnId(30): 3 }
+      SubDocKey(DocKey([], ["mydockey", 123456]), [ColumnId(10); HT{ physical: 2000 }]) -> 2
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 4000_usec_ht, R"#(
+{
+  SystemColumnId(0): null,
+  ColumnId(10): 2,
+  ColumnId(30): 3
+}
+      )#");
+}
+
 TEST_P(DocDBTestWrapper, HistoryCompactionFirstRowHandlingRegression) {
   // A regression test for a bug in an initial version of compaction cleanup.
   const DocKey doc_key(PrimitiveValues("mydockey", 123456));
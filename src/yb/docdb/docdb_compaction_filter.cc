@@ -22,6 +22,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/consensus_frontier.h"
 
@@ -35,6 +36,36 @@ using rocksdb::FilterDecision;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Returns packed row without the columns deleted from the schema, or none if the packed row does not
+// contain such columns.
+Result<boost::optional<std::string>> RemoveDeletedColumns(
+    const Slice& packed_value, const ColumnIds& deleted_cols) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_value));
+  RowPacker packer(decoder.schema_version());
+  for (size_t idx = 0; idx != decoder.num_columns(); ++idx) {
+    const Slice& subkey = decoder.encoded_subkey(idx);
+    if (!subkey.empty() && subkey[0] == ValueTypeAsChar::kColumnId) {
+      Slice column_id_slice(subkey.data() + 1, subkey.end());
+      auto column_id_as_int64 = VERIFY_RESULT(util::FastDecodeSignedVarIntUnsafe(&column_id_slice));
+      ColumnId column_id;
+      RETURN_NOT_OK(ColumnId::FromInt64(column_id_as_int64, &column_id));
+      if (deleted_cols.count(column_id) != 0) {
+        continue;
+      }
+    }
+    packer.AddEncodedValue(subkey, decoder.encoded_value(idx));
+  }
+  if (packer.num_columns() == decoder.num_columns()) {
+    return boost::none;
+  }
+  return packer.Complete();
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -297,6 +328,20 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     value.EncodeAndAppend(new_value, &value_slice);
   }
 
+  // Columns deleted from the schema are also removed from packed rows. Columns updated after the
+  // row was packed are kept as separate records, since they follow the packed row in the key order.
+  // TODO(packed_row): fold column updates below the history cutoff into the packed row. This needs
+  // the filter to buffer the packed row until all columns of the row have been seen.
+  if (!has_expired && value_type == ValueType::kPackedRow && !retention_.deleted_cols->empty()) {
+    auto repacked = VERIFY_RESULT(RemoveDeletedColumns(value_slice, *retention_.deleted_cols));
+    if (repacked) {
+      *value_changed = true;
+      new_value->clear();
+      Slice repacked_slice(*repacked);
+      value.EncodeAndAppend(new_value, &repacked_slice);
+    }
+  }
+
   // If we are backfilling an index table, we want to preserve the delete markers in the table
   // until the backfill process is completed. For other normal use cases, delete markers/tombstones
   // can be cleaned up on a major compaction.
@@ -28,6 +28,7 @@ class DocWriteBatch;
 class IntentAwareIterator;
 class KeyBytes;
 class KeyValueWriteBatchPB;
+class LockBatch;
 class PgsqlWriteOperation;
 class QLWriteOperation;
 class SubDocKey;
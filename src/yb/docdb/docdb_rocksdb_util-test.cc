@@ -11,7 +11,9 @@
 // under the License.
 //
 
+#include "yb/docdb/data_block_hybrid_time_index.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table.h"
 
 #include "yb/util/test_util.h"
@@ -137,5 +139,49 @@ TEST_F(DocDBRocksDBUtilTest, DefaultBlockRestartInterval) {
   CHECK_EQ(blockBasedOptions.block_restart_interval, 16);
 }
 
+namespace {
+
+std::string InternalKeyWithHt(const std::string& key, HybridTime ht) {
+  auto user_key = SubDocKey(DocKey({PrimitiveValue(key)}), ht).Encode();
+  return rocksdb::InternalKey(user_key.AsSlice(), 1, rocksdb::kTypeValue).Encode().ToBuffer();
+}
+
+} // namespace
+
+TEST_F(DocDBRocksDBUtilTest, DataBlockHybridTimeIndex) {
+  auto collector = DocHybridTimeDataBlockPropertiesCollectorFactory()->CreateCollector();
+  collector->AddKey(InternalKeyWithHt("a", HybridTime(2000)));
+  collector->AddKey(InternalKeyWithHt("a", HybridTime(1000)));
+  collector->AddKey(InternalKeyWithHt("b", HybridTime(3000)));
+  std::string properties;
+  collector->FinishBlock(&properties);
+  auto range = ASSERT_RESULT(DecodeDataBlockHybridTimeRange(properties));
+  ASSERT_EQ(HybridTime(1000), range.min);
+  ASSERT_EQ(HybridTime(3000), range.max);
+
+  ASSERT_TRUE(CreateDocHybridTimeDataBlockFilter(HybridTime(3000))->Filter(properties));
+  ASSERT_TRUE(CreateDocHybridTimeDataBlockFilter(HybridTime(1000))->Filter(properties));
+  ASSERT_FALSE(CreateDocHybridTimeDataBlockFilter(HybridTime(999))->Filter(properties));
+
+  // Collector is reset after finishing the block.
+  collector->AddKey(InternalKeyWithHt("c", HybridTime(5000)));
+  properties.clear();
+  collector->FinishBlock(&properties);
+  range = ASSERT_RESULT(DecodeDataBlockHybridTimeRange(properties));
+  ASSERT_EQ(HybridTime(5000), range.min);
+  ASSERT_EQ(HybridTime(5000), range.max);
+
+  // Block containing key without hybrid time has no properties and is never skipped.
+  collector->AddKey(InternalKeyWithHt("d", HybridTime(5000)));
+  collector->AddKey(rocksdb::InternalKey(
+      std::string(1, ValueTypeAsChar::kTransactionApplyState) + "txn", 1, rocksdb::kTypeValue)
+      .Encode());
+  properties.clear();
+  collector->FinishBlock(&properties);
+  ASSERT_TRUE(properties.empty());
+  ASSERT_NOK(DecodeDataBlockHybridTimeRange(properties));
+  ASSERT_TRUE(CreateDocHybridTimeDataBlockFilter(HybridTime(1))->Filter(properties));
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -33,12 +33,14 @@
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/data_block_hybrid_time_index.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 #include "yb/gutil/sysinfo.h"
 
@@ -86,6 +88,27 @@ DEFINE_int64(db_block_size_bytes, 32_KB,
 DEFINE_int64(db_filter_block_size_bytes, 64_KB,
              "Size of RocksDB filter block (in bytes).");
 
+DEFINE_bool(db_filter_blocks_in_multi_touch_cache, false,
+            "Whether to put RocksDB fixed-size filter blocks to the multi-touch part of the block "
+            "cache, so they are not evicted by scans over data blocks.");
+
+DEFINE_bool(db_prefetch_next_filter_block, false,
+            "Whether to read the next RocksDB fixed-size filter block in background when filter "
+            "blocks of an SST file are accessed in forward order.");
+
+DEFINE_int32(db_filter_block_prefetch_threads, 2,
+             "Number of threads used to prefetch RocksDB fixed-size filter blocks when "
+             "db_prefetch_next_filter_block is set.");
+
+DEFINE_int64(db_max_auto_readahead_size_bytes, 256_KB,
+             "Maximum size of readahead issued by RocksDB iterators that read data blocks "
+             "sequentially. 0 disables readahead.");
+
+DEFINE_int64(db_sequential_scan_cache_bypass_bytes, 64_MB,
+             "RocksDB iterator stops adding data blocks it reads from disk to the block cache after "
+             "reading this number of bytes of sequential data blocks, so long scans don't evict "
+             "the working set. 0 means that scans always fill the block cache.");
+
 DEFINE_int64(db_index_block_size_bytes, 32_KB,
              "Size of RocksDB index block (in bytes).");
 
@@ -100,6 +123,11 @@ DEFINE_int32(memstore_size_mb, 128,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_docdb_aware_ribbon_filter, false,
+            "Whether to build DocDB aware filters of new SST files as Ribbon filters instead of "
+            "Bloom filters. Ribbon filter needs less memory for the same false positive rate. "
+            "Files with both kinds of filters are readable regardless of this flag. Used only "
+            "when use_docdb_aware_bloom_filter is set.");
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -109,7 +137,11 @@ DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.
 DEFINE_string(
     regular_tablets_data_block_key_value_encoding, "shared_prefix",
     "Key-value encoding to use for regular data blocks in RocksDB. Possible options: "
-    "shared_prefix, three_shared_parts");
+    "shared_prefix, three_shared_parts. three_shared_parts is optimized for DocDB keys: it shares "
+    "subkeys and hybrid time between consecutive keys of the same row and reuses sequence number "
+    "of the previous key. Only switch to three_shared_parts after the whole cluster runs a "
+    "version that supports it, since SST files written with it could not be read by older "
+    "versions.");
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
@@ -128,6 +160,16 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_uint64(compression_max_dict_bytes, 0,
+              "Maximum size of the dictionary sampled from data blocks of SST file and shared by "
+              "them during compression. Only used with Zlib, LZ4 and ZSTD compression types. "
+              "0 means that dictionary compression is disabled.");
+
+DEFINE_bool(docdb_data_block_hybrid_time_index, true,
+            "Whether to store min and max hybrid time of the records of each regular DB data block "
+            "in its data index entry, and skip blocks with all records written after the global "
+            "limit of the read time.");
+
 DEFINE_int32(block_restart_interval, kDefaultBlockStartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
@@ -346,6 +388,11 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  // Records written after the global limit are never visible to this read, even after read restart.
+  if (FLAGS_docdb_data_block_hybrid_time_index && read_time.global_limit.is_valid() &&
+      read_time.global_limit != HybridTime::kMax) {
+    read_opts.data_block_filter = CreateDocHybridTimeDataBlockFilter(read_time.global_limit);
+  }
   return std::make_unique<IntentAwareIterator>(
       doc_db, read_opts, deadline, read_time, txn_op_context);
 }
@@ -411,6 +458,19 @@ int32_t GetBaseBackgroundCompactions() {
   return FLAGS_rocksdb_base_background_compactions;
 }
 
+// Filter block prefetch uses its own pool, so it does not wait behind compactions and does not
+// delay them. The pool is never destroyed, since tables that use it could be alive at exit.
+ThreadPool* GetGlobalFilterBlockPrefetchThreadPool() {
+  static ThreadPool* filter_block_prefetch_thread_pool = [] {
+    std::unique_ptr<ThreadPool> result;
+    CHECK_OK(ThreadPoolBuilder("filter_prefetch")
+                 .set_max_threads(FLAGS_db_filter_block_prefetch_threads)
+                 .Build(&result));
+    return result.release();
+  }();
+  return filter_block_prefetch_thread_pool;
+}
+
 // Auto initialize some of the RocksDB flags.
 void AutoInitFromRocksDBFlags(rocksdb::Options* options) {
   std::unique_lock<std::mutex> lock(rocksdb_flags_mutex);
@@ -430,6 +490,13 @@ void AutoInitFromBlockBasedTableOptions(rocksdb::BlockBasedTableOptions* table_o
 
   table_options->block_size = FLAGS_db_block_size_bytes;
   table_options->filter_block_size = FLAGS_db_filter_block_size_bytes;
+  table_options->filter_blocks_in_multi_touch_cache = FLAGS_db_filter_blocks_in_multi_touch_cache;
+  table_options->prefetch_next_filter_block = FLAGS_db_prefetch_next_filter_block;
+  if (table_options->prefetch_next_filter_block) {
+    table_options->filter_block_prefetch_thread_pool = GetGlobalFilterBlockPrefetchThreadPool();
+  }
+  table_options->max_auto_readahead_size = FLAGS_db_max_auto_readahead_size_bytes;
+  table_options->sequential_scan_cache_bypass_size = FLAGS_db_sequential_scan_cache_bypass_bytes;
   table_options->index_block_size = FLAGS_db_index_block_size_bytes;
   table_options->min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
 
@@ -579,6 +646,8 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  options->compression_opts.max_dict_bytes =
+      static_cast<uint32_t>(FLAGS_compression_max_dict_bytes);
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -599,10 +668,21 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
+    rocksdb::BlockBasedTableOptions::FilterPolicyPtr bloom_policy =
+        std::make_shared<const DocDbAwareV3FilterPolicy>(
+            filter_block_size_bits, options->info_log.get());
+    rocksdb::BlockBasedTableOptions::FilterPolicyPtr ribbon_policy =
+        std::make_shared<const DocDbAwareV3RibbonFilterPolicy>(
+            filter_block_size_bits, options->info_log.get());
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
+    if (FLAGS_use_docdb_aware_ribbon_filter) {
+      table_options.filter_policy = std::move(ribbon_policy);
+      AddSupportedFilterPolicy(bloom_policy, &table_options);
+    } else {
+      table_options.filter_policy = std::move(bloom_policy);
+      AddSupportedFilterPolicy(ribbon_policy, &table_options);
+    }
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
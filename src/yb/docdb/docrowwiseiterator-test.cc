@@ -31,10 +31,13 @@
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
 DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
+DECLARE_bool(docdb_rowwise_iterator_projection_fast_path);
+DECLARE_bool(use_docdb_aware_bloom_filter);
 
 namespace yb {
 namespace docdb {
@@ -1270,5 +1273,143 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 3);
 }
 
+TEST_F(DocRowwiseIteratorTest, TupleLookups) {
+  const KeyBytes encoded_doc_key3(DocKey(PrimitiveValues("row3", 33333)).Encode());
+  const KeyBytes missing_doc_key(DocKey(PrimitiveValues("row2", 33333)).Encode());
+  auto dwb = MakeDocWriteBatch();
+  for (const auto* key : {&kEncodedDocKey1, &kEncodedDocKey2, &encoded_doc_key3}) {
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(*key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(static_cast<int64_t>(key->size()))));
+  }
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.InitForTupleLookups(kEncodedDocKey1, encoded_doc_key3, rocksdb::kDefaultQueryId));
+
+  QLTableRow row;
+  QLValue value;
+  ASSERT_TRUE(ASSERT_RESULT(iter.SeekTuple(kEncodedDocKey1)));
+  ASSERT_OK(iter.NextRow(&row));
+  ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+  ASSERT_EQ(kEncodedDocKey1.size(), static_cast<size_t>(value.int64_value()));
+
+  ASSERT_FALSE(ASSERT_RESULT(iter.SeekTuple(missing_doc_key)));
+
+  ASSERT_TRUE(ASSERT_RESULT(iter.SeekTuple(encoded_doc_key3)));
+  ASSERT_OK(iter.NextRow(&row));
+  ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+  ASSERT_EQ(encoded_doc_key3.size(), static_cast<size_t>(value.int64_value()));
+}
+
+// Tuple lookups of rows with different bloom filter key prefixes should still filter SST files by
+// bloom filter for each row.
+TEST_F(DocRowwiseIteratorTest, TupleLookupsUseBloomFilter) {
+  if (!FLAGS_use_docdb_aware_bloom_filter) {
+    return;
+  }
+  const KeyBytes encoded_doc_key3(DocKey(PrimitiveValues("row3", 33333)).Encode());
+  // Each row is written to its own SST file.
+  for (const auto* key : {&kEncodedDocKey1, &kEncodedDocKey2, &encoded_doc_key3}) {
+    auto dwb = MakeDocWriteBatch();
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(*key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(static_cast<int64_t>(key->size()))));
+    ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  auto& statistics = *regular_db_options().statistics;
+  auto bloom_useful = statistics.getTickerCount(rocksdb::BLOOM_FILTER_USEFUL);
+  ASSERT_OK(iter.InitForTupleLookups(kEncodedDocKey1, encoded_doc_key3, rocksdb::kDefaultQueryId));
+
+  QLTableRow row;
+  for (const auto* key : {&kEncodedDocKey1, &encoded_doc_key3}) {
+    ASSERT_TRUE(ASSERT_RESULT(iter.SeekTuple(*key)));
+    ASSERT_OK(iter.NextRow(&row));
+    // Files of other rows are filtered out by bloom filter.
+    const auto new_bloom_useful = statistics.getTickerCount(rocksdb::BLOOM_FILTER_USEFUL);
+    ASSERT_GT(new_bloom_useful, bloom_useful) << key->ToString();
+    bloom_useful = new_bloom_useful;
+  }
+}
+
+// Compares scan throughput of a narrow projection over a wide table with and without the
+// projection fast path.
+TEST_F(DocRowwiseIteratorTest, NarrowProjectionBenchmark) {
+  constexpr int kNumValueColumns = 50;
+  const int num_rows = AllowSlowTests() ? 50000 : 2000;
+
+  std::vector<ColumnSchema> columns = {
+    ColumnSchema("a", DataType::STRING, /* is_nullable = */ false),
+    ColumnSchema("b", DataType::INT64, false),
+  };
+  std::vector<ColumnId> column_ids = { 10_ColId, 20_ColId };
+  for (int i = 0; i != kNumValueColumns; ++i) {
+    columns.emplace_back(Format("c$0", i), DataType::INT64, true);
+    column_ids.emplace_back(100 + i);
+  }
+  const Schema schema(columns, column_ids, 2);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"c7", "c42"}, &projection));
+
+  for (int row = 0; row != num_rows; ++row) {
+    auto dwb = MakeDocWriteBatch();
+    KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", row), row)).Encode());
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue::kLivenessColumn), PrimitiveValue()));
+    for (int i = 0; i != kNumValueColumns; ++i) {
+      ASSERT_OK(dwb.SetPrimitive(
+          DocPath(encoded_doc_key, PrimitiveValue(ColumnId(100 + i))),
+          PrimitiveValue(static_cast<int64_t>(row) * kNumValueColumns + i)));
+    }
+    ASSERT_OK(WriteToRocksDB(dwb, HybridTime::FromMicros(1000)));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  int64_t expected_sum = 0;
+  for (bool fast_path : {false, true}) {
+    FLAGS_docdb_rowwise_iterator_projection_fast_path = fast_path;
+    DocRowwiseIterator iter(
+        projection, schema, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    ASSERT_OK(iter.Init(YQL_TABLE_TYPE));
+
+    QLTableRow row;
+    QLValue value;
+    int rows_read = 0;
+    int64_t sum = 0;
+    Stopwatch sw;
+    sw.start();
+    while (ASSERT_RESULT(iter.HasNext())) {
+      ASSERT_OK(iter.NextRow(&row));
+      for (size_t i = 0; i != projection.num_columns(); ++i) {
+        ASSERT_OK(row.GetValue(projection.column_id(i), &value));
+        sum += value.int64_value();
+      }
+      ++rows_read;
+    }
+    sw.stop();
+    ASSERT_EQ(num_rows, rows_read);
+    if (fast_path) {
+      ASSERT_EQ(expected_sum, sum);
+    } else {
+      expected_sum = sum;
+    }
+    LOG(INFO) << "Fast path: " << fast_path << ", read " << rows_read << " rows in "
+              << sw.elapsed().wall_seconds() << " seconds, "
+              << rows_read / std::max(sw.elapsed().wall_seconds(), 1e-6) << " rows/sec";
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -23,6 +23,7 @@
 #include "yb/docdb/intent.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/packed_row.h"
 
 namespace yb {
 namespace docdb {
@@ -98,6 +99,10 @@ Result<std::string> DocDBValueToDebugStrInternal(Slice value_slice, KeyType key_
     RETURN_NOT_OK_PREPEND(
         v.Decode(value_slice),
         Format("Error: failed to decode value $0", prefix));
+    if (v.value_type() == ValueType::kPackedRow) {
+      RETURN_NOT_OK(v.DecodeControlFields(&value_slice));
+      return prefix + PackedRowToString(value_slice);
+    }
     return prefix + v.ToString();
   } else {
     return prefix + "none";
@@ -26,7 +26,11 @@ namespace docdb {
 LockBatch::LockBatch(SharedLockManager* lock_manager, LockBatchEntries&& key_to_intent_type,
                      CoarseTimePoint deadline)
     : data_(std::move(key_to_intent_type), lock_manager) {
-  if (!empty() && !lock_manager->Lock(&data_.key_to_type, deadline)) {
+  Lock(deadline);
+}
+
+void LockBatch::Lock(CoarseTimePoint deadline) {
+  if (!empty() && !data_.shared_lock_manager->Lock(&data_.key_to_type, deadline)) {
     data_.shared_lock_manager = nullptr;
     std::string batch_str;
     if (FLAGS_dump_lock_keys) {
@@ -48,6 +52,24 @@ void LockBatch::Reset() {
     DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
     data_.key_to_type.clear();
   }
+  data_.unlocked_key_to_type.clear();
+}
+
+void LockBatch::Unlock() {
+  if (!empty()) {
+    VLOG(1) << "Temporarily unlocking a LockBatch with " << size() << " keys";
+    DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    data_.unlocked_key_to_type = std::move(data_.key_to_type);
+    data_.key_to_type.clear();
+  }
+}
+
+Status LockBatch::Relock(CoarseTimePoint deadline) {
+  DCHECK(empty());
+  data_.key_to_type = std::move(data_.unlocked_key_to_type);
+  data_.unlocked_key_to_type.clear();
+  Lock(deadline);
+  return data_.status;
 }
 
 void LockBatch::MoveFrom(LockBatch* other) {
@@ -56,6 +78,7 @@ void LockBatch::MoveFrom(LockBatch* other) {
   // Explicitly clear other key_to_type to avoid extra unlock when it is destructed. We use
   // key_to_type emptiness to mark that it does not hold a lock.
   other->data_.key_to_type.clear();
+  other->data_.unlocked_key_to_type.clear();
 }
 
 
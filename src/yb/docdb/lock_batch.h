@@ -74,7 +74,16 @@ class LockBatch {
   // Unlocks this batch if it is non-empty.
   void Reset();
 
+  // Unlocks this batch, but keeps its keys, so it could be locked again using Relock.
+  void Unlock();
+
+  // Locks keys of the batch that was unlocked using Unlock.
+  // Batch stays unlocked if locks could not be obtained until deadline.
+  CHECKED_STATUS Relock(CoarseTimePoint deadline);
+
  private:
+  void Lock(CoarseTimePoint deadline);
+
   void MoveFrom(LockBatch* other);
 
   struct Data {
@@ -90,6 +99,9 @@ class LockBatch {
 
     LockBatchEntries key_to_type;
 
+    // Keys of the batch unlocked using Unlock.
+    LockBatchEntries unlocked_key_to_type;
+
     SharedLockManager* shared_lock_manager = nullptr;
 
     Status status;
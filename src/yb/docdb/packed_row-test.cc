@@ -0,0 +1,79 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/packed_row.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PackedRowTest : public YBTest {
+};
+
+namespace {
+
+std::string EncodeSubKey(const PrimitiveValue& subkey) {
+  KeyBytes result;
+  subkey.AppendToKey(&result);
+  return result.ToStringBuffer();
+}
+
+} // namespace
+
+TEST_F(PackedRowTest, EncodeDecode) {
+  RowPacker packer(/* schema_version= */ 7);
+  packer.AddValue(PrimitiveValue(ColumnId(20)), PrimitiveValue("text"));
+  packer.AddValue(PrimitiveValue::kLivenessColumn, PrimitiveValue());
+  packer.AddValue(PrimitiveValue(ColumnId(10)), PrimitiveValue(12345));
+  ASSERT_EQ(3, packer.num_columns());
+  auto packed = packer.Complete();
+  ASSERT_TRUE(IsPackedRow(packed));
+
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed));
+  ASSERT_EQ(7, decoder.schema_version());
+  ASSERT_EQ(3, decoder.num_columns());
+  // Columns are sorted by encoded subkey, system columns go first.
+  ASSERT_EQ(EncodeSubKey(PrimitiveValue::kLivenessColumn), decoder.encoded_subkey(0).ToBuffer());
+  ASSERT_EQ(EncodeSubKey(PrimitiveValue(ColumnId(10))), decoder.encoded_subkey(1).ToBuffer());
+  ASSERT_EQ(EncodeSubKey(PrimitiveValue(ColumnId(20))), decoder.encoded_subkey(2).ToBuffer());
+
+  PrimitiveValue value;
+  ASSERT_OK(value.DecodeFromValue(decoder.FindValue(EncodeSubKey(PrimitiveValue(ColumnId(10))))));
+  ASSERT_EQ(PrimitiveValue(12345), value);
+  ASSERT_OK(value.DecodeFromValue(decoder.FindValue(EncodeSubKey(PrimitiveValue(ColumnId(20))))));
+  ASSERT_EQ(PrimitiveValue("text"), value);
+
+  auto missing = EncodeSubKey(PrimitiveValue(ColumnId(15)));
+  ASSERT_EQ(decoder.num_columns(), decoder.FindColumn(missing));
+  ASSERT_TRUE(decoder.FindValue(missing).empty());
+
+  ASSERT_EQ(
+      R"#(PACKED_ROW[7]{ SystemColumnId(0): null; ColumnId(10): 12345; ColumnId(20): "text" })#",
+      PackedRowToString(packed));
+}
+
+TEST_F(PackedRowTest, Corrupted) {
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(PrimitiveValue(ColumnId(10)), PrimitiveValue("text"));
+  auto packed = packer.Complete();
+
+  PackedRowDecoder decoder;
+  ASSERT_NOK(decoder.Init(Slice(packed.data(), packed.size() - 1)));
+  ASSERT_NOK(decoder.Init(packed + "x"));
+  ASSERT_NOK(decoder.Init(packed.substr(1)));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,141 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/fast_varint.h"
+#include "yb/util/format.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+Result<Slice> DecodeSizePrefixed(Slice* input) {
+  auto size = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(input));
+  if (size > input->size()) {
+    return STATUS_FORMAT(
+        Corruption, "Not enough bytes in packed row: $0 needed, $1 left", size, input->size());
+  }
+  Slice result(input->data(), size);
+  input->remove_prefix(size);
+  return result;
+}
+
+} // namespace
+
+void RowPacker::AddValue(const PrimitiveValue& subkey, const PrimitiveValue& value) {
+  KeyBytes encoded_subkey;
+  subkey.AppendToKey(&encoded_subkey);
+  columns_.emplace_back(encoded_subkey.ToStringBuffer(), value.ToValue());
+}
+
+void RowPacker::AddEncodedValue(const Slice& encoded_subkey, const Slice& encoded_value) {
+  columns_.emplace_back(encoded_subkey.ToBuffer(), encoded_value.ToBuffer());
+}
+
+std::string RowPacker::Complete() {
+  std::sort(columns_.begin(), columns_.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  size_t size = 1 + util::kMaxVarIntBufferSize * 2;
+  for (const auto& column : columns_) {
+    size += column.first.size() + column.second.size() + util::kMaxVarIntBufferSize * 2;
+  }
+
+  std::string result;
+  result.reserve(size);
+  result.push_back(ValueTypeAsChar::kPackedRow);
+  util::FastAppendUnsignedVarIntToStr(schema_version_, &result);
+  util::FastAppendUnsignedVarIntToStr(columns_.size(), &result);
+  for (const auto& column : columns_) {
+    util::FastAppendUnsignedVarIntToStr(column.first.size(), &result);
+    result += column.first;
+    util::FastAppendUnsignedVarIntToStr(column.second.size(), &result);
+    result += column.second;
+  }
+  columns_.clear();
+  return result;
+}
+
+Status PackedRowDecoder::Init(const Slice& packed_value) {
+  Slice input = packed_value;
+  RETURN_NOT_OK(input.consume_byte(ValueTypeAsChar::kPackedRow));
+  schema_version_ = static_cast<uint32_t>(VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input)));
+  auto num_columns = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input));
+  columns_.clear();
+  columns_.reserve(num_columns);
+  for (uint64_t i = 0; i != num_columns; ++i) {
+    auto subkey = VERIFY_RESULT(DecodeSizePrefixed(&input));
+    auto value = VERIFY_RESULT(DecodeSizePrefixed(&input));
+    columns_.emplace_back(subkey, value);
+  }
+  if (!input.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "Extra $0 bytes at the end of packed row: $1", input.size(),
+        packed_value.ToDebugHexString());
+  }
+  return Status::OK();
+}
+
+size_t PackedRowDecoder::FindColumn(const Slice& encoded_subkey) const {
+  auto it = std::lower_bound(
+      columns_.begin(), columns_.end(), encoded_subkey, [](const auto& column, const Slice& key) {
+    return column.first.compare(key) < 0;
+  });
+  if (it == columns_.end() || it->first != encoded_subkey) {
+    return columns_.size();
+  }
+  return it - columns_.begin();
+}
+
+Slice PackedRowDecoder::FindValue(const Slice& encoded_subkey) const {
+  auto idx = FindColumn(encoded_subkey);
+  return idx != columns_.size() ? columns_[idx].second : Slice();
+}
+
+std::string PackedRowToString(const Slice& packed_value) {
+  PackedRowDecoder decoder;
+  auto status = decoder.Init(packed_value);
+  if (!status.ok()) {
+    return status.ToString();
+  }
+  std::string result = Format("PACKED_ROW[$0]{ ", decoder.schema_version());
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    if (i != 0) {
+      result += "; ";
+    }
+    Slice encoded_subkey = decoder.encoded_subkey(i);
+    PrimitiveValue subkey;
+    PrimitiveValue value;
+    status = subkey.DecodeFromKey(&encoded_subkey);
+    if (status.ok()) {
+      status = value.DecodeFromValue(decoder.encoded_value(i));
+    }
+    if (!status.ok()) {
+      return result + status.ToString();
+    }
+    result += subkey.ToString() + ": " + value.ToString();
+  }
+  return result + " }";
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,100 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H_
+#define YB_DOCDB_PACKED_ROW_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// A packed row stores all columns of a row in a single RocksDB value attached to the document key,
+// instead of writing one key/value pair per column. Columns updated after the row was packed are
+// still written as regular column subkeys, and overlay the packed value when the row is read.
+//
+// Encoding:
+//   ValueType::kPackedRow
+//   schema version (unsigned varint)
+//   number of columns (unsigned varint)
+//   for each column, in increasing order of encoded subkey:
+//     size of encoded subkey (unsigned varint), subkey encoded as a key (e.g. ColumnId(5))
+//     size of encoded value (unsigned varint), value encoded as by PrimitiveValue::ToValue
+//
+// Subkeys are stored in key encoding, so columns could be located by comparing encoded bytes.
+class RowPacker {
+ public:
+  explicit RowPacker(uint32_t schema_version) : schema_version_(schema_version) {}
+
+  void AddValue(const PrimitiveValue& subkey, const PrimitiveValue& value);
+
+  // Adds column with already encoded subkey and value.
+  void AddEncodedValue(const Slice& encoded_subkey, const Slice& encoded_value);
+
+  size_t num_columns() const { return columns_.size(); }
+
+  // Returns encoded packed row. Packer should not be used after this call.
+  std::string Complete();
+
+ private:
+  const uint32_t schema_version_;
+  std::vector<std::pair<std::string, std::string>> columns_;
+};
+
+// Provides access to columns of the encoded packed row. The decoder references the data of the
+// encoded value, so it should outlive the decoder.
+class PackedRowDecoder {
+ public:
+  // packed_value should start with ValueType::kPackedRow, i.e. control fields are already
+  // consumed.
+  CHECKED_STATUS Init(const Slice& packed_value);
+
+  uint32_t schema_version() const { return schema_version_; }
+
+  size_t num_columns() const { return columns_.size(); }
+
+  const Slice& encoded_subkey(size_t idx) const { return columns_[idx].first; }
+
+  const Slice& encoded_value(size_t idx) const { return columns_[idx].second; }
+
+  // Returns index of the column with the specified encoded subkey, or num_columns() if this column
+  // is not present in the packed row.
+  size_t FindColumn(const Slice& encoded_subkey) const;
+
+  // Returns encoded value of the column with the specified encoded subkey, or empty slice if this
+  // column is not present in the packed row.
+  Slice FindValue(const Slice& encoded_subkey) const;
+
+ private:
+  uint32_t schema_version_ = 0;
+  std::vector<std::pair<Slice, Slice>> columns_;
+};
+
+// Returns true if the value (with control fields already consumed) is a packed row.
+inline bool IsPackedRow(const Slice& value) {
+  return DecodeValueType(value) == ValueType::kPackedRow;
+}
+
+std::string PackedRowToString(const Slice& packed_value);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H_
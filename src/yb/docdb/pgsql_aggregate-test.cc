@@ -0,0 +1,128 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/doc_expr.h"
+#include "yb/docdb/pgsql_aggregate.h"
+
+#include "yb/util/bfpg/tserver_opcodes.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PgsqlAggregateTest : public YBTest {
+ protected:
+  const Schema schema_{{
+      ColumnSchema("k", DataType::INT64, /* is_nullable = */ false),
+      ColumnSchema("i", DataType::INT32, true),
+      ColumnSchema("f", DataType::FLOAT, true),
+      ColumnSchema("d", DataType::DOUBLE, true),
+      ColumnSchema("s", DataType::STRING, true),
+    }, {
+      10_ColId,
+      20_ColId,
+      30_ColId,
+      40_ColId,
+      50_ColId,
+    }, 1};
+};
+
+namespace {
+
+PgsqlExpressionPB MakeAggregate(bfpg::TSOpcode opcode, ColumnIdRep column_id) {
+  PgsqlExpressionPB expr;
+  auto* tscall = expr.mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(opcode));
+  tscall->add_operands()->set_column_id(column_id);
+  return expr;
+}
+
+PgsqlExpressionPB MakeCountRows() {
+  PgsqlExpressionPB expr;
+  auto* tscall = expr.mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  tscall->add_operands()->mutable_value()->set_int64_value(0);
+  return expr;
+}
+
+} // namespace
+
+TEST_F(PgsqlAggregateTest, SameAsExprExecutor) {
+  google::protobuf::RepeatedPtrField<PgsqlExpressionPB> targets;
+  *targets.Add() = MakeCountRows();
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kCount, 20);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kSumInt32, 20);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kMin, 20);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kMax, 20);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kSumFloat, 30);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kSumDouble, 40);
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kSumInt64, 10);
+
+  // Number of rows that is not a multiple of the block size, so the last block is partial.
+  constexpr int kNumRows = PgsqlBatchAggregator::kBlockSize * 3 + 17;
+  for (int num_rows : {0, 1, kNumRows}) {
+    auto aggregator = PgsqlBatchAggregator::Create(targets, schema_);
+    ASSERT_TRUE(aggregator);
+    DocExprExecutor executor;
+    std::vector<QLExprResult> expected(targets.size());
+
+    QLTableRow row;
+    for (int i = 0; i != num_rows; ++i) {
+      row.Clear();
+      row.AllocColumn(10_ColId).value.set_int64_value(i);
+      // Leave some of the columns null or absent.
+      if (i % 7 != 0) {
+        row.AllocColumn(20_ColId).value.set_int32_value(RandomUniformInt(-1000000, 1000000));
+      }
+      if (i % 5 != 0) {
+        row.AllocColumn(30_ColId).value.set_float_value(RandomUniformReal<float>(-100, 100));
+        row.AllocColumn(40_ColId).value.set_double_value(RandomUniformReal<double>(-100, 100));
+      } else {
+        row.AllocColumn(40_ColId);
+      }
+      aggregator->AddRow(row);
+      for (int t = 0; t != targets.size(); ++t) {
+        ASSERT_OK(executor.EvalExpr(targets.Get(t), row, expected[t].Writer()));
+      }
+    }
+
+    std::vector<QLExprResult> actual;
+    ASSERT_OK(aggregator->Complete(&actual));
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t t = 0; t != expected.size(); ++t) {
+      ASSERT_EQ(expected[t].Value().ShortDebugString(), actual[t].Value().ShortDebugString())
+          << "Target: " << targets.Get(t).ShortDebugString() << ", rows: " << num_rows;
+    }
+  }
+}
+
+TEST_F(PgsqlAggregateTest, Unsupported) {
+  google::protobuf::RepeatedPtrField<PgsqlExpressionPB> targets;
+  *targets.Add() = MakeCountRows();
+  ASSERT_TRUE(PgsqlBatchAggregator::Create(targets, schema_));
+
+  // MIN of non integer column.
+  *targets.Add() = MakeAggregate(bfpg::TSOpcode::kMin, 50);
+  ASSERT_FALSE(PgsqlBatchAggregator::Create(targets, schema_));
+
+  // Not an aggregate.
+  targets.RemoveLast();
+  targets.Add()->set_column_id(20);
+  ASSERT_FALSE(PgsqlBatchAggregator::Create(targets, schema_));
+}
+
+}  // namespace docdb
+}  // namespace yb
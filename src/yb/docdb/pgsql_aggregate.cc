@@ -0,0 +1,324 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_aggregate.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/common/ql_value.h"
+
+#include "yb/gutil/macros.h"
+
+#include "yb/util/bfpg/tserver_opcodes.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Reduction loops are kept trivial, so that integer ones are vectorized by the compiler.
+// Floating point sums are accumulated sequentially, to produce exactly the same result as the
+// row by row evaluation.
+template <class T>
+T SumKernel(const std::vector<T>& values, T init) {
+  const T* data = values.data();
+  const size_t size = values.size();
+  for (size_t i = 0; i != size; ++i) {
+    init += data[i];
+  }
+  return init;
+}
+
+int64_t MinKernel(const std::vector<int64_t>& values, int64_t init) {
+  const int64_t* data = values.data();
+  const size_t size = values.size();
+  for (size_t i = 0; i != size; ++i) {
+    init = std::min(init, data[i]);
+  }
+  return init;
+}
+
+int64_t MaxKernel(const std::vector<int64_t>& values, int64_t init) {
+  const int64_t* data = values.data();
+  const size_t size = values.size();
+  for (size_t i = 0; i != size; ++i) {
+    init = std::max(init, data[i]);
+  }
+  return init;
+}
+
+bool IsIntegerType(DataType data_type) {
+  return data_type == DataType::INT8 || data_type == DataType::INT16 ||
+         data_type == DataType::INT32 || data_type == DataType::INT64;
+}
+
+// Extracts integer value from the non null value of integer column.
+int64_t IntValue(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt8Value:
+      return value.int8_value();
+    case QLValuePB::kInt16Value:
+      return value.int16_value();
+    case QLValuePB::kInt32Value:
+      return value.int32_value();
+    case QLValuePB::kInt64Value:
+      return value.int64_value();
+    default:
+      break;
+  }
+  LOG(DFATAL) << "Integer value expected: " << value.ShortDebugString();
+  return 0;
+}
+
+// Negative zero is the neutral element of floating point addition, i.e. x + (-0.0) == x for any x.
+constexpr float kFloatSumNeutral = -0.0f;
+constexpr double kDoubleSumNeutral = -0.0;
+
+} // namespace
+
+std::unique_ptr<PgsqlBatchAggregator> PgsqlBatchAggregator::Create(
+    const google::protobuf::RepeatedPtrField<PgsqlExpressionPB>& targets, const Schema& schema) {
+  std::vector<Target> batch_targets;
+  batch_targets.reserve(targets.size());
+  for (const auto& expr : targets) {
+    if (!AddTarget(expr, schema, &batch_targets)) {
+      return nullptr;
+    }
+  }
+  std::unique_ptr<PgsqlBatchAggregator> result(new PgsqlBatchAggregator());
+  result->targets_ = std::move(batch_targets);
+  for (auto& target : result->targets_) {
+    switch (target.kind) {
+      case AggregateKind::kCountRows: FALLTHROUGH_INTENDED;
+      case AggregateKind::kCountColumn:
+        break;
+      case AggregateKind::kSumInt:
+        target.int_values.reserve(kBlockSize);
+        break;
+      case AggregateKind::kSumFloat:
+        target.float_result = kFloatSumNeutral;
+        target.float_values.reserve(kBlockSize);
+        break;
+      case AggregateKind::kSumDouble:
+        target.double_result = kDoubleSumNeutral;
+        target.double_values.reserve(kBlockSize);
+        break;
+      case AggregateKind::kMinInt:
+        target.int_result = std::numeric_limits<int64_t>::max();
+        target.int_values.reserve(kBlockSize);
+        break;
+      case AggregateKind::kMaxInt:
+        target.int_result = std::numeric_limits<int64_t>::min();
+        target.int_values.reserve(kBlockSize);
+        break;
+    }
+  }
+  return result;
+}
+
+bool PgsqlBatchAggregator::AddTarget(
+    const PgsqlExpressionPB& expr, const Schema& schema, std::vector<Target>* targets) {
+  if (!expr.has_tscall() || expr.tscall().operands_size() != 1) {
+    return false;
+  }
+  const auto& operand = expr.tscall().operands(0);
+  Target target;
+  const auto opcode = static_cast<bfpg::TSOpcode>(expr.tscall().opcode());
+  if (!operand.has_column_id()) {
+    // COUNT(*) is sent as count of a non null constant.
+    if (opcode != bfpg::TSOpcode::kCount || !operand.has_value() ||
+        QLValue::IsNull(operand.value())) {
+      return false;
+    }
+    target.kind = AggregateKind::kCountRows;
+    targets->push_back(std::move(target));
+    return true;
+  }
+
+  if (operand.column_id() < 0) {
+    // System columns, e.g. ybctid, are not stored in the row.
+    return false;
+  }
+  target.column_id = operand.column_id();
+  auto column = schema.column_by_id(ColumnId(target.column_id));
+  if (!column.ok()) {
+    return false;
+  }
+  target.data_type = column->type()->main();
+
+  switch (opcode) {
+    case bfpg::TSOpcode::kCount:
+      target.kind = AggregateKind::kCountColumn;
+      break;
+    case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt64:
+      if (!IsIntegerType(target.data_type)) {
+        return false;
+      }
+      target.kind = AggregateKind::kSumInt;
+      break;
+    case bfpg::TSOpcode::kSumFloat:
+      if (target.data_type != DataType::FLOAT) {
+        return false;
+      }
+      target.kind = AggregateKind::kSumFloat;
+      break;
+    case bfpg::TSOpcode::kSumDouble:
+      if (target.data_type != DataType::DOUBLE) {
+        return false;
+      }
+      target.kind = AggregateKind::kSumDouble;
+      break;
+    case bfpg::TSOpcode::kMin:
+      if (!IsIntegerType(target.data_type)) {
+        return false;
+      }
+      target.kind = AggregateKind::kMinInt;
+      break;
+    case bfpg::TSOpcode::kMax:
+      if (!IsIntegerType(target.data_type)) {
+        return false;
+      }
+      target.kind = AggregateKind::kMaxInt;
+      break;
+    default:
+      return false;
+  }
+  targets->push_back(std::move(target));
+  return true;
+}
+
+void PgsqlBatchAggregator::AddRow(const QLTableRow& table_row) {
+  for (auto& target : targets_) {
+    if (target.kind == AggregateKind::kCountRows) {
+      continue;
+    }
+    const QLValuePB* value = table_row.GetColumn(target.column_id);
+    const bool is_null = value == nullptr || QLValue::IsNull(*value);
+    if (!is_null) {
+      ++target.num_values;
+    }
+    switch (target.kind) {
+      case AggregateKind::kCountRows: FALLTHROUGH_INTENDED;
+      case AggregateKind::kCountColumn:
+        break;
+      case AggregateKind::kSumInt:
+        target.int_values.push_back(is_null ? 0 : IntValue(*value));
+        break;
+      case AggregateKind::kSumFloat:
+        target.float_values.push_back(is_null ? kFloatSumNeutral : value->float_value());
+        break;
+      case AggregateKind::kSumDouble:
+        target.double_values.push_back(is_null ? kDoubleSumNeutral : value->double_value());
+        break;
+      case AggregateKind::kMinInt:
+        target.int_values.push_back(
+            is_null ? std::numeric_limits<int64_t>::max() : IntValue(*value));
+        break;
+      case AggregateKind::kMaxInt:
+        target.int_values.push_back(
+            is_null ? std::numeric_limits<int64_t>::min() : IntValue(*value));
+        break;
+    }
+  }
+  ++num_rows_;
+  if (++num_block_rows_ == kBlockSize) {
+    ReduceBlock();
+  }
+}
+
+void PgsqlBatchAggregator::ReduceBlock() {
+  for (auto& target : targets_) {
+    switch (target.kind) {
+      case AggregateKind::kCountRows: FALLTHROUGH_INTENDED;
+      case AggregateKind::kCountColumn:
+        break;
+      case AggregateKind::kSumInt:
+        target.int_result = SumKernel(target.int_values, target.int_result);
+        break;
+      case AggregateKind::kSumFloat:
+        target.float_result = SumKernel(target.float_values, target.float_result);
+        break;
+      case AggregateKind::kSumDouble:
+        target.double_result = SumKernel(target.double_values, target.double_result);
+        break;
+      case AggregateKind::kMinInt:
+        target.int_result = MinKernel(target.int_values, target.int_result);
+        break;
+      case AggregateKind::kMaxInt:
+        target.int_result = MaxKernel(target.int_values, target.int_result);
+        break;
+    }
+    target.int_values.clear();
+    target.float_values.clear();
+    target.double_values.clear();
+  }
+  num_block_rows_ = 0;
+}
+
+Status PgsqlBatchAggregator::Complete(std::vector<QLExprResult>* results) {
+  ReduceBlock();
+  results->resize(targets_.size());
+  for (size_t i = 0; i != targets_.size(); ++i) {
+    const auto& target = targets_[i];
+    const size_t num_values =
+        target.kind == AggregateKind::kCountRows ? num_rows_ : target.num_values;
+    if (num_values == 0) {
+      continue;
+    }
+    QLValue& value = (*results)[i].Writer().NewValue();
+    switch (target.kind) {
+      case AggregateKind::kCountRows: FALLTHROUGH_INTENDED;
+      case AggregateKind::kCountColumn:
+        value.set_int64_value(num_values);
+        break;
+      case AggregateKind::kSumInt:
+        value.set_int64_value(target.int_result);
+        break;
+      case AggregateKind::kSumFloat:
+        value.set_float_value(target.float_result);
+        break;
+      case AggregateKind::kSumDouble:
+        value.set_double_value(target.double_result);
+        break;
+      case AggregateKind::kMinInt: FALLTHROUGH_INTENDED;
+      case AggregateKind::kMaxInt:
+        switch (target.data_type) {
+          case DataType::INT8:
+            value.set_int8_value(static_cast<int8_t>(target.int_result));
+            break;
+          case DataType::INT16:
+            value.set_int16_value(static_cast<int16_t>(target.int_result));
+            break;
+          case DataType::INT32:
+            value.set_int32_value(static_cast<int32_t>(target.int_result));
+            break;
+          case DataType::INT64:
+            value.set_int64_value(target.int_result);
+            break;
+          default:
+            return STATUS_FORMAT(
+                IllegalState, "Unexpected type of MIN/MAX column $0: $1", target.column_id,
+                DataType_Name(target.data_type));
+        }
+        break;
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
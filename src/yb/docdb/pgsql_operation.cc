@@ -13,7 +13,9 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -31,6 +33,7 @@
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 
 #include "yb/util/flag_tags.h"
@@ -51,6 +54,25 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ysql_enable_packed_row, false,
+            "Whether rows inserted into YSQL tables should be written as a single packed value "
+            "instead of a separate key/value pair per column. Columns updated later are still "
+            "written separately and overlay the packed value on read.");
+TAG_FLAG(ysql_enable_packed_row, experimental);
+TAG_FLAG(ysql_enable_packed_row, runtime);
+
+DEFINE_bool(ysql_enable_batch_aggregate, true,
+            "Whether simple aggregates (COUNT, SUM, MIN, MAX over a column) of YSQL reads should "
+            "be evaluated in batches of rows instead of row by row.");
+TAG_FLAG(ysql_enable_batch_aggregate, advanced);
+TAG_FLAG(ysql_enable_batch_aggregate, runtime);
+
+DEFINE_bool(ysql_batch_ybctid_shared_iterator, true,
+            "Whether rows of a YSQL read request with a batch of ybctids should be looked up in "
+            "key order through a single iterator, instead of creating an iterator per ybctid.");
+TAG_FLAG(ysql_batch_ybctid_shared_iterator, advanced);
+TAG_FLAG(ysql_batch_ybctid_shared_iterator, runtime);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -400,6 +422,16 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     }
   }
 
+  // Upserts and backfill could be applied on top of an existing row, so only plain inserts of a
+  // new row are packed.
+  if (FLAGS_ysql_enable_packed_row && !is_upsert && !request_.is_backfill()) {
+    RETURN_NOT_OK(InsertPackedRow(data, table_row));
+    RETURN_NOT_OK(PopulateResultSet(table_row));
+
+    response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
+    return Status::OK();
+  }
+
   RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
       DocPath(encoded_doc_key_.as_slice(), PrimitiveValue::kLivenessColumn),
       Value(PrimitiveValue()),
@@ -435,6 +467,38 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
   return Status::OK();
 }
 
+Status PgsqlWriteOperation::InsertPackedRow(
+    const DocOperationApplyData& data, const QLTableRow& table_row) {
+  RowPacker packer(request_.schema_version());
+  packer.AddValue(PrimitiveValue::kLivenessColumn, PrimitiveValue());
+
+  for (const auto& column_value : request_.column_values()) {
+    // Get the column.
+    if (!column_value.has_column_id()) {
+      return STATUS(InternalError, "column id missing", column_value.DebugString());
+    }
+    const ColumnId column_id(column_value.column_id());
+    const ColumnSchema& column = VERIFY_RESULT(schema_.column_by_id(column_id));
+
+    // Check column-write operator.
+    CHECK(GetTSWriteInstruction(column_value.expr()) == bfpg::TSOpcode::kScalarInsert)
+      << "Illegal write instruction";
+
+    // Evaluate column value.
+    QLExprResult expr_result;
+    RETURN_NOT_OK(EvalExpr(column_value.expr(), table_row, expr_result.Writer()));
+    const PrimitiveValue value =
+        PrimitiveValue::FromQLValuePB(expr_result.Value(), column.sorting_type());
+
+    // Null columns are just omitted from the packed row.
+    if (value.value_type() != ValueType::kTombstone) {
+      packer.AddValue(PrimitiveValue(column_id), value);
+    }
+  }
+
+  return data.doc_write_batch->SetPackedRow(encoded_doc_key_.as_slice(), packer.Complete());
+}
+
 Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
   QLTableRow table_row;
   RETURN_NOT_OK(ReadColumns(data, &table_row));
@@ -917,6 +981,10 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
 
   VTRACE(1, "Initialized iterator");
 
+  if (request_.is_aggregate() && FLAGS_ysql_enable_batch_aggregate) {
+    batch_aggregator_ = PgsqlBatchAggregator::Create(request_.targets(), schema);
+  }
+
   // Set scan start time.
   bool scan_time_exceeded = false;
 
@@ -992,6 +1060,11 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const common::YQLStorageIf
   Schema projection;
   RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
 
+  if (FLAGS_ysql_batch_ybctid_shared_iterator && request_.batch_arguments_size() > 1) {
+    return ExecuteSortedBatchYbctid(
+        ql_storage, deadline, read_time, schema, projection, result_buffer);
+  }
+
   QLTableRow row;
   size_t row_count = 0;
   for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
@@ -1018,6 +1091,71 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const common::YQLStorageIf
   return row_count;
 }
 
+Result<size_t> PgsqlReadOperation::ExecuteSortedBatchYbctid(
+    const common::YQLStorageIf& ql_storage, CoarseTimePoint deadline,
+    const ReadHybridTime& read_time, const Schema& schema, const Schema& projection,
+    faststring *result_buffer) {
+  const auto& batch_arguments = request_.batch_arguments();
+  auto ybctid = [&batch_arguments](int idx) -> const std::string& {
+    return batch_arguments.Get(idx).ybctid().value().binary_value();
+  };
+  std::vector<int> lookup_order(batch_arguments.size());
+  std::iota(lookup_order.begin(), lookup_order.end(), 0);
+  std::stable_sort(lookup_order.begin(), lookup_order.end(), [&ybctid](int lhs, int rhs) {
+    return ybctid(lhs) < ybctid(rhs);
+  });
+  const bool in_request_order = std::is_sorted(lookup_order.begin(), lookup_order.end());
+
+  RETURN_NOT_OK(ql_storage.GetIterator(
+      request_.stmt_id(), projection, schema, txn_op_context_, deadline, read_time,
+      batch_arguments.Get(lookup_order.front()).ybctid().value(),
+      batch_arguments.Get(lookup_order.back()).ybctid().value(), &table_iter_));
+
+  // Rows are looked up in key order, but should be returned in the order of the request, since
+  // pggate expects batch_orders of a response to be increasing. So when the order differs, rows
+  // are serialized to a temporary buffer first and then copied in the order of the request.
+  constexpr size_t kRowNotFound = std::numeric_limits<size_t>::max();
+  faststring sorted_rows;
+  std::vector<std::pair<size_t, size_t>> row_bounds;
+  if (!in_request_order) {
+    row_bounds.resize(batch_arguments.size(), std::make_pair(kRowNotFound, kRowNotFound));
+  }
+  faststring* row_buffer = in_request_order ? result_buffer : &sorted_rows;
+  QLTableRow row;
+  size_t row_count = 0;
+  for (int idx : lookup_order) {
+    if (!VERIFY_RESULT(table_iter_->SeekTuple(ybctid(idx)))) {
+      continue;
+    }
+    row.Clear();
+    RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+    const size_t row_start = row_buffer->size();
+    RETURN_NOT_OK(PopulateResultSet(row, row_buffer));
+    if (in_request_order) {
+      response_.add_batch_orders(batch_arguments.Get(idx).order());
+    } else {
+      row_bounds[idx] = std::make_pair(row_start, row_buffer->size());
+    }
+    ++row_count;
+  }
+
+  if (!in_request_order) {
+    for (int idx = 0; idx != batch_arguments.size(); ++idx) {
+      const auto& bounds = row_bounds[idx];
+      if (bounds.first == kRowNotFound) {
+        continue;
+      }
+      result_buffer->append(sorted_rows.data() + bounds.first, bounds.second - bounds.first);
+      response_.add_batch_orders(batch_arguments.Get(idx).order());
+    }
+  }
+
+  // Mark all rows were processed even in case some of the ybctids were not found.
+  response_.set_batch_arg_count(batch_arguments.size());
+
+  return row_count;
+}
+
 Status PgsqlReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIteratorIf* iter,
                                                      size_t fetched_rows,
                                                      const size_t row_count_limit,
@@ -1087,6 +1225,11 @@ Status PgsqlReadOperation::GetTupleId(QLValue *result) const {
 }
 
 Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
+  if (batch_aggregator_) {
+    batch_aggregator_->AddRow(table_row);
+    return Status::OK();
+  }
+
   if (aggr_result_.empty()) {
     int column_count = request_.targets().size();
     aggr_result_.resize(column_count);
@@ -1101,6 +1244,10 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
 
 Status PgsqlReadOperation::PopulateAggregate(const QLTableRow& table_row,
                                              faststring *result_buffer) {
+  if (batch_aggregator_) {
+    RETURN_NOT_OK(batch_aggregator_->Complete(&aggr_result_));
+  }
+
   int column_count = request_.targets().size();
   for (int rscol_index = 0; rscol_index < column_count; rscol_index++) {
     RETURN_NOT_OK(pggate::WriteColumn(aggr_result_[rscol_index].Value(), result_buffer));
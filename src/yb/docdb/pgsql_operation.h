@@ -20,6 +20,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/pgsql_aggregate.h"
 
 namespace yb {
 
@@ -91,6 +92,9 @@ class PgsqlWriteOperation :
   CHECKED_STATUS ApplyDelete(const DocOperationApplyData& data, const bool is_persist_needed);
   CHECKED_STATUS ApplyTruncateColocated(const DocOperationApplyData& data);
 
+  // Writes all columns of the inserted row as a single packed value.
+  CHECKED_STATUS InsertPackedRow(const DocOperationApplyData& data, const QLTableRow& table_row);
+
   CHECKED_STATUS DeleteRow(const DocPath& row_path, DocWriteBatch* doc_write_batch,
                            const ReadHybridTime& read_ht, CoarseTimePoint deadline);
 
@@ -180,6 +184,15 @@ class PgsqlReadOperation : public DocExprExecutor {
                                     faststring *result_buffer,
                                     HybridTime *restart_read_ht);
 
+  // Execute a READ operator for a given batch of ybctids, looking them up in key order through a
+  // single iterator.
+  Result<size_t> ExecuteSortedBatchYbctid(const common::YQLStorageIf& ql_storage,
+                                          CoarseTimePoint deadline,
+                                          const ReadHybridTime& read_time,
+                                          const Schema& schema,
+                                          const Schema& projection,
+                                          faststring *result_buffer);
+
   Result<size_t> ExecuteSample(const common::YQLStorageIf& ql_storage,
                                CoarseTimePoint deadline,
                                const ReadHybridTime& read_time,
@@ -213,6 +226,9 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   common::YQLRowwiseIteratorIf::UniPtr table_iter_;
   common::YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Evaluates aggregate targets in batches, when all of them are supported by it.
+  std::unique_ptr<PgsqlBatchAggregator> batch_aggregator_;
 };
 
 }  // namespace docdb
@@ -57,6 +57,7 @@ using yb::util::DecodeDoubleFromKey;
     case ValueType::kArray: FALLTHROUGH_INTENDED; \
     case ValueType::kBitSet: FALLTHROUGH_INTENDED; \
     case ValueType::kExternalIntents: FALLTHROUGH_INTENDED; \
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED; \
     case ValueType::kGreaterThanIntentType: FALLTHROUGH_INTENDED; \
     case ValueType::kGroupEnd: FALLTHROUGH_INTENDED; \
     case ValueType::kGroupEndDescending: FALLTHROUGH_INTENDED; \
@@ -255,6 +256,8 @@ string PrimitiveValue::ToString(AutoDecodeKeys auto_decode_keys) const {
       return Format("ObsoleteIntents($0)", uint16_val_);
     case ValueType::kObsoleteIntentType:
       return Format("Intent($0)", uint16_val_);
+    case ValueType::kPackedRow:
+      return "PackedRow";
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED;
     case ValueType::kRowLock: FALLTHROUGH_INTENDED;
     case ValueType::kBitSet: FALLTHROUGH_INTENDED;
@@ -619,6 +622,7 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kSystemColumnId: FALLTHROUGH_INTENDED;
     case ValueType::kHybridTime: FALLTHROUGH_INTENDED;
     case ValueType::kExternalIntents: FALLTHROUGH_INTENDED;
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kInvalid: FALLTHROUGH_INTENDED;
     case ValueType::kLowest: FALLTHROUGH_INTENDED;
     case ValueType::kHighest: FALLTHROUGH_INTENDED;
@@ -1065,6 +1069,9 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kRedisSet: FALLTHROUGH_INTENDED;
     case ValueType::kRedisTS: FALLTHROUGH_INTENDED;
     case ValueType::kRedisSortedSet: FALLTHROUGH_INTENDED;
+    // Only the type of a packed row is decoded here, its columns are accessed through
+    // PackedRowDecoder on the encoded value.
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kTombstone:
       type_ = value_type;
       complex_data_structure_ = nullptr;
@@ -139,6 +139,27 @@ Status QLRocksDBStorage::GetIterator(uint64 stmt_id,
   return Status::OK();
 }
 
+Status QLRocksDBStorage::GetIterator(uint64 stmt_id,
+                                     const Schema& projection,
+                                     const Schema& schema,
+                                     const TransactionOperationContextOpt& txn_op_context,
+                                     CoarseTimePoint deadline,
+                                     const ReadHybridTime& read_time,
+                                     const QLValuePB& min_ybctid,
+                                     const QLValuePB& max_ybctid,
+                                     common::YQLRowwiseIteratorIf::UniPtr* iter) const {
+  DocKey lower_doc_key(schema);
+  RETURN_NOT_OK(lower_doc_key.DecodeFrom(min_ybctid.binary_value()));
+  DocKey upper_doc_key(schema);
+  RETURN_NOT_OK(upper_doc_key.DecodeFrom(max_ybctid.binary_value()));
+  auto doc_iter = std::make_unique<DocRowwiseIterator>(
+      projection, schema, txn_op_context, doc_db_, deadline, read_time);
+  RETURN_NOT_OK(doc_iter->InitForTupleLookups(
+      lower_doc_key.Encode(), upper_doc_key.Encode(), stmt_id));
+  *iter = std::move(doc_iter);
+  return Status::OK();
+}
+
 Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
                                      const Schema& projection,
                                      const Schema& schema,
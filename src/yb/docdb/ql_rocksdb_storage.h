@@ -82,6 +82,16 @@ class QLRocksDBStorage : public common::YQLStorageIf {
                              const QLValuePB& ybctid,
                              common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
 
+  CHECKED_STATUS GetIterator(uint64 stmt_id,
+                             const Schema& projection,
+                             const Schema& schema,
+                             const TransactionOperationContextOpt& txn_op_context,
+                             CoarseTimePoint deadline,
+                             const ReadHybridTime& read_time,
+                             const QLValuePB& min_ybctid,
+                             const QLValuePB& max_ybctid,
+                             common::YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
  private:
   const DocDB doc_db_;
 };
@@ -15,6 +15,7 @@
 #include <future>
 #include <mutex>
 #include <random>
+#include <set>
 #include <stack>
 #include <thread>
 
@@ -121,6 +122,31 @@ TEST_F(SharedLockManagerTest, LockBatchReset) {
   EXPECT_TRUE(lb.empty());
 }
 
+TEST_F(SharedLockManagerTest, LockBatchUnlockRelock) {
+  LockBatch lb = TestLockBatch();
+  lb.Unlock();
+  EXPECT_TRUE(lb.empty());
+
+  // Keys of the unlocked batch could be locked by another batch.
+  {
+    LockBatch lb2 = TestLockBatch(CoarseMonoClock::now() + 10ms);
+    ASSERT_OK(lb2.status());
+    EXPECT_EQ(2, lb2.size());
+
+    ASSERT_NOK(lb.Relock(CoarseMonoClock::now() + 10ms));
+    EXPECT_TRUE(lb.empty());
+  }
+
+  lb = TestLockBatch();
+  lb.Unlock();
+  ASSERT_OK(lb.Relock(CoarseMonoClock::now() + 10ms));
+  EXPECT_EQ(2, lb.size());
+  EXPECT_FALSE(lb.empty());
+
+  LockBatch lb_fail = TestLockBatch(CoarseMonoClock::now() + 10ms);
+  ASSERT_FALSE(lb_fail.status().ok());
+}
+
 // Launch pairs of threads. Each pair tries to lock/unlock on the same key sequence.
 // This catches bug in SharedLockManager when condition is waited incorrectly.
 TEST_F(SharedLockManagerTest, QuickLockUnlock) {
@@ -160,6 +186,155 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Simple benchmark of lock table contention. Threads lock batches of weak and strong write
+// intents, like single row writes of the same tablet do.
+TEST_F(SharedLockManagerTest, BenchmarkContention) {
+  constexpr size_t kThreads = 64;
+  constexpr size_t kKeysPerBatch = 4;
+  constexpr size_t kNumKeys = 100000;
+  const auto kDuration = AllowSlowTests() ? 30s : 3s;
+
+  std::vector<RefCntPrefix> keys;
+  keys.reserve(kNumKeys);
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    keys.emplace_back(Format("key_$0", i));
+  }
+  const RefCntPrefix kTableKey("table"s);
+
+  std::atomic<bool> stop_requested{false};
+  std::atomic<size_t> num_batches{0};
+  std::vector<std::thread> threads;
+  while (threads.size() != kThreads) {
+    threads.emplace_back([this, &stop_requested, &num_batches, &keys, &kTableKey] {
+      std::mt19937_64 rng(std::hash<std::thread::id>()(std::this_thread::get_id()));
+      std::uniform_int_distribution<size_t> key_distribution(0, keys.size() - 1);
+      size_t local_batches = 0;
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        // Keys are locked in the same order by all threads, as it is done for real writes.
+        std::set<size_t> key_indexes;
+        while (key_indexes.size() != kKeysPerBatch) {
+          key_indexes.insert(key_distribution(rng));
+        }
+        LockBatchEntries entries;
+        entries.push_back({kTableKey, IntentTypeSet({IntentType::kWeakWrite})});
+        for (auto idx : key_indexes) {
+          entries.push_back({keys[idx], IntentTypeSet({IntentType::kStrongWrite})});
+        }
+        LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+        ++local_batches;
+      }
+      num_batches.fetch_add(local_batches, std::memory_order_acq_rel);
+    });
+  }
+
+  std::this_thread::sleep_for(kDuration);
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto batches = num_batches.load(std::memory_order_acquire);
+  LOG(INFO) << "Locked " << batches << " batches, "
+            << batches * 1.0 / std::chrono::duration<double>(kDuration).count()
+            << " batches per second";
+  ASSERT_GT(batches, 0);
+}
+
+// Threads lock random batches of keys with strong write or strong read intents, and check that
+// lock holders don't violate exclusion. Keys of a batch belong to different shards of the lock
+// table, and shards are visited in different order by different batches.
+TEST_F(SharedLockManagerTest, MultiKeyExclusion) {
+  constexpr size_t kThreads = 16;
+  constexpr size_t kKeysPerBatch = 4;
+  constexpr size_t kNumKeys = 64;
+  const auto kDuration = AllowSlowTests() ? 30s : 3s;
+
+  struct KeyState {
+    std::atomic<int> readers{0};
+    std::atomic<int> writers{0};
+    // Modified only while strong write lock is held.
+    size_t writes = 0;
+  };
+
+  std::vector<RefCntPrefix> keys;
+  std::vector<KeyState> key_states(kNumKeys);
+  keys.reserve(kNumKeys);
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    keys.emplace_back(Format("key_$0", i));
+  }
+
+  std::atomic<bool> stop_requested{false};
+  std::atomic<size_t> num_writes{0};
+  std::atomic<size_t> num_violations{0};
+  std::vector<std::thread> threads;
+  while (threads.size() != kThreads) {
+    threads.emplace_back([this, &stop_requested, &num_writes, &num_violations, &keys,
+                          &key_states] {
+      std::mt19937_64 rng(std::hash<std::thread::id>()(std::this_thread::get_id()));
+      std::uniform_int_distribution<size_t> key_distribution(0, keys.size() - 1);
+      size_t local_writes = 0;
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        std::set<size_t> key_indexes;
+        while (key_indexes.size() != kKeysPerBatch) {
+          key_indexes.insert(key_distribution(rng));
+        }
+        const bool write = rng() % 2 == 0;
+        const IntentTypeSet intent_types(
+            {write ? IntentType::kStrongWrite : IntentType::kStrongRead});
+        LockBatchEntries entries;
+        for (auto idx : key_indexes) {
+          entries.push_back({keys[idx], intent_types});
+        }
+        LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+
+        for (auto idx : key_indexes) {
+          auto& state = key_states[idx];
+          if (write) {
+            if (state.writers.fetch_add(1, std::memory_order_acq_rel) != 0 ||
+                state.readers.load(std::memory_order_acquire) != 0) {
+              num_violations.fetch_add(1, std::memory_order_acq_rel);
+            }
+            ++state.writes;
+            ++local_writes;
+          } else {
+            state.readers.fetch_add(1, std::memory_order_acq_rel);
+            if (state.writers.load(std::memory_order_acquire) != 0) {
+              num_violations.fetch_add(1, std::memory_order_acq_rel);
+            }
+          }
+        }
+        std::this_thread::yield();
+        for (auto idx : key_indexes) {
+          auto& state = key_states[idx];
+          if (write) {
+            state.writers.fetch_sub(1, std::memory_order_acq_rel);
+          } else {
+            state.readers.fetch_sub(1, std::memory_order_acq_rel);
+          }
+        }
+      }
+      num_writes.fetch_add(local_writes, std::memory_order_acq_rel);
+    });
+  }
+
+  std::this_thread::sleep_for(kDuration);
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(num_violations.load(std::memory_order_acquire), 0U);
+  size_t total_writes = 0;
+  for (const auto& state : key_states) {
+    total_writes += state.writes;
+  }
+  // Lost updates would mean that two writers held the same key at the same time.
+  ASSERT_EQ(total_writes, num_writes.load(std::memory_order_acquire));
+  ASSERT_GT(total_writes, 0U);
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{"test_pool"s, 10, 1});
 
@@ -13,11 +13,14 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <array>
 #include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -107,8 +110,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the lock table shard,
+  // that contains this entry, is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -134,28 +137,56 @@ class SharedLockManager::Impl {
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Lock table is split into shards by key hash, so batches locking unrelated keys of the same
+  // tablet don't contend on a single mutex.
+  // Aligned to cache line to avoid false sharing between mutexes of neighbouring shards.
+  struct LockTableShard {
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  } CACHELINE_ALIGNED;
+
+  static constexpr size_t kNumShards = 32;
+
+  LockTableShard& ShardForKey(const RefCntPrefix& key) {
+    auto hash = RefCntPrefixHash()(key);
+    // Lower bits are also used by the shard map to select bucket, so mix in higher ones.
+    return shards_[(hash ^ (hash >> 32)) % kNumShards];
+  }
+
+  // Make sure the entries exist in the lock table and return pointers so we can access
+  // them without holding the shard lock. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  // Releases mutex of the current shard, if any, and only then locks mutex of the new shard.
+  static void SwitchShard(
+      LockTableShard* new_shard, LockTableShard** shard, std::unique_lock<std::mutex>* lock) {
+    if (lock->owns_lock()) {
+      lock->unlock();
+    }
+    *shard = new_shard;
+    *lock = std::unique_lock<std::mutex>(new_shard->mutex);
+  }
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<LockTableShard, kNumShards> shards_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -274,16 +305,23 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  // Only one shard mutex is held at a time, but it is kept while consecutive keys belong to the
+  // same shard. So shard mutexes could be taken in any order without deadlock.
+  LockTableShard* shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& key_shard = ShardForKey(key_and_intent_type.key);
+    if (&key_shard != shard) {
+      SwitchShard(&key_shard, &shard, &lock);
+    }
+    auto& value = shard->locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard->free_lock_entries.empty()) {
+        value = shard->free_lock_entries.back();
+        shard->free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard->lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard->lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -302,11 +340,16 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  LockTableShard* shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (const auto& item : key_to_intent_type) {
+    auto& key_shard = ShardForKey(item.key);
+    if (&key_shard != shard) {
+      SwitchShard(&key_shard, &shard, &lock);
+    }
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard->locks.erase(item.key);
+      shard->free_lock_entries.push_back(item.locked);
     }
   }
 }
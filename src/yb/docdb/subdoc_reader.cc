@@ -29,6 +29,7 @@
 #include "yb/docdb/expiration.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -225,7 +226,9 @@ Result<SubDocument*> LazySubDocumentHolder::Get() {
 // This class provides a wrapper to access data corresponding to a RocksDB row.
 class DocDbRowData {
  public:
-  DocDbRowData(const Slice& key, const DocHybridTime& write_time, Value&& value);
+  DocDbRowData(
+      const Slice& key, const DocHybridTime& write_time, Value&& value,
+      std::string packed_row = std::string());
 
   static Result<std::unique_ptr<DocDbRowData>> CurrentRow(IntentAwareIterator* iter);
 
@@ -241,19 +244,26 @@ class DocDbRowData {
 
   bool IsPrimitiveValue() const { return IsPrimitiveValueType(value_.value_type()); }
 
+  bool IsPackedRow() const { return value_.value_type() == ValueType::kPackedRow; }
+
   PrimitiveValue* mutable_primitive_value() { return value_.mutable_primitive_value(); }
 
+  const std::string& packed_row() const { return packed_row_; }
+
  private:
   const KeyBytes target_key_;
   const DocHybridTime write_time_;
   Value value_;
+  // Encoded packed row without control fields, when value_ is a packed row.
+  const std::string packed_row_;
 
   DISALLOW_COPY_AND_ASSIGN(DocDbRowData);
 };
 
 DocDbRowData::DocDbRowData(
-    const Slice& key, const DocHybridTime& write_time, Value&& value):
-    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)) {}
+    const Slice& key, const DocHybridTime& write_time, Value&& value, std::string packed_row):
+    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)),
+    packed_row_(std::move(packed_row)) {}
 
 Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterator* iter) {
   auto key_data = VERIFY_RESULT(iter->FetchKey());
@@ -272,7 +282,17 @@ Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterat
     return STATUS(Corruption, "No hybrid timestamp found on entry");
   }
 
-  return std::make_unique<DocDbRowData>(key_data.key, key_data.write_time, std::move(value));
+  std::string packed_row;
+  if (value.value_type() == ValueType::kPackedRow) {
+    // Only the type of the packed row is decoded into value, keep the encoded columns around.
+    Slice packed_value = iter->value();
+    Value control_fields;
+    RETURN_NOT_OK(control_fields.DecodeControlFields(&packed_value));
+    packed_row = packed_value.ToBuffer();
+  }
+
+  return std::make_unique<DocDbRowData>(
+      key_data.key, key_data.write_time, std::move(value), std::move(packed_row));
 }
 
 // This class provides a convenience handle for modifying a SubDocument specified by a provided
@@ -293,6 +313,9 @@ class DocDbRowAssembler {
 
   CHECKED_STATUS SetPrimitiveValue(DocDbRowData* row);
 
+  // Sets a child of the collection stored by this assembler to the provided primitive value.
+  CHECKED_STATUS SetChildPrimitiveValue(const PrimitiveValue& subkey, PrimitiveValue value);
+
   Result<bool> HasStoredValue();
 
  private:
@@ -340,6 +363,13 @@ Status DocDbRowAssembler::SetPrimitiveValue(DocDbRowData* row) {
   return Status::OK();
 }
 
+Status DocDbRowAssembler::SetChildPrimitiveValue(
+    const PrimitiveValue& subkey, PrimitiveValue value) {
+  auto* subdoc = VERIFY_RESULT(root_.Get());
+  subdoc->SetChildPrimitive(subkey, std::move(value));
+  return Status::OK();
+}
+
 Result<bool> DocDbRowAssembler::HasStoredValue() {
   if (!root_.IsConstructed()) {
     return false;
@@ -584,6 +614,48 @@ Status ProcessCollection(ScopedDocDbRowContextWithData* scope) {
   return Status::OK();
 }
 
+// A packed row is processed as a collection whose children are stored in the packed value. Children
+// written as separate records after the row was packed take precedence over the packed values.
+Status ProcessPackedRow(ScopedDocDbRowContextWithData* scope) {
+  auto data = scope->data();
+  auto assembler = scope->mutable_assembler();
+  RETURN_NOT_OK(assembler->SetEmptyCollection());
+
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(data->packed_row()));
+  std::vector<bool> overlaid(decoder.num_columns());
+  const auto packed_key_size = data->key().size();
+
+  auto collection = scope->collection();
+  while (ScopedDocDbRowContextWithData* child = VERIFY_RESULT(collection->GetNextChild())) {
+    RETURN_NOT_OK(ProcessSubDocument(child));
+    if (child->obsolescence_tracker()->IsObsolete(child->data()->write_time())) {
+      continue;
+    }
+    Slice child_subkey = child->data()->key().AsSlice();
+    child_subkey.remove_prefix(packed_key_size);
+    auto idx = decoder.FindColumn(child_subkey);
+    if (idx != decoder.num_columns()) {
+      overlaid[idx] = true;
+    }
+  }
+
+  const auto write_time_micros = data->write_time().hybrid_time().GetPhysicalValueMicros();
+  for (size_t idx = 0; idx != decoder.num_columns(); ++idx) {
+    if (overlaid[idx]) {
+      continue;
+    }
+    Slice encoded_subkey = decoder.encoded_subkey(idx);
+    PrimitiveValue subkey;
+    RETURN_NOT_OK(subkey.DecodeFromKey(&encoded_subkey));
+    PrimitiveValue value;
+    RETURN_NOT_OK(value.DecodeFromValue(decoder.encoded_value(idx)));
+    value.SetWriteTime(write_time_micros);
+    RETURN_NOT_OK(assembler->SetChildPrimitiveValue(subkey, std::move(value)));
+  }
+  return Status::OK();
+}
+
 Status MaybeReviveCollection(ScopedDocDbRowContextWithData* scope) {
   auto num_children = VERIFY_RESULT(ProcessChildren(scope->collection()));
   if (num_children == 0) {
@@ -614,6 +686,10 @@ Status ProcessSubDocument(ScopedDocDbRowContextWithData* scope) {
     return ProcessCollection(scope);
   }
 
+  if (data->IsPackedRow()) {
+    return ProcessPackedRow(scope);
+  }
+
   if (data->IsPrimitiveValue()) {
     auto ttl_opt = obsolescence_tracker->GetTtlRemainingSeconds(data->write_time().hybrid_time());
     if (ttl_opt) {
@@ -681,6 +757,8 @@ Status SubDocumentReaderBuilder::InitObsolescenceInfo(
     const ObsolescenceTracker& table_obsolescence_tracker,
     const Slice& root_doc_key, const Slice& target_subdocument_key) {
   parent_obsolescence_tracker_ = table_obsolescence_tracker;
+  packed_row_.clear();
+  packed_row_write_time_ = DocHybridTime::kInvalid;
 
   // Look at ancestors to collect ttl/write-time metadata.
   IntentAwareIteratorPrefixScope prefix_scope(root_doc_key, iter_);
@@ -712,6 +790,15 @@ Status SubDocumentReaderBuilder::UpdateWithParentWriteInfo(
     return Status::OK();
   }
 
+  if (!value.empty()) {
+    Value control_fields;
+    RETURN_NOT_OK(control_fields.DecodeControlFields(&value));
+    if (IsPackedRow(value) && !parent_obsolescence_tracker_.IsObsolete(doc_ht)) {
+      packed_row_.assign(value.cdata(), value.size());
+      packed_row_write_time_ = doc_ht;
+    }
+  }
+
   parent_obsolescence_tracker_ = parent_obsolescence_tracker_.Child(doc_ht);
   return Status::OK();
 }
@@ -124,12 +124,20 @@ class SubDocumentReaderBuilder {
   // without explicit seeking to sub_doc_key by the caller is not supported.
   Result<std::unique_ptr<SubDocumentReader>> Build(const KeyBytes& sub_doc_key);
 
+  // Packed row (see packed_row.h) found as the latest live value of the document root by the last
+  // InitObsolescenceInfo call, or empty string if there is no such row.
+  const std::string& packed_row() const { return packed_row_; }
+
+  const DocHybridTime& packed_row_write_time() const { return packed_row_write_time_; }
+
  private:
   CHECKED_STATUS UpdateWithParentWriteInfo(const Slice& parent_key_without_ht);
 
   IntentAwareIterator* iter_;
   DeadlineInfo* deadline_info_;
   ObsolescenceTracker parent_obsolescence_tracker_;
+  std::string packed_row_;
+  DocHybridTime packed_row_write_time_ = DocHybridTime::kInvalid;
 };
 
 }  // namespace docdb
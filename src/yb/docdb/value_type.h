@@ -131,6 +131,8 @@ namespace docdb {
     ((kRowLock, 'l'))  /* ASCII code 108 */ \
     ((kBitSet, 'm')) /* ASCII code 109 */ \
     ((kSubTransactionId, 'n')) /* ASCII code 110 */ \
+    /* All non-key columns of a row packed into a single value, see packed_row.h. */ \
+    ((kPackedRow, 'p')) /* ASCII code 112 */ \
     /* Timestamp value in microseconds */ \
     ((kTimestamp, 's'))  /* ASCII code 115 */ \
     /* TTL value in milliseconds, optionally present at the start of a value. */ \
@@ -226,7 +228,7 @@ constexpr inline bool IsCollectionType(const ValueType value_type) {
 constexpr inline bool IsPrimitiveValueType(const ValueType value_type) {
   return (kMinPrimitiveValueType <= value_type && value_type <= kMaxPrimitiveValueType &&
           !IsCollectionType(value_type) &&
-          value_type != ValueType::kTombstone) ||
+          value_type != ValueType::kTombstone && value_type != ValueType::kPackedRow) ||
          value_type == ValueType::kTransactionApplyState ||
          value_type == ValueType::kExternalTransactionId;
 }
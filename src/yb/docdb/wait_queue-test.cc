@@ -0,0 +1,138 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+
+#include <boost/optional.hpp>
+
+#include "yb/docdb/wait_queue.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace docdb {
+
+class WaitQueueTest : public YBTest {
+ protected:
+  // Returns callback that stores its status to the specified location.
+  StdStatusCallback StoreStatus(boost::optional<Status>* out) {
+    return [out](const Status& status) {
+      *out = status;
+    };
+  }
+
+  WaitQueue wait_queue_;
+};
+
+TEST_F(WaitQueueTest, WakeUpOnFinish) {
+  auto waiter = TransactionId::GenerateRandom();
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+
+  boost::optional<Status> result;
+  ASSERT_TRUE(wait_queue_.Wait(
+      waiter, {blocker1, blocker2}, CoarseTimePoint::max(), StoreStatus(&result)));
+  ASSERT_TRUE(wait_queue_.HasWaiters());
+
+  wait_queue_.TransactionFinished(TransactionId::GenerateRandom());
+  ASSERT_FALSE(result);
+
+  wait_queue_.TransactionFinished(blocker2);
+  ASSERT_TRUE(result);
+  ASSERT_OK(*result);
+  ASSERT_FALSE(wait_queue_.HasWaiters());
+}
+
+TEST_F(WaitQueueTest, Timeout) {
+  auto waiter = TransactionId::GenerateRandom();
+  auto blocker = TransactionId::GenerateRandom();
+
+  boost::optional<Status> result;
+  auto deadline = CoarseMonoClock::now() + 1s;
+  ASSERT_TRUE(wait_queue_.Wait(waiter, {blocker}, deadline, StoreStatus(&result)));
+
+  wait_queue_.Poll(deadline - 1ms);
+  ASSERT_FALSE(result);
+
+  wait_queue_.Poll(deadline);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(result->IsTimedOut()) << *result;
+  ASSERT_FALSE(wait_queue_.HasWaiters());
+}
+
+TEST_F(WaitQueueTest, LocalDeadlock) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  auto txn3 = TransactionId::GenerateRandom();
+
+  boost::optional<Status> result1;
+  boost::optional<Status> result2;
+  ASSERT_TRUE(wait_queue_.Wait(txn1, {txn2}, CoarseTimePoint::max(), StoreStatus(&result1)));
+  ASSERT_TRUE(wait_queue_.Wait(txn2, {txn3}, CoarseTimePoint::max(), StoreStatus(&result2)));
+
+  // txn3 -> txn1 -> txn2 -> txn3 is a cycle.
+  boost::optional<Status> result3;
+  ASSERT_FALSE(wait_queue_.Wait(txn3, {txn1}, CoarseTimePoint::max(), StoreStatus(&result3)));
+  ASSERT_FALSE(result3);
+
+  // Finish of txn3 wakes up txn2, so there is no cycle anymore and txn3 could wait for txn1.
+  wait_queue_.TransactionFinished(txn3);
+  ASSERT_TRUE(result2);
+  ASSERT_FALSE(result1);
+  ASSERT_TRUE(wait_queue_.Wait(txn3, {txn1}, CoarseTimePoint::max(), StoreStatus(&result3)));
+
+  wait_queue_.Shutdown(STATUS(Aborted, "Test shutdown"));
+  ASSERT_TRUE(result1);
+  ASSERT_TRUE(result1->IsAborted()) << *result1;
+  ASSERT_TRUE(result3);
+  ASSERT_TRUE(result3->IsAborted()) << *result3;
+}
+
+TEST_F(WaitQueueTest, DeadlocksDetected) {
+  auto waiter1 = TransactionId::GenerateRandom();
+  auto waiter2 = TransactionId::GenerateRandom();
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+
+  boost::optional<Status> result1;
+  boost::optional<Status> result2;
+  ASSERT_TRUE(wait_queue_.Wait(
+      waiter1, {blocker1, blocker2}, CoarseTimePoint::max(), StoreStatus(&result1)));
+  ASSERT_TRUE(wait_queue_.Wait(waiter2, {blocker2}, CoarseTimePoint::max(), StoreStatus(&result2)));
+
+  WaitForEdges edges;
+  wait_queue_.FillWaitForEdges(&edges);
+  std::sort(edges.begin(), edges.end());
+  WaitForEdges expected_edges = {{waiter1, blocker1}, {waiter1, blocker2}, {waiter2, blocker2}};
+  std::sort(expected_edges.begin(), expected_edges.end());
+  ASSERT_EQ(edges, expected_edges);
+
+  wait_queue_.DeadlocksDetected({waiter1});
+  ASSERT_TRUE(result1);
+  ASSERT_TRUE(result1->IsTryAgain()) << *result1;
+  ASSERT_FALSE(result2);
+
+  edges.clear();
+  wait_queue_.FillWaitForEdges(&edges);
+  ASSERT_EQ(edges, WaitForEdges({{waiter2, blocker2}}));
+
+  wait_queue_.TransactionFinished(blocker2);
+  ASSERT_TRUE(result2);
+  ASSERT_OK(*result2);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,156 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/wait_queue.h"
+
+#include <algorithm>
+
+#include "yb/common/transaction_error.h"
+
+#include "yb/util/logging.h"
+
+namespace yb {
+namespace docdb {
+
+WaitQueue::~WaitQueue() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_IF(DFATAL, !waiters_.empty()) << "Wait queue not empty in dtor: " << waiters_.size();
+}
+
+bool WaitQueue::Wait(const TransactionId& waiter,
+                     const std::vector<TransactionId>& blockers,
+                     CoarseTimePoint deadline,
+                     StdStatusCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (WouldDeadlockLocallyUnlocked(waiter, blockers)) {
+    VLOG(2) << "Local deadlock detected, waiter: " << waiter << ", blockers: "
+            << AsString(blockers);
+    return false;
+  }
+  VLOG(4) << "Wait, waiter: " << waiter << ", blockers: " << AsString(blockers);
+  waiters_.emplace(waiter, Waiter{blockers, deadline, std::move(callback)});
+  WaitersModifiedUnlocked();
+  return true;
+}
+
+bool WaitQueue::WouldDeadlockLocallyUnlocked(
+    const TransactionId& waiter, const std::vector<TransactionId>& blockers) {
+  TransactionIdSet visited;
+  std::vector<TransactionId> queue(blockers.begin(), blockers.end());
+  while (!queue.empty()) {
+    auto id = queue.back();
+    queue.pop_back();
+    if (id == waiter) {
+      return true;
+    }
+    if (!visited.insert(id).second) {
+      continue;
+    }
+    auto range = waiters_.equal_range(id);
+    for (auto it = range.first; it != range.second; ++it) {
+      queue.insert(queue.end(), it->second.blockers.begin(), it->second.blockers.end());
+    }
+  }
+  return false;
+}
+
+void WaitQueue::TransactionFinished(const TransactionId& id) {
+  std::vector<StdStatusCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The finished transaction could not be waiting anymore.
+    for (auto it = waiters_.begin(); it != waiters_.end();) {
+      const auto& blockers = it->second.blockers;
+      if (it->first == id ||
+          std::find(blockers.begin(), blockers.end(), id) != blockers.end()) {
+        callbacks.push_back(std::move(it->second.callback));
+        it = waiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    WaitersModifiedUnlocked();
+  }
+  for (const auto& callback : callbacks) {
+    callback(Status::OK());
+  }
+}
+
+void WaitQueue::Poll(CoarseTimePoint now) {
+  std::vector<StdStatusCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = waiters_.begin(); it != waiters_.end();) {
+      if (it->second.deadline <= now) {
+        callbacks.push_back(std::move(it->second.callback));
+        it = waiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    WaitersModifiedUnlocked();
+  }
+  for (const auto& callback : callbacks) {
+    callback(STATUS(TimedOut, "Wait for conflicting transactions timed out"));
+  }
+}
+
+void WaitQueue::Shutdown(const Status& status) {
+  Waiters waiters;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiters.swap(waiters_);
+    WaitersModifiedUnlocked();
+  }
+  for (const auto& waiter : waiters) {
+    waiter.second.callback(status);
+  }
+}
+
+void WaitQueue::FillWaitForEdges(WaitForEdges* edges) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& waiter : waiters_) {
+    for (const auto& blocker : waiter.second.blockers) {
+      edges->emplace_back(waiter.first, blocker);
+    }
+  }
+}
+
+void WaitQueue::DeadlocksDetected(const TransactionIdSet& waiters) {
+  std::vector<std::pair<TransactionId, StdStatusCallback>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& id : waiters) {
+      auto range = waiters_.equal_range(id);
+      for (auto it = range.first; it != range.second; ++it) {
+        callbacks.emplace_back(id, std::move(it->second.callback));
+      }
+      waiters_.erase(range.first, range.second);
+    }
+    WaitersModifiedUnlocked();
+  }
+  for (const auto& id_and_callback : callbacks) {
+    VLOG(2) << "Deadlock detected, waiter: " << id_and_callback.first;
+    id_and_callback.second(STATUS_EC_FORMAT(
+        TryAgain, TransactionError(TransactionErrorCode::kConflict),
+        "$0 Conflicts with transactions of a deadlock that spans several tablets",
+        id_and_callback.first));
+  }
+}
+
+void WaitQueue::WaitersModifiedUnlocked() {
+  num_waiters_.store(waiters_.size(), std::memory_order_release);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,104 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_WAIT_QUEUE_H
+#define YB_DOCDB_WAIT_QUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+namespace docdb {
+
+using WaitForEdges = std::vector<std::pair<TransactionId, TransactionId>>;
+
+// Queue of transactions that wait for conflicting transactions of the same tablet to finish,
+// instead of aborting them or failing.
+//
+// Waiting transactions and transactions they wait for form local wait-for graph. Wait that would
+// introduce a cycle to this graph is rejected, so caller could break the deadlock by aborting one
+// of the transactions.
+//
+// Deadlocks that span several tablets are detected by the master, which aggregates wait-for edges
+// of all tablet servers reported in heartbeats. Waits of the victims are failed through
+// DeadlocksDetected.
+class WaitQueue {
+ public:
+  WaitQueue() = default;
+  ~WaitQueue();
+
+  // Registers waiter that waits for any of blockers to finish.
+  // Callback is invoked with OK status when one of blockers finished, or with TimedOut status when
+  // deadline is passed.
+  // Returns false and does not register waiter if it would result in a deadlock within this queue.
+  MUST_USE_RESULT bool Wait(const TransactionId& waiter,
+                            const std::vector<TransactionId>& blockers,
+                            CoarseTimePoint deadline,
+                            StdStatusCallback callback);
+
+  // Notifies waiters of transaction that it is finished, i.e. committed and applied or aborted.
+  void TransactionFinished(const TransactionId& id);
+
+  // Notifies waiters whose deadline is passed.
+  void Poll(CoarseTimePoint now);
+
+  // Fails all waiters with the specified status.
+  void Shutdown(const Status& status);
+
+  // Appends edges of the wait-for graph of this queue, i.e. pairs of waiter and its blocker.
+  void FillWaitForEdges(WaitForEdges* edges);
+
+  // Fails waits of specified transactions with conflict, to break deadlocks that span several
+  // tablets.
+  void DeadlocksDetected(const TransactionIdSet& waiters);
+
+  bool HasWaiters() const {
+    return num_waiters_.load(std::memory_order_acquire) != 0;
+  }
+
+ private:
+  struct Waiter {
+    std::vector<TransactionId> blockers;
+    CoarseTimePoint deadline;
+    StdStatusCallback callback;
+  };
+
+  // The same transaction could have several operations waiting on the tablet.
+  typedef std::unordered_multimap<TransactionId, Waiter, TransactionIdHash> Waiters;
+
+  // Returns true if waiter could be reached from any of blockers using wait-for edges of this
+  // queue.
+  bool WouldDeadlockLocallyUnlocked(const TransactionId& waiter,
+                                    const std::vector<TransactionId>& blockers) REQUIRES(mutex_);
+
+  void WaitersModifiedUnlocked() REQUIRES(mutex_);
+
+  std::mutex mutex_;
+  // Maps waiting transaction to the transactions it waits for.
+  Waiters waiters_ GUARDED_BY(mutex_);
+  std::atomic<size_t> num_waiters_{0};
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_WAIT_QUEUE_H
@@ -191,7 +191,8 @@ Result<std::string> CatalogManagerUtil::GetPlacementUuidFromRaftPeer(
     const ReplicationInfoPB& replication_info, const consensus::RaftPeerPB& peer) {
   switch (peer.member_type()) {
     case consensus::RaftPeerPB::PRE_VOTER:
-    case consensus::RaftPeerPB::VOTER: {
+    case consensus::RaftPeerPB::VOTER:
+    case consensus::RaftPeerPB::WITNESS: {
       // This peer is a live replica.
       return replication_info.live_replicas().placement_uuid();
     }
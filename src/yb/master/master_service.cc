@@ -48,6 +48,7 @@
 #include "yb/master/master_service_base-internal.h"
 #include "yb/master/master_service_base.h"
 #include "yb/master/permissions_manager.h"
+#include "yb/master/wait_for_graph.h"
 
 
 #include "yb/util/debug/long_operation_tracker.h"
@@ -196,6 +197,8 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     ts_desc->UpdateMetrics(req->metrics());
   }
 
+  ts_desc->UpdateWaitForEdges(req->wait_for_edges());
+
   if (req->has_tablet_report()) {
     s = server_->catalog_manager()->ProcessTabletReport(
       ts_desc.get(), req->tablet_report(), resp->mutable_tablet_report(), &rpc);
@@ -230,6 +233,22 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     *resp->add_tservers() = *desc->GetTSInformationPB();
   }
 
+  // Transactions waiting on this server could be part of deadlocks that span several servers.
+  if (req->wait_for_edges_size() != 0) {
+    WaitForGraph wait_for_graph;
+    for (const auto& desc : descs) {
+      for (const auto& edge : desc->wait_for_edges()) {
+        wait_for_graph.AddEdge(edge.waiter(), edge.blocker());
+      }
+    }
+    auto victims = wait_for_graph.FindVictims();
+    for (const auto& edge : req->wait_for_edges()) {
+      if (victims.erase(edge.waiter())) {
+        resp->add_deadlocked_waiters(edge.waiter());
+      }
+    }
+  }
+
   // Retrieve the ysql catalog schema version.
   uint64_t last_breaking_version = 0;
   uint64_t catalog_version = 0;
@@ -258,6 +258,17 @@ class TSDescriptor {
     ts_metrics_.ClearMetrics();
   }
 
+  // Wait-for edges of transactions waiting on this tablet server, replaced by every heartbeat.
+  void UpdateWaitForEdges(const google::protobuf::RepeatedPtrField<WaitForEdgePB>& edges) {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    wait_for_edges_ = edges;
+  }
+
+  google::protobuf::RepeatedPtrField<WaitForEdgePB> wait_for_edges() const {
+    SharedLock<decltype(lock_)> l(lock_);
+    return wait_for_edges_;
+  }
+
   // Set of methods to keep track of pending tablet deletes for a tablet server. We use them to
   // avoid assigning more tablets to a tserver that might be potentially unresponsive.
   bool HasTabletDeletePending() const;
@@ -341,6 +352,8 @@ class TSDescriptor {
 
   struct TSMetrics ts_metrics_;
 
+  google::protobuf::RepeatedPtrField<WaitForEdgePB> wait_for_edges_;
+
   const std::string permanent_uuid_;
   CloudInfoPB local_cloud_info_;
   rpc::ProxyCache* proxy_cache_;
@@ -0,0 +1,55 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/wait_for_graph.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace master {
+
+class WaitForGraphTest : public YBTest {
+ protected:
+  void AddEdges(const std::vector<std::pair<std::string, std::string>>& edges) {
+    for (const auto& edge : edges) {
+      graph_.AddEdge(edge.first, edge.second);
+    }
+  }
+
+  WaitForGraph graph_;
+};
+
+TEST_F(WaitForGraphTest, NoCycles) {
+  AddEdges({{"a", "b"}, {"b", "c"}, {"a", "c"}, {"d", "c"}});
+  ASSERT_TRUE(graph_.FindVictims().empty());
+}
+
+TEST_F(WaitForGraphTest, Cycle) {
+  AddEdges({{"a", "b"}, {"b", "c"}, {"c", "a"}});
+  ASSERT_EQ(graph_.FindVictims(), std::unordered_set<std::string>({"c"}));
+}
+
+TEST_F(WaitForGraphTest, CycleWithWaitersOutside) {
+  // x and y wait for transactions of the cycle, but are not part of it.
+  AddEdges({{"x", "a"}, {"a", "b"}, {"b", "a"}, {"b", "y"}, {"z", "x"}});
+  ASSERT_EQ(graph_.FindVictims(), std::unordered_set<std::string>({"b"}));
+}
+
+TEST_F(WaitForGraphTest, SeveralCycles) {
+  // Two cycles that share node c form a single component, and the separate cycle of e and f.
+  AddEdges({{"a", "c"}, {"c", "a"}, {"b", "c"}, {"c", "b"}, {"e", "f"}, {"f", "e"}, {"c", "e"}});
+  ASSERT_EQ(graph_.FindVictims(), std::unordered_set<std::string>({"c", "f"}));
+}
+
+} // namespace master
+} // namespace yb
@@ -0,0 +1,107 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/wait_for_graph.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace yb {
+namespace master {
+
+void WaitForGraph::AddEdge(const std::string& waiter, const std::string& blocker) {
+  auto waiter_index = NodeIndex(waiter);
+  auto blocker_index = NodeIndex(blocker);
+  blockers_[waiter_index].push_back(blocker_index);
+}
+
+size_t WaitForGraph::NodeIndex(const std::string& id) {
+  auto it = node_indexes_.emplace(id, node_ids_.size()).first;
+  if (it->second == node_ids_.size()) {
+    node_ids_.push_back(&it->first);
+    blockers_.emplace_back();
+  }
+  return it->second;
+}
+
+std::unordered_set<std::string> WaitForGraph::FindVictims() const {
+  // Iterative version of Tarjan's strongly connected components algorithm, since wait chains could
+  // be long enough to overflow the stack.
+  constexpr size_t kNotVisited = std::numeric_limits<size_t>::max();
+  const size_t num_nodes = node_ids_.size();
+  std::vector<size_t> visit_order(num_nodes, kNotVisited);
+  std::vector<size_t> low_link(num_nodes);
+  std::vector<bool> on_stack(num_nodes);
+  std::vector<size_t> stack;
+  // Node being visited and index of its next blocker to visit.
+  std::vector<std::pair<size_t, size_t>> visits;
+  size_t next_visit_order = 0;
+  std::unordered_set<std::string> result;
+
+  auto start_visit = [&](size_t node) {
+    visit_order[node] = low_link[node] = next_visit_order++;
+    stack.push_back(node);
+    on_stack[node] = true;
+    visits.emplace_back(node, 0);
+  };
+
+  for (size_t root = 0; root != num_nodes; ++root) {
+    if (visit_order[root] != kNotVisited) {
+      continue;
+    }
+    start_visit(root);
+    while (!visits.empty()) {
+      const auto node = visits.back().first;
+      const auto& blockers = blockers_[node];
+      if (visits.back().second != blockers.size()) {
+        const auto blocker = blockers[visits.back().second++];
+        if (visit_order[blocker] == kNotVisited) {
+          start_visit(blocker);
+        } else if (on_stack[blocker]) {
+          low_link[node] = std::min(low_link[node], visit_order[blocker]);
+        }
+        continue;
+      }
+
+      visits.pop_back();
+      if (!visits.empty()) {
+        auto parent = visits.back().first;
+        low_link[parent] = std::min(low_link[parent], low_link[node]);
+      }
+      if (low_link[node] != visit_order[node]) {
+        continue;
+      }
+
+      // Node is the root of a strongly connected component, that is on the stack above it.
+      auto component_begin = std::find(stack.begin(), stack.end(), node);
+      if (stack.end() - component_begin > 1) {
+        const std::string* victim = nullptr;
+        for (auto it = component_begin; it != stack.end(); ++it) {
+          if (!victim || *node_ids_[*it] > *victim) {
+            victim = node_ids_[*it];
+          }
+        }
+        result.insert(*victim);
+      }
+      for (auto it = component_begin; it != stack.end(); ++it) {
+        on_stack[*it] = false;
+      }
+      stack.erase(component_begin, stack.end());
+    }
+  }
+
+  return result;
+}
+
+} // namespace master
+} // namespace yb
@@ -0,0 +1,52 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_WAIT_FOR_GRAPH_H
+#define YB_MASTER_WAIT_FOR_GRAPH_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace yb {
+namespace master {
+
+// Wait-for graph of transactions waiting in wait queues of all tablet servers, used to find
+// deadlocks that span several tablets. Transactions are identified by their encoded ids.
+//
+// Tablet servers report their edges in heartbeats, so the graph is assembled from reports made at
+// slightly different times. A cycle that was already broken could still be found, in this case its
+// victim fails with a conflict and is retried, as after any other conflict.
+class WaitForGraph {
+ public:
+  void AddEdge(const std::string& waiter, const std::string& blocker);
+
+  // Returns waiters that should fail to break all cycles of this graph. The waiter with the greatest
+  // id is picked from every strongly connected component that contains a cycle. If that component
+  // still has a cycle without the victim, it is broken after the next heartbeats.
+  std::unordered_set<std::string> FindVictims() const;
+
+ private:
+  size_t NodeIndex(const std::string& id);
+
+  std::unordered_map<std::string, size_t> node_indexes_;
+  std::vector<const std::string*> node_ids_;
+  // Indexes of the transactions waited by the transaction with the same index.
+  std::vector<std::vector<size_t>> blockers_;
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_WAIT_FOR_GRAPH_H
@@ -66,6 +66,14 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new sharded cache that uses CLOCK eviction policy instead of LRU. Lookup does not move
+// entries between lists and does not block concurrent lookups of the same shard, which makes it
+// cheaper for read heavy workloads with many threads. Single-touch and multi-touch entries are
+// distinguished the same way as in the LRU cache.
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits);
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                       bool strict_capacity_limit);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
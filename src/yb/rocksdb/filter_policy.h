@@ -215,6 +215,14 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 extern const FilterPolicy* NewFixedSizeFilterPolicy(uint32_t total_bits,
                                                     double error_rate,
                                                     Logger* logger);
+
+// Return a new filter policy that uses a Ribbon filter divided into fixed-size blocks. Parameters
+// are the same as for NewFixedSizeFilterPolicy, but Ribbon filter needs ~25% less space than Bloom
+// filter for the same false positive rate, so each filter block holds more keys. Filter is static,
+// so keys of the current filter block are buffered in memory (4 bytes per key).
+extern const FilterPolicy* NewFixedSizeRibbonFilterPolicy(uint32_t total_bits,
+                                                          double error_rate,
+                                                          Logger* logger);
 }  // namespace rocksdb
 
 #endif  // YB_ROCKSDB_FILTER_POLICY_H
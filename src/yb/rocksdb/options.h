@@ -169,9 +169,15 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of the dictionary used to compress data blocks of SST file. The dictionary is
+  // sampled from the first data blocks of the file and stored in the file as a meta block.
+  // Compressing each block with shared dictionary considerably improves compression of small
+  // blocks with similar content. Supported by Zlib, LZ4 and ZSTD compression.
+  // 0 means that dictionary is not used.
+  uint32_t max_dict_bytes;
+  CompressionOptions() : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -1410,6 +1416,17 @@ class ReadFileFilter {
   virtual ~ReadFileFilter() {}
 };
 
+// Filter for pruning data blocks by their properties collected by
+// BlockBasedTableOptions::data_block_properties_collector_factory.
+class DataBlockFilter {
+ public:
+  // Returns false if data block with specified properties does not contain keys of interest and
+  // could be skipped. Only called for blocks that have non-empty properties.
+  virtual bool Filter(const Slice& block_properties) const = 0;
+
+  virtual ~DataBlockFilter() {}
+};
+
 class TableReader;
 class TableAwareReadFileFilter {
  public:
@@ -1524,6 +1541,9 @@ struct ReadOptions {
 
   std::shared_ptr<ReadFileFilter> file_filter;
 
+  // Filter for pruning data blocks of SST files while iterating. By default doesn't filter blocks.
+  std::shared_ptr<DataBlockFilter> data_block_filter;
+
   static const ReadOptions kDefault;
 
   ReadOptions();
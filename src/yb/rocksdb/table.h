@@ -45,6 +45,12 @@
 
 #include "yb/util/size_literals.h"
 
+namespace yb {
+
+class ThreadPool;
+
+}
+
 namespace rocksdb {
 
 // -- Block-based Table
@@ -80,6 +86,28 @@ YB_DEFINE_ENUM(IndexType,
   (kMultiLevelBinarySearch)
 );
 
+// Collects user defined properties of data blocks. Properties of a data block are stored in its
+// data index entry after the block handle, so readers could skip the block using
+// ReadOptions::data_block_filter without reading it.
+class DataBlockPropertiesCollector {
+ public:
+  virtual ~DataBlockPropertiesCollector() {}
+
+  // Called for each internal key added to the current data block.
+  virtual void AddKey(const Slice& key) = 0;
+
+  // Appends encoded properties of the keys added since the previous call and starts collecting
+  // properties of the next block. Could append nothing, when block has no useful properties.
+  virtual void FinishBlock(std::string* dest) = 0;
+};
+
+class DataBlockPropertiesCollectorFactory {
+ public:
+  virtual ~DataBlockPropertiesCollectorFactory() {}
+
+  virtual std::unique_ptr<DataBlockPropertiesCollector> CreateCollector() const = 0;
+};
+
 // For advanced user only
 struct BlockBasedTableOptions {
   // @flush_block_policy_factory creates the instances of flush block policy.
@@ -135,6 +163,29 @@ struct BlockBasedTableOptions {
   // Size of each filter block, in bytes. Only applicable for fixed size filter block.
   size_t filter_block_size = 64 * 1024;
 
+  // Fixed-size filter index is always kept in the table reader, while fixed-size filter blocks are
+  // loaded on demand through the block cache. If this option is set, filter blocks are put to the
+  // multi-touch part of the block cache, so they are not evicted by scans over data blocks.
+  bool filter_blocks_in_multi_touch_cache = false;
+
+  // If true, when fixed-size filter blocks of a table are accessed in forward order, the next
+  // filter block is read to the block cache in background.
+  bool prefetch_next_filter_block = false;
+
+  // Thread pool used to read the next filter block when prefetch_next_filter_block is set.
+  // Should outlive tables that use it. If not set, filter blocks are not prefetched.
+  yb::ThreadPool* filter_block_prefetch_thread_pool = nullptr;
+
+  // Maximum size of readahead issued by iterators that read data blocks sequentially. Readahead
+  // starts after a couple of sequential data block reads and its size is doubled each time until it
+  // reaches this limit. 0 disables readahead.
+  size_t max_auto_readahead_size = 0;
+
+  // If an iterator reads at least this number of bytes of sequential data blocks, data blocks it
+  // reads from disk after that are not added to the block cache, so long scans don't evict the
+  // working set of other reads. 0 means that scans always fill the block cache.
+  size_t sequential_scan_cache_bypass_size = 0;
+
   // This is used to close a block before it reaches the configured
   // 'block_size'. If the percentage of free space in the current block is less
   // than this specified number and adding a new record to the block will
@@ -168,6 +219,10 @@ struct BlockBasedTableOptions {
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
 
+  // If set, properties of data blocks are collected by the created collectors and stored in the
+  // data index. Not supported for kHashSearch index type.
+  std::shared_ptr<DataBlockPropertiesCollectorFactory> data_block_properties_collector_factory;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
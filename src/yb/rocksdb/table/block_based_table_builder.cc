@@ -27,6 +27,7 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -106,9 +107,11 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 }
 
 // format_version is the block format as defined in include/rocksdb/table.h
+// compression_dict is ignored by compression types that do not support dictionaries.
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
+                    const Slice& compression_dict,
                     std::string* compressed_output) {
   if (*type == kNoCompression) {
     return raw;
@@ -128,7 +131,7 @@ Slice CompressBlock(const Slice& raw,
       if (Zlib_Compress(
               compression_options,
               GetCompressFormatForVersion(kZlibCompression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -146,7 +149,7 @@ Slice CompressBlock(const Slice& raw,
       if (LZ4_Compress(
               compression_options,
               GetCompressFormatForVersion(kLZ4Compression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -162,7 +165,7 @@ Slice CompressBlock(const Slice& raw,
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -176,6 +179,10 @@ Slice CompressBlock(const Slice& raw,
   return raw;
 }
 
+// While compression dictionary is not built, data blocks are buffered in memory until their total
+// size reaches max_dict_bytes multiplied by this ratio, so dictionary is sampled from enough data.
+constexpr size_t kCompressionDictBufferRatio = 16;
+
 }  // namespace
 
 // kBlockBasedTableMagicNumber was picked by running
@@ -304,6 +311,24 @@ struct BlockBasedTableBuilder::Rep {
 
   yb::MemTrackerPtr mem_tracker;
 
+  // Data block that was finished but not yet written, because compression dictionary is not built.
+  struct BufferedDataBlock {
+    std::string contents;
+    std::string last_key;
+    std::string next_block_first_key;
+    std::string properties;
+  };
+
+  // Dictionary used to compress data blocks. Empty if dictionary compression is not used.
+  std::string compression_dict;
+  // True while data blocks are buffered to sample compression dictionary from them.
+  bool buffering_data_blocks = false;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  size_t buffered_data_size = 0;
+
+  // Collects properties of the current data block, that are stored in its data index entry.
+  std::unique_ptr<DataBlockPropertiesCollector> data_block_properties_collector;
+
   bool TEST_skip_writing_key_value_encoding_format_ = false;
 
   Rep(const ImmutableCFOptions& _ioptions,
@@ -384,6 +409,19 @@ BlockBasedTableBuilder::Rep::Rep(
     mem_tracker = yb::MemTracker::FindOrCreateTracker(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
   }
+  // Block based filter is written per data block at its offset, and hash index requires prefixes
+  // of keys in the order they are added, so data blocks could not be buffered for them.
+  buffering_data_blocks =
+      compression_opts.max_dict_bytes > 0 && CompressionDictionarySupported(compression_type) &&
+      filter_type != FilterType::kBlockBasedFilter &&
+      table_options.index_type != IndexType::kHashSearch;
+
+  // Hash index keeps its own index entries format, so data block properties are not supported.
+  if (table_options.data_block_properties_collector_factory &&
+      table_options.index_type != IndexType::kHashSearch) {
+    data_block_properties_collector =
+        table_options.data_block_properties_collector_factory->CreateCollector();
+  }
 
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
   metadata_writer->writer = metadata_file;
@@ -485,6 +523,9 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
   r->props.raw_value_size += value.size();
 
   r->data_index_builder->OnKeyAdded(key);
+  if (r->data_block_properties_collector) {
+    r->data_block_properties_collector->AddKey(key);
+  }
 
   NotifyCollectTableCollectorsOnAdd(key, value, r->data_writer->offset,
       r->table_properties_collectors,
@@ -495,11 +536,72 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
+
+  std::string properties;
+  if (r->data_block_properties_collector && !r->data_block_builder.empty()) {
+    r->data_block_properties_collector->FinishBlock(&properties);
+  }
+
+  if (r->buffering_data_blocks) {
+    if (!r->data_block_builder.empty()) {
+      const Slice contents = r->data_block_builder.Finish();
+      r->buffered_data_blocks.push_back(Rep::BufferedDataBlock{
+          contents.ToBuffer(), r->last_key, next_block_first_key.ToBuffer(),
+          std::move(properties)});
+      r->buffered_data_size += contents.size();
+      r->data_block_builder.Reset();
+    }
+    if (r->buffered_data_size >=
+            r->compression_opts.max_dict_bytes * kCompressionDictBufferRatio) {
+      FlushBufferedDataBlocks();
+    }
+    return;
+  }
+
+  const Slice contents = r->data_block_builder.empty() ? Slice() : r->data_block_builder.Finish();
+  WriteDataBlock(contents, &r->last_key, next_block_first_key, properties);
+  r->data_block_builder.Reset();
+}
+
+void BlockBasedTableBuilder::FlushBufferedDataBlocks() {
+  Rep* const r = rep_;
+  r->buffering_data_blocks = false;
+  auto& blocks = r->buffered_data_blocks;
+  if (!blocks.empty()) {
+    // Dictionary is composed of evenly sized samples taken from the beginning of each buffered
+    // block, so it contains strings that are common for the whole key range of the file.
+    const size_t max_dict_bytes = r->compression_opts.max_dict_bytes;
+    const size_t sample_size = std::max<size_t>(max_dict_bytes / blocks.size(), 1);
+    r->compression_dict.reserve(max_dict_bytes);
+    for (const auto& block : blocks) {
+      const size_t size = std::min(
+          {sample_size, block.contents.size(), max_dict_bytes - r->compression_dict.size()});
+      r->compression_dict.append(block.contents.data(), size);
+      if (r->compression_dict.size() >= max_dict_bytes) {
+        break;
+      }
+    }
+  }
+  for (auto& block : blocks) {
+    WriteDataBlock(
+        block.contents, &block.last_key, block.next_block_first_key, block.properties);
+    if (!ok()) break;
+  }
+  blocks.clear();
+  blocks.shrink_to_fit();
+  r->buffered_data_size = 0;
+}
+
+void BlockBasedTableBuilder::WriteDataBlock(
+    const Slice& contents, std::string* last_key, const Slice& next_block_first_key,
+    const Slice& block_properties) {
+  Rep* const r = rep_;
+  if (!ok()) return;
   size_t data_block_size = 0;
 
-  if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+  if (!contents.empty()) {
+    data_block_size = WriteBlock(
+        contents, &r->data_pending_handle, r->data_writer.get(), r->compression_dict);
   }
   if (!ok()) return;
 
@@ -523,9 +625,9 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
-      r->data_pending_handle);
+      r->data_pending_handle, block_properties);
   while (r->data_index_builder->ShouldFlush()) {
     auto result = r->data_index_builder->FlushNextBlock(
         &r->data_index_blocks, r->last_index_block_handle);
@@ -570,17 +672,10 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_firs
       &r->last_filter_key, next_block_first_filter_key, r->filter_pending_handle);
 }
 
-size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
-                                          BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
-  block->Reset();
-  return block_size;
-}
-
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const Slice& compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -593,7 +688,8 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, compression_dict,
+                      &r->compressed_output);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -714,6 +810,9 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffering_data_blocks) {
+    FlushBufferedDataBlocks();
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(nullptr);  // no more filter block
   }
@@ -740,6 +839,15 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && !r->compression_dict.empty()) {
+    // Dictionary is written uncompressed, since it is required to uncompress data blocks.
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(
+        r->compression_dict, kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(block_based_table::kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -862,8 +970,9 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are accounted, so file is split by size as if they were already written.
+  return rep_->buffered_data_size + (rep_->is_split_sst() ?
+      rep_->metadata_writer->offset + rep_->data_writer->offset : rep_->metadata_writer->offset);
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
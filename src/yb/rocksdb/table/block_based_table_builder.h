@@ -108,13 +108,11 @@ class BlockBasedTableBuilder : public TableBuilder {
   struct FileWriterWithOffsetAndCachePrefix;
 
   bool ok() const { return status().ok(); }
-  // Call block's Finish() method and then write the finalize block contents to
-  // file. Returns number of bytes written to file.
-  size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-                    FileWriterWithOffsetAndCachePrefix* writer_info);
   // Directly write block content to the file. Returns number of bytes written to file.
+  // compression_dict is used to compress the block when compression type supports it.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const Slice& compression_dict = Slice());
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -132,6 +130,15 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called.
   void FlushDataBlock(const Slice& next_block_first_key);
 
+  // Builds compression dictionary from buffered data blocks and writes them to disk.
+  void FlushBufferedDataBlocks();
+
+  // Writes data block with specified contents to disk and adds its entry with block_properties to
+  // the data index. last_key could be modified by the index builder.
+  void WriteDataBlock(
+      const Slice& contents, std::string* last_key, const Slice& next_block_first_key,
+      const Slice& block_properties);
+
   // Flush the current filter block into disk. next_block_first_filter_key should be nullptr if this
   // is the last block written to disk.
   // REQUIRES: Finish(), Abandon() have not been called.
@@ -168,6 +168,15 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  filter_block_size: %" ROCKSDB_PRIszt "\n",
+           table_options_.filter_block_size);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  filter_blocks_in_multi_touch_cache: %d\n",
+           table_options_.filter_blocks_in_multi_touch_cache);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  prefetch_next_filter_block: %d\n",
+           table_options_.prefetch_next_filter_block);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  block_size_deviation: %d\n",
            table_options_.block_size_deviation);
   ret.append(buffer);
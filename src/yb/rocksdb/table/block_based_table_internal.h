@@ -25,6 +25,8 @@ namespace block_based_table {
 constexpr char kFilterBlockPrefix[] = "filter.";
 constexpr char kFullFilterBlockPrefix[] = "fullfilter.";
 constexpr char kFixedSizeFilterBlockPrefix[] = "fixedsizefilter.";
+// Name of the meta block that contains dictionary used to compress data blocks.
+constexpr char kCompressionDictBlock[] = "rocksdb.compression_dict";
 
 // Read the block identified by "handle" from "file".
 // The only relevant option is options.verify_checksums for now.
@@ -34,10 +36,10 @@ inline CHECKED_STATUS ReadBlockFromFile(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
     const BlockHandle& handle, std::unique_ptr<Block>* result, Env* env,
     const std::shared_ptr<yb::MemTracker>& mem_tracker,
-    bool do_uncompress = true) {
+    bool do_uncompress = true, const Slice& compression_dict = Slice()) {
   BlockContents contents;
   Status s = ReadBlockContents(file, footer, options, handle, &contents, env,
-                               mem_tracker, do_uncompress);
+                               mem_tracker, do_uncompress, compression_dict);
   if (s.ok()) {
     result->reset(new Block(std::move(contents)));
   }
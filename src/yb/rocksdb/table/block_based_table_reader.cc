@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <atomic>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -65,6 +67,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 
 namespace rocksdb {
 
@@ -77,6 +80,9 @@ typedef FilterPolicy::FilterType FilterType;
 
 namespace {
 
+// Offset of the filter block that is not accessed yet.
+constexpr uint64_t kNoFilterBlockOffset = std::numeric_limits<uint64_t>::max();
+
 // Delete the resource that is held by the iterator.
 template <class ResourceType>
 void DeleteHeldResource(void* arg, void* ignored) {
@@ -232,6 +238,8 @@ struct BlockBasedTable::Rep {
   bool prefix_filtering = false;
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+  // Dictionary used to compress data blocks, empty if data blocks were compressed without it.
+  BlockContents compression_dict_block;
   // TODO(kailiu) It is very ugly to use internal key in table, since table
   // module should not be relying on db module. However to make things easier
   // and compatible with existing code, we introduce a wrapper that allows
@@ -240,11 +248,23 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Offset of the last accessed fixed-size filter block, used to detect forward scans over filter
+  // blocks.
+  std::atomic<uint64_t> last_filter_block_offset{kNoFilterBlockOffset};
+  // Offset of the last fixed-size filter block scheduled for prefetch.
+  std::atomic<uint64_t> last_prefetched_filter_block_offset{kNoFilterBlockOffset};
+  // Token used to submit filter block prefetch tasks to
+  // table_options.filter_block_prefetch_thread_pool.
+  std::unique_ptr<yb::ThreadPoolToken> filter_block_prefetch_token;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match
+// or to create a secondary iterator.
+// For data blocks it is created per iterator and also tracks sequential reads of data blocks, in
+// order to readahead subsequent blocks and to stop filling block cache by long scans. Index state
+// is shared by all iterators of the table and doesn't track anything.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -253,10 +273,23 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
       : TwoLevelIteratorState(table->rep_->ioptions.prefix_extractor != nullptr),
         table_(table),
         read_options_(read_options),
+        fill_cache_(read_options.fill_cache),
         skip_filters_(skip_filters),
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData) {
+      // Data index entry value could contain block properties after the block handle.
+      Slice block_properties = index_value;
+      BlockHandle handle;
+      if (handle.DecodeFrom(&block_properties).ok()) {
+        if (read_options_.data_block_filter && !block_properties.empty() &&
+            !read_options_.data_block_filter->Filter(block_properties)) {
+          return NewEmptyInternalIterator();
+        }
+        TrackDataBlockRead(handle);
+      }
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -268,13 +301,64 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  // Readahead is issued only after this number of sequential data block reads.
+  static constexpr size_t kMinSequentialReadsForReadahead = 2;
+  // Size of the first readahead, subsequent ones are twice as large as the previous one.
+  static constexpr size_t kInitialReadaheadSize = 64_KB;
+
+  void TrackDataBlockRead(const BlockHandle& handle) {
+    const auto& table_options = table_->rep_->table_options;
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (handle.offset() == next_block_offset_) {
+      ++num_sequential_reads_;
+      sequential_read_bytes_ += block_end - handle.offset();
+    } else {
+      num_sequential_reads_ = 0;
+      sequential_read_bytes_ = 0;
+      readahead_size_ = kInitialReadaheadSize;
+      readahead_limit_ = 0;
+      read_options_.fill_cache = fill_cache_;
+    }
+    next_block_offset_ = block_end;
+
+    if (table_options.max_auto_readahead_size > 0 &&
+        num_sequential_reads_ >= kMinSequentialReadsForReadahead && block_end > readahead_limit_) {
+      const size_t readahead_size = std::min(readahead_size_, table_options.max_auto_readahead_size);
+      // Readahead is only a hint, so failure to issue it does not fail the read.
+      auto status = table_->GetBlockReader(BlockType::kData)->reader->Prefetch(
+          handle.offset(), readahead_size);
+      if (status.IsNotSupported()) {
+        // Don't try to readahead files that don't support it.
+        readahead_limit_ = std::numeric_limits<uint64_t>::max();
+      } else {
+        readahead_limit_ = handle.offset() + readahead_size;
+        readahead_size_ = std::min(readahead_size * 2, table_options.max_auto_readahead_size);
+      }
+    }
+
+    if (table_options.sequential_scan_cache_bypass_size > 0 &&
+        sequential_read_bytes_ >= table_options.sequential_scan_cache_bypass_size) {
+      read_options_.fill_cache = false;
+    }
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
   BlockBasedTable* const table_;
-  const ReadOptions read_options_;
+  ReadOptions read_options_;
+  // Value of read_options_.fill_cache requested by the user.
+  const bool fill_cache_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // Sequential data block reads tracking.
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  size_t num_sequential_reads_ = 0;
+  uint64_t sequential_read_bytes_ = 0;
+  size_t readahead_size_ = kInitialReadaheadSize;
+  // Offset of the end of the last issued readahead.
+  uint64_t readahead_limit_ = 0;
 };
 
 
@@ -293,6 +377,11 @@ class BlockBasedTable::IndexIteratorHolder {
 };
 
 BlockBasedTable::~BlockBasedTable() {
+  if (rep_->filter_block_prefetch_token) {
+    // Drops prefetch tasks that are not started yet and waits for running ones, since they access
+    // rep_.
+    rep_->filter_block_prefetch_token->Shutdown();
+  }
   delete rep_;
 }
 
@@ -322,6 +411,16 @@ KeyValueEncodingFormat BlockBasedTable::GetKeyValueEncodingFormat(const BlockTyp
   FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
 }
 
+Slice BlockBasedTable::GetCompressionDict(const BlockType block_type) {
+  switch (block_type) {
+    case BlockType::kData:
+      return rep_->compression_dict_block.data;
+    case BlockType::kIndex:
+      return Slice();
+  }
+  FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
+}
+
 BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(BlockType block_type) {
   switch (block_type) {
     case BlockType::kData:
@@ -413,6 +512,10 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   rep->footer = footer;
   rep->index_type = table_options.index_type;
   rep->hash_index_allow_collision = table_options.hash_index_allow_collision;
+  if (table_options.prefetch_next_filter_block && table_options.filter_block_prefetch_thread_pool) {
+    rep->filter_block_prefetch_token = table_options.filter_block_prefetch_thread_pool->NewToken(
+        yb::ThreadPool::ExecutionMode::CONCURRENT);
+  }
   SetupCacheKeyPrefix(rep, rep->base_reader_with_cache_prefix.get());
   unique_ptr<BlockBasedTable> new_table(new BlockBasedTable(rep));
 
@@ -425,6 +528,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
@@ -516,6 +621,24 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle compression_dict_handle;
+  if (!FindMetaBlock(meta_iter, block_based_table::kCompressionDictBlock,
+                     &compression_dict_handle).ok()) {
+    // Data blocks were compressed without dictionary.
+    return Status::OK();
+  }
+  auto s = ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      compression_dict_handle, &rep_->compression_dict_block, rep_->ioptions.env,
+      rep_->mem_tracker, false /* do_uncompress */);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Encountered error while reading compression dictionary block %s", s.ToString().c_str());
+  }
+  return s;
+}
+
 Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
   // Read the properties
   bool found_properties_block = true;
@@ -756,7 +879,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -800,7 +923,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -828,7 +951,7 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -837,7 +960,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -939,7 +1062,7 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
 }
 
 Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
-    BlockHandle* filter_block_handle) const {
+    BlockHandle* filter_block_handle, BlockHandle* next_filter_block_handle) const {
   // Determine block of fixed-size bloom filter using filter index.
   BlockIter fiter;
   rep_->filter_index_reader->NewIterator(&fiter,
@@ -947,9 +1070,21 @@ Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
       // filter_index_reader.
       nullptr /* index_iterator_state */, true /* total_order_seek */);
   fiter.Seek(filter_key);
+  if (next_filter_block_handle) {
+    next_filter_block_handle->set_offset(0);
+    next_filter_block_handle->set_size(0);
+  }
   if (fiter.Valid()) {
     Slice filter_block_handle_encoded = fiter.value();
-    return filter_block_handle->DecodeFrom(&filter_block_handle_encoded);
+    RETURN_NOT_OK(filter_block_handle->DecodeFrom(&filter_block_handle_encoded));
+    if (next_filter_block_handle) {
+      fiter.Next();
+      if (fiter.Valid()) {
+        Slice next_filter_block_handle_encoded = fiter.value();
+        return next_filter_block_handle->DecodeFrom(&next_filter_block_handle_encoded);
+      }
+    }
+    return Status::OK();
   } else {
     // We are beyond the index, that means key is absent in filter, we use null block handle
     // stub to indicate that.
@@ -959,6 +1094,62 @@ Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
   }
 }
 
+QueryId BlockBasedTable::GetFilterBlockQueryId(QueryId query_id) const {
+  return rep_->table_options.filter_blocks_in_multi_touch_cache && query_id != kNoCacheQueryId
+      ? kInMultiTouchId : query_id;
+}
+
+void BlockBasedTable::MaybePrefetchNextFilterBlock(
+    const BlockHandle& filter_block_handle, const BlockHandle& next_filter_block_handle) const {
+  // Reading the next filter block on the caller thread would just add I/O to the read path.
+  if (!rep_->filter_block_prefetch_token) {
+    return;
+  }
+  const auto offset = filter_block_handle.offset();
+  const auto prev_offset =
+      rep_->last_filter_block_offset.exchange(offset, std::memory_order_acq_rel);
+  // Filter blocks are written in the order of keys, so the scan moves forward when it switches to
+  // the filter block with greater offset.
+  if (prev_offset >= offset || next_filter_block_handle.IsNull()) {
+    return;
+  }
+  const auto next_offset = next_filter_block_handle.offset();
+  if (rep_->last_prefetched_filter_block_offset.exchange(
+          next_offset, std::memory_order_acq_rel) == next_offset) {
+    return;
+  }
+  // Prefetch is best effort, so it is just skipped when the pool queue is full.
+  auto status = rep_->filter_block_prefetch_token->SubmitFunc(
+      [this, next_filter_block_handle] { PrefetchFilterBlock(next_filter_block_handle); });
+  if (!status.ok()) {
+    VLOG(3) << "Failed to schedule filter block prefetch: " << status;
+  }
+}
+
+void BlockBasedTable::PrefetchFilterBlock(const BlockHandle& filter_block_handle) const {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  char cache_key_buffer[block_based_table::kCacheKeyBufferSize];
+  auto filter_block_cache_key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
+      filter_block_handle, cache_key_buffer);
+  const QueryId query_id = GetFilterBlockQueryId(kDefaultQueryId);
+  // Statistics are not passed to the lookup, since it is not an access by the user.
+  auto cache_handle = block_cache->Lookup(filter_block_cache_key, query_id);
+  if (cache_handle != nullptr) {
+    block_cache->Release(cache_handle);
+    return;
+  }
+  size_t filter_size = 0;
+  FilterBlockReader* filter = ReadFilterBlock(filter_block_handle, rep_, &filter_size);
+  if (filter == nullptr) {
+    return;
+  }
+  // Cache deletes the filter in case of failure, since handle is not requested.
+  WARN_NOT_OK(block_cache->Insert(filter_block_cache_key, query_id, filter, filter_size,
+                                  &DeleteCachedEntry<FilterBlockReader>, nullptr /* handle */,
+                                  rep_->ioptions.statistics),
+              "Failed to insert prefetched filter block to block cache");
+}
+
 Slice BlockBasedTable::GetFilterKeyFromInternalKey(const Slice &internal_key) const {
   return GetFilterKeyFromUserKey(ExtractUserKey(internal_key));
 }
@@ -1003,14 +1194,23 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
   const BlockHandle* filter_block_handle;
   // Determine filter block handle
   BlockHandle fixed_size_filter_block_handle;
+  QueryId filter_query_id = query_id;
   if (is_fixed_size_filter) {
-    Status s = GetFixedSizeFilterBlockHandle(*filter_key, &fixed_size_filter_block_handle);
+    const bool prefetch_next = rep_->table_options.prefetch_next_filter_block;
+    BlockHandle next_filter_block_handle;
+    Status s = GetFixedSizeFilterBlockHandle(
+        *filter_key, &fixed_size_filter_block_handle,
+        prefetch_next ? &next_filter_block_handle : nullptr);
     if (s.ok()) {
       if (fixed_size_filter_block_handle.IsNull()) {
         // Key is beyond filter index - return stub filter.
         return rep_->not_matching_filter_entry;
       }
       filter_block_handle = &fixed_size_filter_block_handle;
+      filter_query_id = GetFilterBlockQueryId(query_id);
+      if (prefetch_next) {
+        MaybePrefetchNextFilterBlock(fixed_size_filter_block_handle, next_filter_block_handle);
+      }
     } else {
       // If we failed to decode filter block handle from filter index we will just log error in
       // production to continue operation in case of just filter corruption,
@@ -1031,7 +1231,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
 
   Statistics* statistics = rep_->ioptions.statistics;
   auto cache_handle = GetEntryFromCache(block_cache, filter_block_cache_key,
-      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, query_id);
+      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, filter_query_id);
 
   FilterBlockReader* filter = nullptr;
   if (cache_handle != nullptr) {
@@ -1046,7 +1246,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     filter = ReadFilterBlock(*filter_block_handle, rep_, &filter_size);
     if (filter != nullptr) {
       assert(filter_size > 0);
-      Status s = block_cache->Insert(filter_block_cache_key, query_id,
+      Status s = block_cache->Insert(filter_block_cache_key, filter_query_id,
                                      filter, filter_size,
                                      &DeleteCachedEntry<FilterBlockReader>, &cache_handle,
                                      statistics);
@@ -1189,6 +1389,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  const Slice compression_dict = GetCompressionDict(block_type);
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1209,7 +1410,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, compression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1217,13 +1418,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, compression_dict);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                compression_dict);
       }
     }
   }
@@ -1242,7 +1444,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, compression_dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -207,8 +207,23 @@ class BlockBasedTable : public TableReader {
   class IndexIteratorHolder;
 
   // Returns filter block handle for fixed-size bloom filter using filter index and filter key.
+  // If next_filter_block_handle is specified, it is set to the handle of the filter block that
+  // follows the found one, or null handle if there is no such block.
   CHECKED_STATUS GetFixedSizeFilterBlockHandle(const Slice& filter_key,
-      BlockHandle* filter_block_handle) const;
+      BlockHandle* filter_block_handle, BlockHandle* next_filter_block_handle = nullptr) const;
+
+  // Returns query id that should be used to put fixed-size filter block to the block cache.
+  QueryId GetFilterBlockQueryId(QueryId query_id) const;
+
+  // Reads next_filter_block_handle to the block cache if filter blocks are accessed in forward
+  // order, i.e. filter_block_handle goes after the previously accessed block. The read is done on
+  // filter_block_prefetch_thread_pool, nothing is prefetched if it is not specified in table
+  // options.
+  void MaybePrefetchNextFilterBlock(const BlockHandle& filter_block_handle,
+                                    const BlockHandle& next_filter_block_handle) const;
+
+  // Reads fixed-size filter block to the block cache unless it is already there.
+  void PrefetchFilterBlock(const BlockHandle& filter_block_handle) const;
 
   // Returns key to be added to filter or verified against filter based on internal_key.
   Slice GetFilterKeyFromInternalKey(const Slice &internal_key) const;
@@ -252,7 +267,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const Slice& compression_dict = Slice());
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -267,7 +283,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const Slice& compression_dict = Slice());
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -290,6 +307,9 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS ReadPropertiesBlock(InternalIterator* meta_iter);
 
+  // Reads dictionary used to compress data blocks, if any.
+  CHECKED_STATUS ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
   // Read the meta block from sst.
@@ -309,6 +329,8 @@ class BlockBasedTable : public TableReader {
 
   FileReaderWithCachePrefix* GetBlockReader(BlockType block_type);
   KeyValueEncodingFormat GetKeyValueEncodingFormat(BlockType block_type);
+  // Returns dictionary that was used to compress blocks of specified type.
+  Slice GetCompressionDict(BlockType block_type);
 
   explicit BlockBasedTable(Rep* rep) : rep_(rep) {}
 
@@ -660,6 +660,60 @@ TEST_F(BlockTest, EncodeThreeSharedParts) {
   }
 }
 
+// Keys with the structure of DocDB keys of a table with several columns per row, written by a
+// sequence of batches:
+// <hash><row id><group end><column id marker><column id><hybrid time marker><hybrid time>
+//     <write id><internal key suffix>
+TEST_F(BlockTest, ThreeSharedPartsDocDbKeys) {
+  constexpr auto kNumRows = 40;
+  constexpr auto kNumColumns = 5;
+  constexpr auto kRowsPerBatch = 10;
+  constexpr auto kBlockRestartInterval = 16;
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  SequenceNumber seq = 1000;
+  for (int row = 0; row != kNumRows; ++row) {
+    const uint64_t hybrid_time = 0x1234567800000000ULL + row / kRowsPerBatch;
+    for (int column = 0; column != kNumColumns; ++column) {
+      std::string key = "H\xab\xcdI";
+      // Row id is big endian, so keys are sorted.
+      for (int shift = 24; shift >= 0; shift -= 8) {
+        key.push_back(static_cast<char>(row >> shift));
+      }
+      key.push_back('!');
+      key.push_back('K');
+      key.push_back(static_cast<char>(10 + column));
+      key.push_back('#');
+      PutFixed64(&key, hybrid_time);
+      key.push_back(static_cast<char>(row % kRowsPerBatch * kNumColumns + column));
+      PutFixed64(&key, PackSequenceAndType(++seq, kTypeValue));
+      keys.push_back(std::move(key));
+      values.push_back("v" + std::to_string(row * kNumColumns + column));
+    }
+  }
+
+  size_t block_sizes[2];
+  for (auto format : {KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix,
+                      KeyValueEncodingFormat::kKeyDeltaEncodingThreeSharedParts}) {
+    BlockBuilder builder(kBlockRestartInterval, format, /* use_delta_encoding = */ true);
+    for (size_t i = 0; i != keys.size(); ++i) {
+      builder.Add(keys[i], values[i]);
+    }
+    auto rawblock = builder.Finish();
+    block_sizes[format == KeyValueEncodingFormat::kKeyDeltaEncodingThreeSharedParts] =
+        rawblock.size();
+
+    BlockContents contents;
+    contents.data = rawblock;
+    contents.cachable = false;
+    CheckBlockContents(std::move(contents), format, keys, values);
+  }
+  // Hybrid time and internal key suffix are shared between keys of the same row, so they are
+  // mostly omitted from three shared parts block.
+  ASSERT_LT(block_sizes[1] * 2, block_sizes[0]);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
@@ -441,7 +441,8 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         const Slice& compression_dict) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -472,7 +473,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, compression_dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -499,7 +501,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const Slice& compression_dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -521,7 +524,8 @@ Status UncompressBlockContents(const char* data, size_t n,
     case kZlibCompression:
       ubuf = std::unique_ptr<char[]>(Zlib_Uncompress(
           data, n, &decompress_size,
-          GetCompressFormatForVersion(kZlibCompression, format_version)));
+          GetCompressFormatForVersion(kZlibCompression, format_version), -14 /* windowBits */,
+          compression_dict));
       if (!ubuf) {
         static char zlib_corrupt_msg[] =
           "Zlib not supported or corrupted Zlib compressed block contents";
@@ -545,7 +549,7 @@ Status UncompressBlockContents(const char* data, size_t n,
     case kLZ4Compression:
       ubuf = std::unique_ptr<char[]>(LZ4_Uncompress(
           data, n, &decompress_size,
-          GetCompressFormatForVersion(kLZ4Compression, format_version)));
+          GetCompressFormatForVersion(kLZ4Compression, format_version), compression_dict));
       if (!ubuf) {
         static char lz4_corrupt_msg[] =
           "LZ4 not supported or corrupted LZ4 compressed block contents";
@@ -567,8 +571,8 @@ Status UncompressBlockContents(const char* data, size_t n,
           BlockContents(std::move(ubuf), decompress_size, true, kNoCompression, mem_tracker);
       break;
     case kZSTDNotFinalCompression:
-      ubuf =
-          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
+      ubuf = std::unique_ptr<char[]>(
+          ZSTD_Uncompress(data, n, &decompress_size, compression_dict));
       if (!ubuf) {
         static char zstd_corrupt_msg[] =
             "ZSTD not supported or corrupted ZSTD compressed block contents";
@@ -250,13 +250,15 @@ struct BlockContents {
 
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// compression_dict is used to uncompress the block if do_uncompress is true.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const Slice& compression_dict = Slice());
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -265,10 +267,13 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// compression_dict should be the dictionary that was used to compress the block, it is empty if
+// the block was compressed without dictionary.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const Slice& compression_dict = Slice());
 
 // Implementation details follow.  Clients should ignore,
 
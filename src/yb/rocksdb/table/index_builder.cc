@@ -50,9 +50,11 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
 void ShortenedIndexBuilder::AddIndexEntry(
     std::string* last_key_in_current_block,
     const Slice* first_key_in_next_block,
-    const BlockHandle& block_handle) {
+    const BlockHandle& block_handle,
+    const Slice& block_properties) {
   std::string handle_encoding;
   block_handle.AppendEncodedTo(&handle_encoding);
+  handle_encoding.append(block_properties.cdata(), block_properties.size());
   AddIndexEntry(
       last_key_in_current_block, first_key_in_next_block, handle_encoding, ShortenKeys::kTrue);
 }
@@ -81,10 +83,11 @@ Status ShortenedIndexBuilder::Finish(IndexBlocks* index_blocks) {
 void HashIndexBuilder::AddIndexEntry(
     std::string* last_key_in_current_block,
     const Slice* first_key_in_next_block,
-    const BlockHandle& block_handle) {
+    const BlockHandle& block_handle,
+    const Slice& block_properties) {
   ++current_restart_index_;
   primary_index_builder_.AddIndexEntry(
-      last_key_in_current_block, first_key_in_next_block, block_handle);
+      last_key_in_current_block, first_key_in_next_block, block_handle, block_properties);
 }
 
 void HashIndexBuilder::OnKeyAdded(const Slice& key) {
@@ -148,13 +151,15 @@ void MultiLevelIndexBuilder::EnsureCurrentLevelIndexBuilderCreated() {
 
 void MultiLevelIndexBuilder::AddIndexEntry(
     std::string* last_key_in_current_block, const Slice* first_key_in_next_block,
-    const BlockHandle& block_handle, const ShortenKeys shorten_keys) {
+    const BlockHandle& block_handle, const ShortenKeys shorten_keys,
+    const Slice& block_properties) {
   DCHECK(!current_level_block_.is_ready)
       << "Expected to first flush already complete index block";
   EnsureCurrentLevelIndexBuilderCreated();
 
   block_handle_encoding_.clear();
   block_handle.AppendEncodedTo(&block_handle_encoding_);
+  block_handle_encoding_.append(block_properties.cdata(), block_properties.size());
 
   current_level_index_block_builder_->AddIndexEntry(
       last_key_in_current_block, first_key_in_next_block, block_handle_encoding_, shorten_keys);
@@ -67,11 +67,15 @@ class IndexBuilder {
   //                             "substitute key".
   // @first_key_in_next_block: it will be nullptr if the entry being added is
   //                           the last one in the table
+  // @block_properties: encoded properties of the block, stored in the index entry value after
+  //                    the block handle. Readers decode the block handle from the beginning of
+  //                    the value, so they are able to ignore block properties.
   //
   // REQUIRES: Finish() has not yet been called.
   virtual void AddIndexEntry(std::string* last_key_in_current_block,
                              const Slice* first_key_in_next_block,
-                             const BlockHandle& block_handle) = 0;
+                             const BlockHandle& block_handle,
+                             const Slice& block_properties = Slice()) = 0;
 
   // This method will be called whenever a key is added. The subclasses may
   // override OnKeyAdded() if they need to collect additional information.
@@ -131,7 +135,8 @@ class ShortenedIndexBuilder : public IndexBuilder {
   void AddIndexEntry(
       std::string* last_key_in_current_block,
       const Slice* first_key_in_next_block,
-      const BlockHandle& block_handle) override;
+      const BlockHandle& block_handle,
+      const Slice& block_properties = Slice()) override;
 
   void AddIndexEntry(
       std::string* last_key_in_current_block,
@@ -191,7 +196,8 @@ class HashIndexBuilder : public IndexBuilder {
   void AddIndexEntry(
       std::string* last_key_in_current_block,
       const Slice* first_key_in_next_block,
-      const BlockHandle& block_handle) override;
+      const BlockHandle& block_handle,
+      const Slice& block_properties = Slice()) override;
 
   void OnKeyAdded(const Slice& key) override;
 
@@ -232,16 +238,19 @@ class MultiLevelIndexBuilder : public IndexBuilder {
   void AddIndexEntry(
       std::string* last_key_in_current_block,
       const Slice* first_key_in_next_block,
-      const BlockHandle& block_handle) override {
+      const BlockHandle& block_handle,
+      const Slice& block_properties = Slice()) override {
     AddIndexEntry(
-        last_key_in_current_block, first_key_in_next_block, block_handle, ShortenKeys::kTrue);
+        last_key_in_current_block, first_key_in_next_block, block_handle, ShortenKeys::kTrue,
+        block_properties);
   }
 
   void AddIndexEntry(
       std::string* last_key_in_current_block,
       const Slice* first_key_in_next_block,
       const BlockHandle& block_handle,
-      ShortenKeys shorten_keys);
+      ShortenKeys shorten_keys,
+      const Slice& block_properties = Slice());
 
   CHECKED_STATUS Finish(IndexBlocks* index_blocks) override {
     return STATUS(NotSupported, "Finishing as single block is not supported by multi-level index.");
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -48,6 +49,7 @@
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
+#include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/block_builder.h"
 #include "yb/rocksdb/table/format.h"
@@ -63,6 +65,7 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/util/enums.h"
+#include "yb/util/threadpool.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
@@ -302,7 +305,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -331,8 +334,8 @@ class TableConstructor: public Constructor {
 
     // Open the table
     uniq_id_ = cur_uniq_id_++;
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, internal_comparator),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -353,8 +356,8 @@ class TableConstructor: public Constructor {
   }
 
   virtual Status Reopen(const ImmutableCFOptions& ioptions) {
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, last_internal_key_),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -364,6 +367,11 @@ class TableConstructor: public Constructor {
     return table_reader_.get();
   }
 
+  // Returns file source of the current table reader, owned by the table reader.
+  test::StringSource* GetSource() {
+    return source_;
+  }
+
   bool AnywayDeleteIterator() const override {
     return convert_to_internal_key_;
   }
@@ -377,6 +385,7 @@ class TableConstructor: public Constructor {
  private:
   void Reset() {
     uniq_id_ = 0;
+    source_ = nullptr;
     table_reader_.reset();
     file_writer_.reset();
     file_reader_.reset();
@@ -390,6 +399,7 @@ class TableConstructor: public Constructor {
   unique_ptr<WritableFileWriter> file_writer_;
   unique_ptr<RandomAccessFileReader> file_reader_;
   unique_ptr<TableReader> table_reader_;
+  test::StringSource* source_ = nullptr;
   bool convert_to_internal_key_;
 
   TableConstructor();
@@ -1874,6 +1884,395 @@ void ValidateBlockRestartInterval(int value, int expected) {
   delete factory;
 }
 
+TEST_F(BlockBasedTableTest, FixedSizeFilterBlockPrefetch) {
+  constexpr int kNumKeys = 10000;
+
+  Options options;
+  BlockBasedTableOptions table_options;
+  table_options.cache_index_and_filter_blocks = true;
+  // Use small filter blocks, so the table has a lot of them.
+  table_options.filter_block_size = 1024;
+  table_options.filter_policy.reset(NewFixedSizeFilterPolicy(
+      table_options.filter_block_size * 8, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+      nullptr));
+
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i != kNumKeys; ++i) {
+    char user_key[16];
+    snprintf(user_key, sizeof(user_key), "key%06d", i);
+    c.Add(InternalKey(user_key, 0, kTypeValue).Encode().ToString(), "value");
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  {
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  }
+
+  // Reopens the table with fresh block cache and reads all keys in forward order. Returns number
+  // of filter block cache misses.
+  auto read_all_keys = [&](bool prefetch, yb::ThreadPool* prefetch_pool = nullptr) -> int64_t {
+    table_options.block_cache = NewLRUCache(16 * 1024 * 1024);
+    table_options.filter_blocks_in_multi_touch_cache = prefetch;
+    table_options.prefetch_next_filter_block = prefetch;
+    table_options.filter_block_prefetch_thread_pool = prefetch_pool;
+    options.statistics = CreateDBStatisticsForTests();
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+    const ImmutableCFOptions ioptions(options);
+    EXPECT_OK(c.Reopen(ioptions));
+    auto* reader = c.GetTableReader();
+    for (const auto& key : keys) {
+      std::string value;
+      GetContext get_context(options.comparator, nullptr, nullptr, nullptr,
+                             GetContext::kNotFound, ExtractUserKey(key), &value, nullptr,
+                             nullptr, nullptr);
+      EXPECT_OK(reader->Get(ReadOptions(), key, &get_context));
+      EXPECT_EQ(get_context.State(), GetContext::kFound);
+      if (prefetch_pool) {
+        // Let prefetch finish before the next key, so the number of misses is deterministic.
+        prefetch_pool->Wait();
+      }
+    }
+    size_t multi_touch_usage = 0;
+    for (const auto& usage : table_options.block_cache->TEST_GetIndividualUsages()) {
+      multi_touch_usage += usage.second;
+    }
+    // Data and index blocks are accessed by the same query id, so only filter blocks could get to
+    // the multi-touch cache.
+    EXPECT_EQ(prefetch, multi_touch_usage != 0);
+    return options.statistics->getTickerCount(BLOCK_CACHE_FILTER_MISS);
+  };
+
+  // Without prefetch each filter block is read on access.
+  const auto num_filter_blocks = read_all_keys(/* prefetch = */ false);
+  ASSERT_GT(num_filter_blocks, 2);
+  // Without prefetch pool filter blocks are not read in advance, so the read path does not do
+  // extra I/O.
+  ASSERT_EQ(read_all_keys(/* prefetch = */ true), num_filter_blocks);
+
+  // With prefetch only first two filter blocks are read on access, while each of the following
+  // ones is read in background when the scan enters the block before it.
+  std::unique_ptr<yb::ThreadPool> prefetch_pool;
+  ASSERT_OK(yb::ThreadPoolBuilder("filter_prefetch").set_max_threads(1).Build(&prefetch_pool));
+  ASSERT_LT(read_all_keys(/* prefetch = */ true, prefetch_pool.get()), num_filter_blocks);
+  // Table should be destroyed before the pool.
+  table_options.filter_block_prefetch_thread_pool = nullptr;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  const ImmutableCFOptions ioptions(options);
+  ASSERT_OK(c.Reopen(ioptions));
+}
+
+TEST_F(BlockBasedTableTest, CompressionDictionary) {
+  constexpr size_t kMaxDictBytes = 1024;
+  constexpr int kNumKeys = 2000;
+
+  std::vector<CompressionType> compression_types;
+  for (auto type : {kZlibCompression, kLZ4Compression, kZSTDNotFinalCompression}) {
+    if (CompressionDictionarySupported(type)) {
+      compression_types.push_back(type);
+    }
+  }
+  if (compression_types.empty()) {
+    fprintf(stderr, "skipping compression dictionary tests\n");
+    return;
+  }
+
+  Random rnd(301);
+  std::string tmp;
+  std::vector<std::string> values;
+  for (int i = 0; i != 16; ++i) {
+    values.push_back(CompressibleString(&rnd, 0.5, 100, &tmp).ToBuffer());
+  }
+  std::vector<std::pair<std::string, std::string>> key_values;
+  for (int i = 0; i != kNumKeys; ++i) {
+    char user_key[16];
+    snprintf(user_key, sizeof(user_key), "key%06d", i);
+    key_values.emplace_back(user_key, values[rnd.Uniform(static_cast<int>(values.size()))]);
+  }
+
+  for (auto type : compression_types) {
+    Options options;
+    options.compression = type;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    // Writes the table with the specified dictionary size, returns size of its data blocks.
+    auto write_table = [&](TableConstructor* c, size_t max_dict_bytes) {
+      options.compression_opts.max_dict_bytes = max_dict_bytes;
+      for (const auto& key_value : key_values) {
+        c->Add(key_value.first, key_value.second);
+      }
+      const ImmutableCFOptions ioptions(options);
+      c->Finish(options, ioptions, table_options,
+                GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+      return c->GetTableReader()->GetTableProperties()->data_size;
+    };
+
+    uint64_t data_size_without_dict;
+    {
+      TableConstructor c(BytewiseComparator());
+      data_size_without_dict = write_table(&c, 0);
+    }
+
+    TableConstructor c(BytewiseComparator());
+    const auto data_size = write_table(&c, kMaxDictBytes);
+    // Data blocks are written both before and after the dictionary is built.
+    ASSERT_GT(data_size, 16 * kMaxDictBytes);
+    ASSERT_LT(data_size, data_size_without_dict) << CompressionTypeToString(type);
+
+    // Dictionary is stored in its own meta block.
+    {
+      const auto& contents = c.GetSource()->contents();
+      std::unique_ptr<RandomAccessFileReader> file_reader(
+          test::GetRandomAccessFileReader(new test::StringSource(contents)));
+      BlockContents dict_contents;
+      ASSERT_OK(ReadMetaBlock(file_reader.get(), contents.size(), kBlockBasedTableMagicNumber,
+                              Env::Default(), block_based_table::kCompressionDictBlock,
+                              nullptr /* mem_tracker */, &dict_contents));
+      ASSERT_GT(dict_contents.data.size(), 0U);
+      ASSERT_LE(dict_contents.data.size(), kMaxDictBytes);
+    }
+
+    // Read blocks both through the uncompressed and the compressed block caches.
+    for (bool use_compressed_cache : {false, true}) {
+      table_options.block_cache = NewLRUCache(16 * 1024 * 1024);
+      if (use_compressed_cache) {
+        table_options.block_cache_compressed = NewLRUCache(16 * 1024 * 1024);
+      }
+      options.table_factory.reset(new BlockBasedTableFactory(table_options));
+      const ImmutableCFOptions ioptions(options);
+      ASSERT_OK(c.Reopen(ioptions));
+      // Read twice, to get blocks from the cache on the second pass.
+      for (int pass = 0; pass != 2; ++pass) {
+        std::unique_ptr<InternalIterator> iter(c.NewIterator());
+        auto it = kvmap.begin();
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++it) {
+          ASSERT_NE(it, kvmap.end());
+          ASSERT_EQ(it->first, iter->key().ToBuffer());
+          ASSERT_EQ(it->second, iter->value().ToBuffer());
+        }
+        ASSERT_OK(iter->status());
+        ASSERT_EQ(it, kvmap.end()) << CompressionTypeToString(type);
+      }
+    }
+  }
+}
+
+namespace {
+
+// Stores first key of the data block as its properties.
+class FirstKeyDataBlockPropertiesCollector : public DataBlockPropertiesCollector {
+ public:
+  void AddKey(const Slice& key) override {
+    if (first_key_.empty()) {
+      first_key_ = key.ToBuffer();
+    }
+  }
+
+  void FinishBlock(std::string* dest) override {
+    *dest = std::move(first_key_);
+    first_key_.clear();
+  }
+
+ private:
+  std::string first_key_;
+};
+
+class FirstKeyDataBlockPropertiesCollectorFactory : public DataBlockPropertiesCollectorFactory {
+ public:
+  std::unique_ptr<DataBlockPropertiesCollector> CreateCollector() const override {
+    return std::make_unique<FirstKeyDataBlockPropertiesCollector>();
+  }
+};
+
+// Skips data blocks with first key in [begin, end).
+class FirstKeyDataBlockFilter : public DataBlockFilter {
+ public:
+  FirstKeyDataBlockFilter(std::string begin, std::string end)
+      : begin_(std::move(begin)), end_(std::move(end)) {}
+
+  bool Filter(const Slice& block_properties) const override {
+    return block_properties.compare(begin_) < 0 || block_properties.compare(end_) >= 0;
+  }
+
+ private:
+  const std::string begin_;
+  const std::string end_;
+};
+
+} // namespace
+
+TEST_F(BlockBasedTableTest, DataBlockFilter) {
+  constexpr int kNumKeys = 2000;
+  constexpr int kSkipBegin = 500;
+  constexpr int kSkipEnd = 1500;
+  auto make_key = [](int i) {
+    char user_key[16];
+    snprintf(user_key, sizeof(user_key), "key%06d", i);
+    return std::string(user_key);
+  };
+
+  for (auto index_type : {IndexType::kBinarySearch, IndexType::kMultiLevelBinarySearch}) {
+    Options options;
+    options.compression = kNoCompression;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    table_options.index_block_size = 256;
+    table_options.min_keys_per_index_block = 4;
+    table_options.index_type = index_type;
+    table_options.data_block_properties_collector_factory =
+        std::make_shared<FirstKeyDataBlockPropertiesCollectorFactory>();
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+
+    Random rnd(301);
+    TableConstructor c(BytewiseComparator());
+    for (int i = 0; i != kNumKeys; ++i) {
+      c.Add(make_key(i), RandomString(&rnd, 100));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+    ASSERT_GT(c.GetTableReader()->GetTableProperties()->num_data_blocks, 20U);
+
+    // Without filter all keys are visible.
+    {
+      std::unique_ptr<InternalIterator> iter(c.NewIterator());
+      int num_keys = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        ++num_keys;
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(kNumKeys, num_keys);
+    }
+
+    ReadOptions read_options;
+    read_options.data_block_filter = std::make_shared<FirstKeyDataBlockFilter>(
+        make_key(kSkipBegin), make_key(kSkipEnd));
+    std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(read_options));
+    std::vector<std::string> visible_keys;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      visible_keys.push_back(iter->key().ToBuffer());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_LT(visible_keys.size(), static_cast<size_t>(kNumKeys));
+    ASSERT_TRUE(std::is_sorted(visible_keys.begin(), visible_keys.end()));
+    std::set<std::string> visible_set(visible_keys.begin(), visible_keys.end());
+    for (int i = 0; i != kNumKeys; ++i) {
+      const auto key = make_key(i);
+      if (i < kSkipBegin) {
+        // Blocks starting before skipped range are always read.
+        ASSERT_EQ(1, visible_set.count(key)) << key;
+      } else if (i >= kSkipBegin + 100 && i < kSkipEnd) {
+        // Blocks are much smaller than 100 entries, so these keys are in skipped blocks.
+        ASSERT_EQ(0, visible_set.count(key)) << key;
+      } else if (i >= kSkipEnd + 100) {
+        ASSERT_EQ(1, visible_set.count(key)) << key;
+      }
+    }
+
+    // Seek into skipped block moves to the first block that is not skipped.
+    iter->Seek(make_key(kSkipBegin + 200));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_GE(iter->key().ToBuffer(), make_key(kSkipEnd));
+    ASSERT_LT(iter->key().ToBuffer(), make_key(kSkipEnd + 100));
+
+    // Backward iteration skips the same blocks.
+    std::vector<std::string> reverse_keys;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      reverse_keys.push_back(iter->key().ToBuffer());
+    }
+    ASSERT_OK(iter->status());
+    std::reverse(reverse_keys.begin(), reverse_keys.end());
+    ASSERT_EQ(visible_keys, reverse_keys);
+  }
+}
+
+TEST_F(BlockBasedTableTest, SequentialScanReadahead) {
+  constexpr int kNumKeys = 2000;
+  constexpr size_t kMaxReadaheadSize = 16_KB;
+
+  Options options;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.max_auto_readahead_size = kMaxReadaheadSize;
+
+  Random rnd(301);
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i != kNumKeys; ++i) {
+    char user_key[16];
+    snprintf(user_key, sizeof(user_key), "key%06d", i);
+    c.Add(user_key, RandomString(&rnd, 100));
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  {
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  }
+  const auto num_data_blocks = c.GetTableReader()->GetTableProperties()->num_data_blocks;
+  const auto data_size = c.GetTableReader()->GetTableProperties()->data_size;
+
+  auto scan = [&c]() {
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    int num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, num_keys);
+  };
+
+  for (size_t cache_bypass_size : {0_KB, 8_KB}) {
+    table_options.block_cache = NewLRUCache(16_MB);
+    table_options.sequential_scan_cache_bypass_size = cache_bypass_size;
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+    const ImmutableCFOptions ioptions(options);
+    ASSERT_OK(c.Reopen(ioptions));
+
+    // Point reads don't trigger readahead.
+    {
+      std::unique_ptr<InternalIterator> iter(c.NewIterator());
+      for (int i = 0; i < kNumKeys; i += 100) {
+        iter->Seek(keys[i]);
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(keys[i], iter->key().ToBuffer());
+      }
+    }
+    ASSERT_TRUE(c.GetSource()->prefetched_ranges().empty());
+
+    // Full scan reads ahead with growing readahead size.
+    ASSERT_NO_FATALS(scan());
+    const auto& ranges = c.GetSource()->prefetched_ranges();
+    ASSERT_FALSE(ranges.empty());
+    ASSERT_LT(ranges.size(), num_data_blocks / 4);
+    for (size_t i = 0; i != ranges.size(); ++i) {
+      ASSERT_LE(ranges[i].second, kMaxReadaheadSize);
+      if (i > 0) {
+        // Next readahead is issued when the scan reaches the end of the previous one.
+        ASSERT_GT(ranges[i].first, ranges[i - 1].first);
+        ASSERT_LE(ranges[i].first, ranges[i - 1].first + ranges[i - 1].second);
+        ASSERT_GE(ranges[i].second, ranges[i - 1].second);
+      }
+    }
+    ASSERT_EQ(kMaxReadaheadSize, ranges.back().second);
+
+    if (cache_bypass_size == 0) {
+      ASSERT_GT(table_options.block_cache->GetUsage(), data_size / 2);
+    } else {
+      // Only blocks read before scan became long enough are cached. Point reads above cached
+      // some blocks as well.
+      ASSERT_LT(table_options.block_cache->GetUsage(), data_size / 4);
+    }
+  }
+}
+
 TEST_F(BlockBasedTableTest, InvalidOptions) {
   // invalid values for block_size_deviation (<0 or >100) are silently set to 0
   ValidateBlockSizeDeviation(-10, 0);
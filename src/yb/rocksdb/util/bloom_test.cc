@@ -234,7 +234,30 @@ class FixedSizeFilterBloomTestContext : public BloomTestContext {
           nullptr)};
 };
 
-YB_DEFINE_ENUM(BuilderReaderBloomTestType, (kFullFilter)(kFixedSizeFilter));
+class FixedSizeRibbonFilterTestContext : public BloomTestContext {
+ public:
+  const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
+
+  size_t max_keys() const override { return std::numeric_limits<size_t>::max(); }
+
+  void CheckFilterSize(size_t filter_size, size_t num_keys) const override {
+    ASSERT_LE(filter_size, FilterPolicy::kDefaultFixedSizeFilterBits / 8 + 8) << num_keys;
+    // Ribbon filter should use less than 8 bits per key for 1% false positive rate, while Bloom
+    // filter needs ~10.
+    if (num_keys >= 10000) {
+      ASSERT_LE(filter_size, num_keys) << num_keys;
+    }
+  }
+
+ private:
+  std::unique_ptr<const FilterPolicy> filter_policy_{
+      NewFixedSizeRibbonFilterPolicy(
+          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+          nullptr)};
+};
+
+YB_DEFINE_ENUM(BuilderReaderBloomTestType,
+               (kFullFilter)(kFixedSizeFilter)(kFixedSizeRibbonFilter));
 
 namespace {
 
@@ -244,6 +267,8 @@ std::unique_ptr<const BloomTestContext> CreateContext(BuilderReaderBloomTestType
       return std::make_unique<FullFilterBloomTestContext>();
     case BuilderReaderBloomTestType::kFixedSizeFilter:
       return std::make_unique<FixedSizeFilterBloomTestContext>();
+    case BuilderReaderBloomTestType::kFixedSizeRibbonFilter:
+      return std::make_unique<FixedSizeRibbonFilterTestContext>();
   }
   FATAL_INVALID_ENUM_VALUE(BuilderReaderBloomTestType, type);
 }
@@ -372,7 +397,8 @@ TEST_P(BuilderReaderBloomTest, FullVaryingLengths) {
 
 INSTANTIATE_TEST_CASE_P(, BuilderReaderBloomTest, ::testing::Values(
     BuilderReaderBloomTestType::kFullFilter,
-    BuilderReaderBloomTestType::kFixedSizeFilter));
+    BuilderReaderBloomTestType::kFixedSizeFilter,
+    BuilderReaderBloomTestType::kFixedSizeRibbonFilter));
 
 }  // namespace rocksdb
 
@@ -25,6 +25,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "yb/util/metrics.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/statistics.h"
@@ -35,7 +39,9 @@
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/locks.h"
 #include "yb/util/random_util.h"
+#include "yb/util/shared_lock.h"
 
 // 0 value means that there exist no single_touch cache and
 // 1 means that the entire cache is treated as a multi-touch cache.
@@ -838,11 +844,572 @@ void LRUCache::Erase(const Slice& key, uint32_t hash) {
   }
 }
 
+// CLOCK cache implementation
+
+// Unlike LRUHandle, ClockHandle is not moved between lists on access, so Lookup only has to find
+// the handle in the hash table, bump its reference counter and set its clock bit. All of that is
+// done under the shared lock of the shard, so concurrent lookups don't serialize on each other.
+// Insert, Erase and eviction take the lock in exclusive mode.
+//
+// state combines the reference counter with the in_cache flag, so the last owner of the handle,
+// i.e. the thread that drops the last external reference or removes the handle from the table,
+// is determined by a single atomic operation and no lock is required in Release.
+//
+// Scan resistance is the same as in LRUCache. Handles inserted by a query are single-touch, and
+// they are promoted to multi-touch when looked up by a different query. Each kind of handles has
+// its own capacity, and eviction only considers handles of the kind that is over its capacity.
+struct ClockHandle {
+  static constexpr uint32_t kInCacheFlag = 1;
+  static constexpr uint32_t kOneRef = 2;
+
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash;
+  size_t charge;
+  size_t key_length;
+  size_t clock_index; // Position in the clock ring of the shard.
+  uint32_t hash;      // Hash of key(); used for fast sharding and comparisons
+  std::atomic<uint32_t> state;
+  std::atomic<bool> referenced; // The clock bit.
+  std::atomic<QueryId> query_id;
+  char key_data[1];   // Beginning of key
+
+  static ClockHandle* Create(const Slice& key) {
+    char* memory = new char[sizeof(ClockHandle) - 1 + key.size()];
+    return new (memory) ClockHandle();
+  }
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+
+  void Free() {
+    assert(state.load(std::memory_order_relaxed) == 0);
+    (*deleter)(key(), value);
+    this->~ClockHandle();
+    delete[] reinterpret_cast<char*>(this);
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return query_id.load(std::memory_order_acquire) == kInMultiTouchId ? MULTI_TOUCH
+                                                                        : SINGLE_TOUCH;
+  }
+};
+
+// Hash table of the clock cache shard. Modified only under the exclusive lock of the shard.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() { Resize(); }
+
+  ~ClockHandleTable() {
+    delete[] list_;
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > length_) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) const {
+    ClockHandle** ptr = &list_[hash & (length_ - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    uint32_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    ClockHandle** new_list = new ClockHandle*[new_length];
+    memset(new_list, 0, sizeof(new_list[0]) * new_length);
+    for (uint32_t i = 0; i < length_; i++) {
+      ClockHandle* h = list_[i];
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash;
+        ClockHandle** ptr = &new_list[h->hash & (new_length - 1)];
+        h->next_hash = *ptr;
+        *ptr = h;
+        h = next;
+      }
+    }
+    delete[] list_;
+    list_ = new_list;
+    length_ = new_length;
+  }
+
+  uint32_t length_ = 0;
+  uint32_t elems_ = 0;
+  ClockHandle** list_ = nullptr;
+};
+
+class ClockHandleDeleter {
+ public:
+  void Add(ClockHandle* handle) {
+    handles_.push_back(handle);
+  }
+
+  size_t TotalCharge() const {
+    size_t result = 0;
+    for (ClockHandle* handle : handles_) {
+      result += handle->charge;
+    }
+    return result;
+  }
+
+  ~ClockHandleDeleter() {
+    for (ClockHandle* handle : handles_) {
+      handle->Free();
+    }
+  }
+
+ private:
+  autovector<ClockHandle*> handles_;
+};
+
+// A single shard of sharded clock cache.
+class ClockCache {
+ public:
+  ClockCache() = default;
+  ~ClockCache();
+
+  void SetCapacity(size_t capacity);
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = metrics;
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit);
+
+  // Like Cache methods, but with an extra "hash" parameter.
+  Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                        Statistics* statistics = nullptr);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return single_touch_usage_.load(std::memory_order_relaxed) +
+           multi_touch_usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const;
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() {
+    return std::pair<size_t, size_t>(
+        single_touch_usage_.load(std::memory_order_relaxed),
+        multi_touch_usage_.load(std::memory_order_relaxed));
+  }
+
+ private:
+  std::atomic<size_t>& Usage(SubCacheType subcache_type) {
+    return subcache_type == MULTI_TOUCH ? multi_touch_usage_ : single_touch_usage_;
+  }
+
+  // Same as LRUCache::GetSubCacheCapacity.
+  size_t GetSubCacheCapacity(SubCacheType subcache_type);
+
+  void AddToClock(ClockHandle* e);
+
+  // Removes the handle from the table and from the clock ring. Should be called under the
+  // exclusive lock. Returns true if the cache held the last reference to the handle.
+  bool Remove(ClockHandle* e);
+
+  // Moves the clock hand over the handles of the specified sub cache, clearing their clock bits
+  // and evicting unreferenced handles whose clock bit is already cleared, until there is enough
+  // space to hold charge. Gives up after two full turns, i.e. when all remaining handles are in
+  // use. Should be called under the exclusive lock.
+  void EvictFromClock(size_t charge, ClockHandleDeleter* deleted, SubCacheType subcache_type);
+
+  void IncrementUsage(SubCacheType subcache_type, size_t charge);
+  void DecrementUsage(SubCacheType subcache_type, size_t charge);
+
+  size_t total_capacity_ = 0;
+  size_t multi_touch_capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+
+  std::atomic<size_t> single_touch_usage_{0};
+  std::atomic<size_t> multi_touch_usage_{0};
+
+  // Lookup takes mutex_ in shared mode, all other operations that modify table_ and clock_ take it
+  // in exclusive mode.
+  mutable yb::rw_spinlock mutex_;
+
+  ClockHandleTable table_;
+
+  // Handles residing in the cache, in the order the clock hand visits them.
+  std::vector<ClockHandle*> clock_;
+  size_t clock_hand_ = 0;
+
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+ClockCache::~ClockCache() {
+  for (ClockHandle* e : clock_) {
+    DecrementUsage(e->GetSubCacheType(), e->charge);
+    if (e->state.fetch_and(~ClockHandle::kInCacheFlag) == ClockHandle::kInCacheFlag) {
+      e->Free();
+    }
+  }
+}
+
+size_t ClockCache::GetSubCacheCapacity(const SubCacheType subcache_type) {
+  switch (subcache_type) {
+    case SINGLE_TOUCH :
+      if (strict_capacity_limit_ || !FLAGS_cache_overflow_single_touch) {
+        return total_capacity_ - multi_touch_capacity_;
+      }
+      return total_capacity_ - multi_touch_usage_.load(std::memory_order_relaxed);
+    case MULTI_TOUCH :
+      return multi_touch_capacity_;
+  }
+  FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
+}
+
+void ClockCache::IncrementUsage(const SubCacheType subcache_type, const size_t charge) {
+  Usage(subcache_type).fetch_add(charge, std::memory_order_relaxed);
+  if (metrics_ != nullptr) {
+    if (subcache_type == MULTI_TOUCH) {
+      metrics_->multi_touch_cache_usage->IncrementBy(charge);
+    } else {
+      metrics_->single_touch_cache_usage->IncrementBy(charge);
+    }
+    metrics_->cache_usage->IncrementBy(charge);
+  }
+}
+
+void ClockCache::DecrementUsage(const SubCacheType subcache_type, const size_t charge) {
+  Usage(subcache_type).fetch_sub(charge, std::memory_order_relaxed);
+  if (metrics_ != nullptr) {
+    if (subcache_type == MULTI_TOUCH) {
+      metrics_->multi_touch_cache_usage->DecrementBy(charge);
+    } else {
+      metrics_->single_touch_cache_usage->DecrementBy(charge);
+    }
+    metrics_->cache_usage->DecrementBy(charge);
+  }
+}
+
+void ClockCache::AddToClock(ClockHandle* e) {
+  e->clock_index = clock_.size();
+  clock_.push_back(e);
+}
+
+bool ClockCache::Remove(ClockHandle* e) {
+  table_.Remove(e->key(), e->hash);
+  // Move the last handle to the freed position, the clock hand will visit it on the next turn.
+  ClockHandle* last = clock_.back();
+  clock_[e->clock_index] = last;
+  last->clock_index = e->clock_index;
+  clock_.pop_back();
+  DecrementUsage(e->GetSubCacheType(), e->charge);
+  return e->state.fetch_and(~ClockHandle::kInCacheFlag) == ClockHandle::kInCacheFlag;
+}
+
+void ClockCache::EvictFromClock(const size_t charge,
+                                ClockHandleDeleter* deleted,
+                                const SubCacheType subcache_type) {
+  const size_t capacity = GetSubCacheCapacity(subcache_type);
+  std::atomic<size_t>& usage = Usage(subcache_type);
+  size_t steps_left = clock_.size() * 2;
+  while (usage.load(std::memory_order_relaxed) + charge > capacity && steps_left > 0 &&
+         !clock_.empty()) {
+    --steps_left;
+    if (clock_hand_ >= clock_.size()) {
+      clock_hand_ = 0;
+    }
+    ClockHandle* e = clock_[clock_hand_];
+    // Handles that are referenced externally could not be evicted.
+    if (e->GetSubCacheType() != subcache_type ||
+        e->state.load(std::memory_order_acquire) != ClockHandle::kInCacheFlag) {
+      ++clock_hand_;
+      continue;
+    }
+    if (e->referenced.load(std::memory_order_relaxed)) {
+      e->referenced.store(false, std::memory_order_relaxed);
+      ++clock_hand_;
+      continue;
+    }
+    // Lookup does not run concurrently, so nobody could acquire the reference to this handle.
+    // Remove places another handle at the position of the clock hand, so we don't advance it.
+    if (Remove(e)) {
+      deleted->Add(e);
+    }
+  }
+}
+
+void ClockCache::SetCapacity(size_t capacity) {
+  ClockHandleDeleter last_reference_list;
+
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
+    total_capacity_ = capacity;
+    EvictFromClock(0, &last_reference_list, MULTI_TOUCH);
+    EvictFromClock(0, &last_reference_list, SINGLE_TOUCH);
+  }
+}
+
+void ClockCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
+  std::lock_guard<yb::rw_spinlock> l(mutex_);
+  // See LRUCache::SetStrictCapacityLimit.
+  assert(GetUsage() == 0 || !FLAGS_cache_overflow_single_touch);
+  strict_capacity_limit_ = strict_capacity_limit;
+}
+
+Cache::Handle* ClockCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                                  Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::SharedLock<yb::rw_spinlock> l(mutex_);
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      e->state.fetch_add(ClockHandle::kOneRef, std::memory_order_acq_rel);
+      // Avoid writing to the cache line when the clock bit is already set.
+      if (!e->referenced.load(std::memory_order_relaxed)) {
+        e->referenced.store(true, std::memory_order_relaxed);
+      }
+
+      // Promote to multi-touch when accessed by another query. Space is reclaimed from the multi
+      // touch handles by the next insert into this shard.
+      QueryId old_query_id = e->query_id.load(std::memory_order_acquire);
+      if (FLAGS_cache_single_touch_ratio < 1 && old_query_id != kInMultiTouchId &&
+          old_query_id != query_id &&
+          (!strict_capacity_limit_ ||
+           multi_touch_usage_.load(std::memory_order_relaxed) + e->charge <=
+               multi_touch_capacity_) &&
+          e->query_id.compare_exchange_strong(old_query_id, kInMultiTouchId)) {
+        DecrementUsage(SINGLE_TOUCH, e->charge);
+        IncrementUsage(MULTI_TOUCH, e->charge);
+      }
+    }
+  }
+
+  if (e != nullptr) {
+    if (statistics != nullptr) {
+      // overall cache hit
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      // total bytes read from cache
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+      if (e->GetSubCacheType() == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+      }
+    }
+  } else if (statistics != nullptr) {
+    RecordTick(statistics, BLOCK_CACHE_MISS);
+  }
+
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::Release(Cache::Handle* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+  // When the handle is still in cache, it stays there until it is evicted by the clock hand.
+  if (e->state.fetch_sub(ClockHandle::kOneRef, std::memory_order_acq_rel) ==
+          ClockHandle::kOneRef) {
+    e->Free();
+  }
+}
+
+size_t ClockCache::Evict(size_t required) {
+  ClockHandleDeleter evicted;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    EvictFromClock(required, &evicted, SINGLE_TOUCH);
+    if (required > evicted.TotalCharge()) {
+      EvictFromClock(required, &evicted, MULTI_TOUCH);
+    }
+  }
+  return evicted.TotalCharge();
+}
+
+Status ClockCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                          void* value, size_t charge,
+                          void (*deleter)(const Slice& key, void* value),
+                          Cache::Handle** handle, Statistics* statistics) {
+  // Don't use the cache if disabled by the caller using the special query id.
+  if (query_id == kNoCacheQueryId) {
+    return Status::OK();
+  }
+  ClockHandle* e = ClockHandle::Create(key);
+  e->value = value;
+  e->deleter = deleter;
+  e->charge = charge;
+  e->key_length = key.size();
+  e->hash = hash;
+  e->state.store(ClockHandle::kInCacheFlag + (handle == nullptr ? 0 : ClockHandle::kOneRef),
+                 std::memory_order_relaxed);
+  e->referenced.store(false, std::memory_order_relaxed);
+  e->query_id.store(query_id, std::memory_order_relaxed);
+  memcpy(e->key_data, key.data(), key.size());
+
+  Status s;
+  ClockHandleDeleter last_reference_list;
+  SubCacheType subcache_type;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    if (FLAGS_cache_single_touch_ratio == 0) {
+      subcache_type = MULTI_TOUCH;
+    } else if (FLAGS_cache_single_touch_ratio == 1) {
+      subcache_type = SINGLE_TOUCH;
+    } else if (query_id == kInMultiTouchId) {
+      // Same as HandleTable::GetSubCacheTypeCandidate.
+      subcache_type = MULTI_TOUCH;
+    } else {
+      ClockHandle* existing = table_.Lookup(key, hash);
+      subcache_type = existing != nullptr && (existing->GetSubCacheType() == MULTI_TOUCH ||
+                                              existing->query_id.load() != query_id)
+          ? MULTI_TOUCH : SINGLE_TOUCH;
+    }
+    // Remove and eviction use the query id to find the sub cache the handle is charged to.
+    if (subcache_type == MULTI_TOUCH) {
+      e->query_id.store(kInMultiTouchId, std::memory_order_relaxed);
+    } else if (query_id == kInMultiTouchId) {
+      e->query_id.store(kDefaultQueryId, std::memory_order_relaxed);
+    }
+    EvictFromClock(charge, &last_reference_list, subcache_type);
+    if (strict_capacity_limit_ &&
+        Usage(subcache_type).load(std::memory_order_relaxed) + charge >
+            GetSubCacheCapacity(subcache_type)) {
+      if (handle == nullptr) {
+        e->state.store(0, std::memory_order_relaxed);
+        last_reference_list.Add(e);
+      } else {
+        e->~ClockHandle();
+        delete[] reinterpret_cast<char*>(e);
+        *handle = nullptr;
+      }
+      s = STATUS(Incomplete, "Insert failed due to clock cache being full.");
+    } else {
+      ClockHandle* old = table_.Lookup(key, hash);
+      if (old != nullptr && Remove(old)) {
+        last_reference_list.Add(old);
+      }
+      table_.Insert(e);
+      AddToClock(e);
+      IncrementUsage(subcache_type, charge);
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (subcache_type == MULTI_TOUCH && FLAGS_cache_single_touch_ratio != 0) {
+        // See LRUCache::Insert.
+        EvictFromClock(0, &last_reference_list, SINGLE_TOUCH);
+      }
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      if (subcache_type == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+  return s;
+}
+
+void ClockCache::Erase(const Slice& key, uint32_t hash) {
+  ClockHandle* e;
+  bool last_reference = false;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      last_reference = Remove(e);
+    }
+  }
+  // mutex not held here
+  // last_reference will only be true if e != nullptr
+  if (last_reference) {
+    e->Free();
+  }
+}
+
+size_t ClockCache::GetPinnedUsage() const {
+  yb::SharedLock<yb::rw_spinlock> l(mutex_);
+  size_t result = 0;
+  for (ClockHandle* e : clock_) {
+    if (e->state.load(std::memory_order_relaxed) >= ClockHandle::kOneRef) {
+      result += e->charge;
+    }
+  }
+  return result;
+}
+
+void ClockCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
+                                        bool thread_safe) {
+  if (thread_safe) {
+    mutex_.lock_shared();
+  }
+  for (ClockHandle* e : clock_) {
+    callback(e->value, e->charge);
+  }
+  if (thread_safe) {
+    mutex_.unlock_shared();
+  }
+}
+
 static int kNumShardBits = 4;          // default values, can be overridden
 
-class ShardedLRUCache : public Cache {
+// Cache that consists of 2^num_shard_bits shards of type ShardType, distributed by hash of the key.
+template <class ShardType, class ShardHandle>
+class ShardedCache : public Cache {
  private:
-  LRUCache* shards_;
+  ShardType* shards_;
   port::Mutex id_mutex_;
   port::Mutex capacity_mutex_;
   uint64_t last_id_;
@@ -865,15 +1432,14 @@ class ShardedLRUCache : public Cache {
   }
 
  public:
-  ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+  ShardedCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
         strict_capacity_limit_(strict_capacity_limit),
         metrics_(nullptr) {
     int num_shards = 1 << num_shard_bits_;
-    shards_ = new LRUCache[num_shards];
+    shards_ = new ShardType[num_shards];
     const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
@@ -881,7 +1447,7 @@ class ShardedLRUCache : public Cache {
     }
   }
 
-  virtual ~ShardedLRUCache() {
+  virtual ~ShardedCache() {
     delete[] shards_;
   }
 
@@ -930,7 +1496,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void Release(Handle* handle) override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(handle);
+    ShardHandle* h = reinterpret_cast<ShardHandle*>(handle);
     shards_[Shard(h->hash)].Release(handle);
   }
 
@@ -940,7 +1506,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void* Value(Handle* handle) override {
-    return reinterpret_cast<LRUHandle*>(handle)->value;
+    return reinterpret_cast<ShardHandle*>(handle)->value;
   }
 
   uint64_t NewId() override {
@@ -965,7 +1531,7 @@ class ShardedLRUCache : public Cache {
   }
 
   size_t GetUsage(Handle* handle) const override {
-    return reinterpret_cast<LRUHandle*>(handle)->charge;
+    return reinterpret_cast<ShardHandle*>(handle)->charge;
   }
 
   size_t GetPinnedUsage() const override {
@@ -979,7 +1545,7 @@ class ShardedLRUCache : public Cache {
   }
 
   SubCacheType GetSubCacheType(Handle* e) const override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(e);
+    ShardHandle* h = reinterpret_cast<ShardHandle*>(e);
     return h->GetSubCacheType();
   }
 
@@ -1014,6 +1580,9 @@ class ShardedLRUCache : public Cache {
   }
 };
 
+using ShardedLRUCache = ShardedCache<LRUCache, LRUHandle>;
+using ShardedClockCache = ShardedCache<ClockCache, ClockHandle>;
+
 }  // end anonymous namespace
 
 shared_ptr<Cache> NewLRUCache(size_t capacity) {
@@ -1033,4 +1602,17 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                            strict_capacity_limit);
 }
 
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits) {
+  return NewClockCache(capacity, num_shard_bits, false);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits,
+                                             strict_capacity_limit);
+}
+
 }  // namespace rocksdb
@@ -49,6 +49,7 @@ DEFINE_int32(threads, 16, "Number of concurrent threads to run.");
 DEFINE_int64(cache_size, 8 * KB * KB,
              "Number of bytes to use as a cache of uncompressed data.");
 DEFINE_int32(num_shard_bits, 4, "shard_bits.");
+DEFINE_string(cache_type, "lru", "Type of the cache to benchmark: lru or clock.");
 
 DEFINE_int64(max_key, 1 * KB * KB * KB, "Max number of key to place in cache");
 DEFINE_uint64(ops_per_thread, 1200000, "Number of operations per thread.");
@@ -145,7 +146,8 @@ struct ThreadState {
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(FLAGS_cache_type == "clock" ? NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits)
+                                         : NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,7 +159,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
     }
   }
 
@@ -228,6 +230,8 @@ class CacheBench {
   }
 
   void OperateCache(ThreadState* thread) {
+    // Each thread acts as a separate query, so entries shared by threads become multi-touch.
+    const QueryId query_id = thread->tid + 1;
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
       uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
@@ -235,11 +239,11 @@ class CacheBench {
       int32_t prob_op = thread->rnd.Uniform(100);
       if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
+        cache_->Insert(key, query_id, new char[10], 1, &deleter);
       } else if (prob_op -= FLAGS_insert_percent &&
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        auto handle = cache_->Lookup(key, query_id);
         if (handle) {
           cache_->Release(handle);
         }
@@ -255,6 +259,7 @@ class CacheBench {
     printf("Number of threads   : %d\n", FLAGS_threads);
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %" PRIu64 "\n", FLAGS_cache_size);
+    printf("Cache type          : %s\n", FLAGS_cache_type.c_str());
     printf("Num shard bits      : %d\n", FLAGS_num_shard_bits);
     printf("Max key             : %" PRIu64 "\n", FLAGS_max_key);
     printf("Populate cache      : %d\n", FLAGS_populate_cache);
@@ -23,10 +23,14 @@
 
 #include "yb/rocksdb/cache.h"
 
+#include <atomic>
+#include <chrono>
 #include <forward_list>
+#include <thread>
 #include <vector>
 #include <string>
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/random.h"
 #include "yb/util/string_util.h"
 #include <gtest/gtest.h>
 #include "yb/util/test_macros.h"
@@ -740,6 +744,160 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, ClockCacheHitAndMiss) {
+  auto cache = NewClockCache(kCacheSize, kNumShardBits);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(-1, Lookup(cache, 200));
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Cache::Handle* h = cache->Lookup(EncodeKey(100), kTestQueryId);
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  // Erased entry is alive while referenced.
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(102, DecodeValue(cache->Value(h)));
+  cache->Release(h);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheEvictionPolicy) {
+  const int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0);
+  for (int i = 0; i < kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1));
+  }
+  // Lookup sets the clock bit, so the entry survives the first turn of the clock hand.
+  ASSERT_EQ(1, Lookup(cache, 0));
+  ASSERT_OK(Insert(cache, kCapacity, kCapacity + 1));
+  ASSERT_EQ(1, Lookup(cache, 0));
+  ASSERT_EQ(-1, Lookup(cache, 1));
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // Referenced entries are not evicted.
+  Cache::Handle* h = cache->Lookup(EncodeKey(2), kTestQueryId);
+  ASSERT_NE(nullptr, h);
+  for (int i = 0; i < kCapacity * 3; ++i) {
+    ASSERT_OK(Insert(cache, 1000 + i, i));
+  }
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+  cache->Release(h);
+  ASSERT_EQ(3, Lookup(cache, 2));
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheMultiTouch) {
+  QueryId qid1 = 1000;
+  QueryId qid2 = 1001;
+  auto cache = NewClockCache(kCacheSize, 0);
+  ASSERT_OK(Insert(cache, 100, 101, 1, qid1));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(cache, 100, 101, qid1));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 100, 101, qid2));
+  ASSERT_OK(Insert(cache, 200, 201, 1, qid1));
+
+  // A scan of single touch entries should not evict the multi touch entry.
+  for (int i = 0; i < kCacheSize * 2; i++) {
+    ASSERT_OK(Insert(cache, 1000 + i, 2000 + i));
+    ASSERT_EQ(2000 + i, Lookup(cache, 1000 + i));
+  }
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 100, 101, qid2));
+  ASSERT_EQ(-1, Lookup(cache, 200));
+  ASSERT_EQ(kCacheSize, cache->GetUsage());
+  auto usages = cache->TEST_GetIndividualUsages();
+  ASSERT_EQ(1, usages.size());
+  ASSERT_EQ(kCacheSize - 1, usages[0].first);
+  ASSERT_EQ(1, usages[0].second);
+}
+
+TEST_F(CacheTest, ClockCacheInsertIntoMultiTouch) {
+  auto cache = NewClockCache(kCacheSize, 0);
+  ASSERT_OK(Insert(cache, 100, 101, 1, kInMultiTouchId));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 100, 101, kTestQueryId));
+  auto usages = cache->TEST_GetIndividualUsages();
+  ASSERT_EQ(0, usages[0].first);
+  ASSERT_EQ(1, usages[0].second);
+
+  // A scan of single touch entries should not evict the multi touch entry.
+  for (int i = 0; i < kCacheSize * 2; i++) {
+    ASSERT_OK(Insert(cache, 1000 + i, 2000 + i));
+  }
+  ASSERT_EQ(101, Lookup(cache, 100));
+
+  Erase(cache, 100);
+  usages = cache->TEST_GetIndividualUsages();
+  ASSERT_EQ(kCacheSize - 1, usages[0].first);
+  ASSERT_EQ(0, usages[0].second);
+  ASSERT_EQ(kCacheSize - 1, cache->GetUsage());
+}
+
+namespace {
+
+// Runs mostly lookups from several threads against the cache and returns number of operations
+// per second.
+double ConcurrentLookupsPerSecond(const std::shared_ptr<Cache>& cache, int num_keys) {
+  constexpr int kNumThreads = 8;
+  constexpr int kOpsPerThread = 200000;
+  constexpr int kInsertPercent = 5;
+
+  for (int i = 0; i != num_keys; ++i) {
+    EXPECT_OK(cache->Insert(EncodeKey(i), kDefaultQueryId, EncodeValue(i), 1, dumbDeleter));
+  }
+
+  std::atomic<int> wrong_values(0);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&cache, &wrong_values, num_keys, t] {
+      Random rnd(t + 1);
+      const QueryId query_id = t + 1;
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        const int key = rnd.Uniform(num_keys * 2);
+        if (rnd.Uniform(100) < kInsertPercent) {
+          WARN_NOT_OK(cache->Insert(EncodeKey(key), query_id, EncodeValue(key), 1, dumbDeleter),
+                      "Insert failed");
+          continue;
+        }
+        Cache::Handle* handle = cache->Lookup(EncodeKey(key), query_id);
+        if (handle != nullptr) {
+          if (DecodeValue(cache->Value(handle)) != key) {
+            ++wrong_values;
+          }
+          cache->Release(handle);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(0, wrong_values.load());
+  return kNumThreads * kOpsPerThread / elapsed.count();
+}
+
+} // namespace
+
+TEST_F(CacheTest, ClockCacheConcurrentLookups) {
+  constexpr int kNumKeys = 100000;
+  for (bool clock : {false, true}) {
+    auto cache = clock ? NewClockCache(kNumKeys, kNumShardBits)
+                       : NewLRUCache(kNumKeys, kNumShardBits);
+    auto ops_per_second = ConcurrentLookupsPerSecond(cache, kNumKeys);
+    LOG(INFO) << (clock ? "Clock" : "LRU") << " cache: " << ops_per_second << " ops/s";
+    ASSERT_LE(cache->GetUsage(), kNumKeys);
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
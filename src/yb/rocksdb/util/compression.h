@@ -30,6 +30,10 @@
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
 
+#include "yb/gutil/macros.h"
+
+#include "yb/util/slice.h"
+
 #ifdef SNAPPY
 #include <snappy.h>
 #endif
@@ -110,6 +114,25 @@ inline bool CompressionTypeSupported(CompressionType compression_type) {
   }
 }
 
+// Returns true if blocks compressed with specified compression type could share compression
+// dictionary.
+inline bool CompressionDictionarySupported(CompressionType compression_type) {
+  switch (compression_type) {
+    case kZlibCompression:
+      return Zlib_Supported();
+    case kLZ4Compression:
+#if defined(LZ4) && LZ4_VERSION_NUMBER >= 10400  // r124+
+      return true;
+#else
+      return false;
+#endif
+    case kZSTDNotFinalCompression:
+      return ZSTD_Supported();
+    default:
+      return false;
+  }
+}
+
 inline std::string CompressionTypeToString(CompressionType compression_type) {
   switch (compression_type) {
     case kNoCompression:
@@ -195,10 +218,13 @@ inline bool GetDecompressedSizeInfo(const char** input_data,
 // block header
 // compress_format_version == 2 -- decompressed size is included in the block
 // header in varint32 format
+// compression_dict -- preset dictionary shared by compressed blocks, the same dictionary should be
+// passed to Zlib_Uncompress.
 inline bool Zlib_Compress(const CompressionOptions& opts,
                           uint32_t compress_format_version,
                           const char* input, size_t length,
-                          ::std::string* output) {
+                          ::std::string* output,
+                          const Slice& compression_dict = Slice()) {
 #ifdef ZLIB
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -228,6 +254,16 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
     return false;
   }
 
+  if (!compression_dict.empty()) {
+    st = deflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(compression_dict.data()),
+        static_cast<unsigned int>(compression_dict.size()));
+    if (st != Z_OK) {
+      deflateEnd(&_stream);
+      return false;
+    }
+  }
+
   // Compress the input, and put compressed data in output.
   _stream.next_in = (Bytef *)input;
   _stream.avail_in = static_cast<unsigned int>(length);
@@ -268,7 +304,8 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
 inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
                              int* decompress_size,
                              uint32_t compress_format_version,
-                             int windowBits = -14) {
+                             int windowBits = -14,
+                             const Slice& compression_dict = Slice()) {
 #ifdef ZLIB
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -297,6 +334,18 @@ inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
+  // For raw inflate dictionary should be set before decompression, otherwise inflate requests it
+  // with Z_NEED_DICT.
+  if (windowBits < 0 && !compression_dict.empty()) {
+    st = inflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(compression_dict.data()),
+        static_cast<unsigned int>(compression_dict.size()));
+    if (st != Z_OK) {
+      inflateEnd(&_stream);
+      return nullptr;
+    }
+  }
+
   _stream.next_in = (Bytef *)input_data;
   _stream.avail_in = static_cast<unsigned int>(input_length);
 
@@ -330,6 +379,14 @@ inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
         _stream.avail_out = static_cast<unsigned int>(output_len - old_sz);
         break;
       }
+      case Z_NEED_DICT:
+        if (!compression_dict.empty() &&
+            inflateSetDictionary(
+                &_stream, reinterpret_cast<const Bytef*>(compression_dict.data()),
+                static_cast<unsigned int>(compression_dict.size())) == Z_OK) {
+          break;
+        }
+        FALLTHROUGH_INTENDED;
       case Z_BUF_ERROR:
       default:
         delete[] output;
@@ -496,9 +553,12 @@ inline char* BZip2_Uncompress(const char* input_data, size_t input_length,
 // block header using memcpy, which makes database non-portable)
 // compress_format_version == 2 -- decompressed size is included in the block
 // header in varint32 format
+// compression_dict -- dictionary shared by compressed blocks, the same dictionary should be
+// passed to LZ4_Uncompress. Requires LZ4 r124+.
 inline bool LZ4_Compress(const CompressionOptions& opts,
                          uint32_t compress_format_version, const char* input,
-                         size_t length, ::std::string* output) {
+                         size_t length, ::std::string* output,
+                         const Slice& compression_dict = Slice()) {
 #ifdef LZ4
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -521,9 +581,22 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 
   int compressBound = LZ4_compressBound(static_cast<int>(length));
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  int outlen =
-      LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
-                                 static_cast<int>(length), compressBound);
+  int outlen;
+  if (compression_dict.empty()) {
+    outlen = LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
+                                        static_cast<int>(length), compressBound);
+  } else {
+#if LZ4_VERSION_NUMBER >= 10400  // r124+
+    LZ4_stream_t* stream = LZ4_createStream();
+    LZ4_loadDict(stream, compression_dict.cdata(), static_cast<int>(compression_dict.size()));
+    outlen = LZ4_compress_fast_continue(
+        stream, input, &(*output)[output_header_len], static_cast<int>(length), compressBound,
+        1 /* acceleration */);
+    LZ4_freeStream(stream);
+#else
+    return false;
+#endif
+  }
   if (outlen == 0) {
     return false;
   }
@@ -539,7 +612,8 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 // header in varint32 format
 inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
                             int* decompress_size,
-                            uint32_t compress_format_version) {
+                            uint32_t compress_format_version,
+                            const Slice& compression_dict = Slice()) {
 #ifdef LZ4
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -559,9 +633,19 @@ inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
     input_data += 8;
   }
   char* output = new char[output_len];
-  *decompress_size =
-      LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
-                          static_cast<int>(output_len));
+  if (compression_dict.empty()) {
+    *decompress_size =
+        LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
+                            static_cast<int>(output_len));
+  } else {
+#if LZ4_VERSION_NUMBER >= 10400  // r124+
+    *decompress_size = LZ4_decompress_safe_usingDict(
+        input_data, output, static_cast<int>(input_length), static_cast<int>(output_len),
+        compression_dict.cdata(), static_cast<int>(compression_dict.size()));
+#else
+    *decompress_size = -1;
+#endif
+  }
   if (*decompress_size < 0) {
     delete[] output;
     return nullptr;
@@ -620,8 +704,11 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+// compression_dict -- dictionary shared by compressed blocks, the same dictionary should be
+// passed to ZSTD_Uncompress.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +720,18 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+  if (compression_dict.empty()) {
+    outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
+                           input, length, opts.level);
+  } else {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    outlen = ZSTD_compress_usingDict(
+        context, &(*output)[output_header_len], compressBound, input, length,
+        compression_dict.data(), compression_dict.size(), opts.level);
+    ZSTD_freeCCtx(context);
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +741,8 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,8 +751,20 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
+  size_t actual_output_length;
+  if (compression_dict.empty()) {
+    actual_output_length = ZSTD_decompress(output, output_len, input_data, input_length);
+  } else {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    actual_output_length = ZSTD_decompress_usingDict(
+        context, output, output_len, input_data, input_length, compression_dict.data(),
+        compression_dict.size());
+    ZSTD_freeDCtx(context);
+  }
+  if (ZSTD_isError(actual_output_length)) {
+    delete[] output;
+    return nullptr;
+  }
   assert(actual_output_length == output_len);
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
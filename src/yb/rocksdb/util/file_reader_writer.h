@@ -113,6 +113,11 @@ class RandomAccessFileReader {
   CHECKED_STATUS ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch, const yb::ReadValidator& validator);
 
+  // Starts reading specified range of the file into the OS page cache in the background.
+  CHECKED_STATUS Prefetch(uint64_t offset, size_t n) const {
+    return file_->Prefetch(offset, n);
+  }
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
@@ -458,6 +458,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compression_opts.level);
   RHEADER(log, "              Options.compression_opts.strategy: %d",
       compression_opts.strategy);
+  RHEADER(log, "        Options.compression_opts.max_dict_bytes: %" PRIu32,
+      compression_opts.max_dict_bytes);
   RHEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
       level0_file_num_compaction_trigger);
   RHEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
@@ -540,6 +540,12 @@ static std::unordered_map<std::string,
     {"filter_block_size",
      {offsetof(struct BlockBasedTableOptions, filter_block_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"filter_blocks_in_multi_touch_cache",
+     {offsetof(struct BlockBasedTableOptions, filter_blocks_in_multi_touch_cache),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"prefetch_next_filter_block",
+     {offsetof(struct BlockBasedTableOptions, prefetch_next_filter_block),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"block_size_deviation",
      {offsetof(struct BlockBasedTableOptions, block_size_deviation),
       OptionType::kInt, OptionVerificationType::kNormal}},
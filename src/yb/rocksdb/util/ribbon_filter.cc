@@ -0,0 +1,364 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <math.h>
+
+#include <vector>
+
+#include "yb/rocksdb/filter_policy.h"
+
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/logging.h"
+
+#include "yb/util/math_util.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Standard Ribbon filter, see "Ribbon filter: practically smaller than Bloom and Xor" by
+// Peter C. Dillinger and Stefan Walzer.
+//
+// Each key is mapped to a row of a linear system over GF(2): start slot, 64-bit coefficient
+// vector and fingerprint of num_result_bits bits. The filter is a solution of this system, i.e.
+// num_result_bits bits per slot such that for each added key XOR of solution values at slots
+// start + i for each bit i set in coefficients equals to the fingerprint of the key. Since the
+// coefficient vectors of all keys lie in a band of width 64, the system is solved by Gaussian
+// elimination in linear time.
+//
+// The filter needs about 1.08 * num_result_bits bits per key for false positive rate of
+// 2^-num_result_bits, while the Bloom filter needs 1.44 * num_result_bits bits per key (even
+// more for the cache line local Bloom filter).
+//
+// The solution is stored interleaved: for each block of 64 slots there are num_result_bits 64-bit
+// words, word k contains bit k of the solution values of the block. So each result bit of a query
+// is computed as the parity of two shifted words masked with the coefficients, without branches.
+//
+// Encoding:
+// +------------------------------------------------------------------------------------------+
+// |          num_blocks * num_result_bits 64-bit little endian words of solution              |
+// +------------------------------------------------------------------------------------------+
+// | version : 1 byte | num_result_bits : 1 byte | seed : 1 byte | 0 : 1 byte | num_blocks : 4 |
+// +------------------------------------------------------------------------------------------+
+//
+// num_result_bits equal to 0 means that filter could not be built and matches any key.
+
+constexpr size_t kCoeffBits = 64;
+constexpr uint8_t kRibbonFormatVersion = 1;
+constexpr size_t kRibbonMetaDataSize = 8;
+constexpr size_t kMaxResultBits = 32;
+// Max ratio between number of keys and number of slots. With band width of 64 this leaves enough
+// spare slots for the Gaussian elimination to succeed with high probability.
+constexpr double kMaxLoadFactor = 0.92;
+// Number of attempts to build the filter with different hash seeds.
+constexpr uint32_t kMaxSeeds = 16;
+
+inline uint64_t Mix64(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+struct RibbonRow {
+  size_t start;
+  uint64_t coeffs;
+  uint32_t result;
+};
+
+inline RibbonRow MakeRow(uint32_t hash, uint32_t seed, size_t num_starts, uint32_t result_mask) {
+  const uint64_t x = Mix64(
+      ((static_cast<uint64_t>(hash) << 32) | hash) + seed * 0x9e3779b97f4a7c15ULL);
+  RibbonRow row;
+  row.start = static_cast<size_t>((static_cast<unsigned __int128>(x) * num_starts) >> 64);
+  // First coefficient is always set, so the row is never empty.
+  row.coeffs = Mix64(x) | 1;
+  row.result = static_cast<uint32_t>(x) & result_mask;
+  return row;
+}
+
+inline uint32_t ResultMask(size_t num_result_bits) {
+  return num_result_bits >= 32 ? 0xffffffff : (1U << num_result_bits) - 1;
+}
+
+size_t ResultBitsForErrorRate(double error_rate) {
+  DCHECK_GT(error_rate, 0);
+  const auto bits = static_cast<size_t>(ceil(-log2(error_rate)));
+  return std::max<size_t>(1, std::min(bits, kMaxResultBits));
+}
+
+class FixedSizeRibbonFilterBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeRibbonFilterBitsBuilder(const FixedSizeRibbonFilterBitsBuilder&) = delete;
+  void operator=(const FixedSizeRibbonFilterBitsBuilder&) = delete;
+
+  FixedSizeRibbonFilterBitsBuilder(uint32_t total_bits, double error_rate)
+      : num_result_bits_(ResultBitsForErrorRate(error_rate)) {
+    DCHECK_GT(total_bits, 0);
+    max_blocks_ = std::max<size_t>(total_bits / (kCoeffBits * num_result_bits_), 2);
+    // One block is reserved, since the last possible start is 63 slots before the end.
+    max_keys_ = static_cast<size_t>((max_blocks_ - 1) * kCoeffBits * kMaxLoadFactor);
+    hashes_.reserve(max_keys_);
+  }
+
+  // The filter is static, so hashes are buffered till Finish. Keys are added in sorted order, so
+  // consecutive duplicates, that are common after key transformation, are skipped.
+  void AddKey(const Slice& key) override {
+    const uint32_t hash = BloomHash(key);
+    if (hashes_.empty() || hashes_.back() != hash) {
+      hashes_.push_back(hash);
+    }
+  }
+
+  bool IsFull() const override { return hashes_.size() >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override;
+
+ private:
+  // Adds all buffered hashes to the banded system using specified seed. Returns false if the
+  // system became inconsistent.
+  bool Band(uint32_t seed, size_t num_slots);
+
+  // Solves banded system and stores interleaved solution to data.
+  void Solve(size_t num_slots, char* data);
+
+  Slice Encode(
+      size_t num_blocks, size_t num_result_bits, uint32_t seed,
+      std::unique_ptr<const char[]>* buf);
+
+  const size_t num_result_bits_;
+  size_t max_blocks_;
+  size_t max_keys_;
+  std::vector<uint32_t> hashes_;
+
+  // Banded system, row i has its first coefficient at slot i.
+  std::vector<uint64_t> coeffs_;
+  std::vector<uint32_t> results_;
+};
+
+bool FixedSizeRibbonFilterBitsBuilder::Band(uint32_t seed, size_t num_slots) {
+  const size_t num_starts = num_slots - kCoeffBits + 1;
+  const uint32_t result_mask = ResultMask(num_result_bits_);
+  coeffs_.assign(num_slots, 0);
+  results_.assign(num_slots, 0);
+  for (uint32_t hash : hashes_) {
+    RibbonRow row = MakeRow(hash, seed, num_starts, result_mask);
+    size_t i = row.start;
+    for (;;) {
+      if (coeffs_[i] == 0) {
+        coeffs_[i] = row.coeffs;
+        results_[i] = row.result;
+        break;
+      }
+      row.coeffs ^= coeffs_[i];
+      row.result ^= results_[i];
+      if (row.coeffs == 0) {
+        // Row is a linear combination of already added rows. It is fine for hash duplicates, that
+        // also have the same result, otherwise the system has no solution.
+        if (row.result != 0) {
+          return false;
+        }
+        break;
+      }
+      const int shift = __builtin_ctzll(row.coeffs);
+      i += shift;
+      row.coeffs >>= shift;
+    }
+  }
+  return true;
+}
+
+void FixedSizeRibbonFilterBitsBuilder::Solve(size_t num_slots, char* data) {
+  // Back substitution, unused slots get zero value.
+  std::vector<uint32_t> solution(num_slots);
+  for (size_t i = num_slots; i-- > 0;) {
+    uint64_t rest = coeffs_[i] >> 1;
+    uint32_t value = results_[i];
+    while (rest != 0) {
+      value ^= solution[i + 1 + __builtin_ctzll(rest)];
+      rest &= rest - 1;
+    }
+    solution[i] = value;
+  }
+
+  const size_t num_blocks = num_slots / kCoeffBits;
+  for (size_t block = 0; block != num_blocks; ++block) {
+    const uint32_t* values = solution.data() + block * kCoeffBits;
+    for (size_t bit = 0; bit != num_result_bits_; ++bit) {
+      uint64_t word = 0;
+      for (size_t j = 0; j != kCoeffBits; ++j) {
+        word |= static_cast<uint64_t>((values[j] >> bit) & 1) << j;
+      }
+      EncodeFixed64(data + (block * num_result_bits_ + bit) * sizeof(uint64_t), word);
+    }
+  }
+}
+
+Slice FixedSizeRibbonFilterBitsBuilder::Encode(
+    size_t num_blocks, size_t num_result_bits, uint32_t seed,
+    std::unique_ptr<const char[]>* buf) {
+  const size_t data_size = num_blocks * num_result_bits * sizeof(uint64_t);
+  char* data = new char[data_size + kRibbonMetaDataSize];
+  if (num_blocks != 0) {
+    Solve(num_blocks * kCoeffBits, data);
+  }
+  char* meta = data + data_size;
+  meta[0] = static_cast<char>(kRibbonFormatVersion);
+  meta[1] = static_cast<char>(num_result_bits);
+  meta[2] = static_cast<char>(seed);
+  meta[3] = 0;
+  EncodeFixed32(meta + 4, static_cast<uint32_t>(num_blocks));
+  buf->reset(data);
+  return Slice(data, data_size + kRibbonMetaDataSize);
+}
+
+Slice FixedSizeRibbonFilterBitsBuilder::Finish(std::unique_ptr<const char[]>* buf) {
+  Slice result;
+  if (hashes_.empty()) {
+    result = Encode(0, num_result_bits_, 0, buf);
+  } else {
+    // The last filter block of the file usually is not full, so allocate only required number of
+    // slots.
+    const auto num_slots = static_cast<size_t>(ceil(hashes_.size() / kMaxLoadFactor));
+    const size_t num_blocks = std::min(yb::ceil_div(num_slots, kCoeffBits) + 1, max_blocks_);
+    uint32_t seed = 0;
+    while (seed != kMaxSeeds && !Band(seed, num_blocks * kCoeffBits)) {
+      ++seed;
+    }
+    // Practically unreachable, but in this case the filter just matches all keys.
+    result = seed != kMaxSeeds ? Encode(num_blocks, num_result_bits_, seed, buf)
+                               : Encode(0, 0, 0, buf);
+  }
+  hashes_.clear();
+  coeffs_.clear();
+  results_.clear();
+  return result;
+}
+
+class FixedSizeRibbonFilterBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeRibbonFilterBitsReader(const FixedSizeRibbonFilterBitsReader&) = delete;
+  void operator=(const FixedSizeRibbonFilterBitsReader&) = delete;
+
+  FixedSizeRibbonFilterBitsReader(const Slice& contents, Logger* logger)
+      : data_(contents.cdata()) {
+    if (contents.size() < kRibbonMetaDataSize) {
+      SetBroken(logger, contents);
+      return;
+    }
+    const char* meta = contents.cdata() + contents.size() - kRibbonMetaDataSize;
+    const auto version = static_cast<uint8_t>(meta[0]);
+    num_result_bits_ = static_cast<uint8_t>(meta[1]);
+    seed_ = static_cast<uint8_t>(meta[2]);
+    num_blocks_ = DecodeFixed32(meta + 4);
+    if (version != kRibbonFormatVersion || num_result_bits_ > kMaxResultBits ||
+        num_blocks_ * num_result_bits_ * sizeof(uint64_t) + kRibbonMetaDataSize !=
+            contents.size()) {
+      SetBroken(logger, contents);
+      return;
+    }
+    num_starts_ = num_blocks_ != 0 ? num_blocks_ * kCoeffBits - kCoeffBits + 1 : 0;
+    result_mask_ = ResultMask(num_result_bits_);
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (num_result_bits_ == 0) {
+      // Broken filter or filter that could not be built.
+      return true;
+    }
+    if (num_blocks_ == 0) {
+      return false;
+    }
+    const RibbonRow row = MakeRow(BloomHash(entry), seed_, num_starts_, result_mask_);
+    const size_t shift = row.start % kCoeffBits;
+    const size_t block = row.start / kCoeffBits;
+    const char* lo = data_ + block * num_result_bits_ * sizeof(uint64_t);
+    // Next block is not used when shift is 0, and it could be absent in case of the last block.
+    const char* hi = lo + (shift != 0 ? num_result_bits_ * sizeof(uint64_t) : 0);
+    uint32_t found = 0;
+    for (size_t bit = 0; bit != num_result_bits_; ++bit) {
+      const uint64_t lo_word = DecodeFixed64(lo + bit * sizeof(uint64_t));
+      const uint64_t hi_word = DecodeFixed64(hi + bit * sizeof(uint64_t));
+      // (hi_word << 1) << (63 - shift) is 0 for shift 0, avoiding undefined shift by 64.
+      const uint64_t window = (lo_word >> shift) | ((hi_word << 1) << (63 - shift));
+      found |= static_cast<uint32_t>(__builtin_popcountll(window & row.coeffs) & 1) << bit;
+    }
+    return found == row.result;
+  }
+
+ private:
+  void SetBroken(Logger* logger, const Slice& contents) {
+    RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Ribbon filter data is broken, won't be used: %s",
+         contents.ToDebugHexString().substr(0, 64).c_str());
+    FAIL_IF_NOT_PRODUCTION();
+    num_result_bits_ = 0;
+    num_blocks_ = 0;
+  }
+
+  const char* data_;
+  size_t num_result_bits_ = 0;
+  uint32_t seed_ = 0;
+  size_t num_blocks_ = 0;
+  size_t num_starts_ = 0;
+  uint32_t result_mask_ = 0;
+};
+
+class FixedSizeRibbonFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeRibbonFilterPolicy(uint32_t total_bits, double error_rate, Logger* logger)
+      : total_bits_(total_bits),
+        error_rate_(error_rate),
+        logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeRibbonFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeRibbonFilterBitsBuilder(total_bits_, error_rate_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeRibbonFilterBitsReader(contents, logger_);
+  }
+
+ private:
+  uint32_t total_bits_;
+  double error_rate_;
+  Logger* logger_;
+};
+
+} // namespace
+
+const FilterPolicy* NewFixedSizeRibbonFilterPolicy(uint32_t total_bits,
+                                                   double error_rate,
+                                                   Logger* logger) {
+  return new FixedSizeRibbonFilterPolicy(total_bits, error_rate, logger);
+}
+
+}  // namespace rocksdb
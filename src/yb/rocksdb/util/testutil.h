@@ -274,16 +274,31 @@ class StringSource: public RandomAccessFile {
 
   size_t memory_footprint() const override { LOG(FATAL) << "Not supported"; }
 
+  CHECKED_STATUS Prefetch(uint64_t offset, size_t n) override {
+    prefetched_ranges_.emplace_back(offset, n);
+    return Status::OK();
+  }
+
   int total_reads() const { return total_reads_; }
 
   void set_total_reads(int tr) { total_reads_ = tr; }
 
+  // Returns offset and size of each Prefetch call.
+  const std::vector<std::pair<uint64_t, size_t>>& prefetched_ranges() const {
+    return prefetched_ranges_;
+  }
+
+  void clear_prefetched_ranges() { prefetched_ranges_.clear(); }
+
+  const std::string& contents() const { return contents_; }
+
  private:
   std::string filename_ = "StringSource";
   std::string contents_;
   uint64_t uniq_id_;
   bool mmap_;
   mutable int total_reads_;
+  std::vector<std::pair<uint64_t, size_t>> prefetched_ranges_;
 };
 
 class NullLogger : public Logger {
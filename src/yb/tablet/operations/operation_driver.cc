@@ -124,6 +124,7 @@ Status OperationDriver::Init(std::unique_ptr<Operation>* operation, int64_t term
   } else {
     if (consensus_) {  // sometimes NULL in tests
       consensus::ReplicateMsgPtr replicate_msg = operation_->NewReplicateMsg();
+      replicate_msg_byte_size_ = replicate_msg->ByteSizeLong();
       auto round = make_scoped_refptr<ConsensusRound>(consensus_, std::move(replicate_msg));
       round->BindToTerm(term);
       round->SetCallback(this);
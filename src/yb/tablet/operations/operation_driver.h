@@ -200,6 +200,12 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
 
   int64_t SpaceUsed();
 
+  // Serialized size of the replicate message, computed once when the leader side driver builds it.
+  // Zero for follower side drivers.
+  size_t replicate_msg_byte_size() const {
+    return replicate_msg_byte_size_;
+  }
+
  private:
   friend class RefCountedThreadSafe<OperationDriver>;
   enum ReplicationState {
@@ -276,6 +282,8 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   MvccManager* mvcc_ = nullptr;
   HybridTime propagated_safe_time_;
 
+  size_t replicate_msg_byte_size_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(OperationDriver);
 };
 
@@ -198,6 +198,11 @@ Status SnapshotOperation::DoAborted(const Status& status) {
 }
 
 Status SnapshotOperation::DoReplicated(int64_t leader_term, Status* complete_status) {
+  if (tablet()->is_witness()) {
+    // Witness does not have RocksDB to create a snapshot of.
+    return Status::OK();
+  }
+
   RETURN_NOT_OK(Apply(leader_term, complete_status));
   // Record the fact that we've executed the "create snapshot" Raft operation. We are not forcing
   // the flushed frontier to have this exact value, although in practice it will, since this is the
@@ -50,6 +50,11 @@ TransactionCoordinator& UpdateTxnOperation::transaction_coordinator() const {
 Status UpdateTxnOperation::DoReplicated(int64_t leader_term, Status* complete_status) {
   VLOG_WITH_PREFIX(2) << "Replicated";
 
+  if (tablet()->is_witness()) {
+    // Witness does not have intents to apply or remove.
+    return Status::OK();
+  }
+
   auto transaction_participant = tablet()->transaction_participant();
   if (transaction_participant) {
     TransactionParticipant::ReplicatedData data = {
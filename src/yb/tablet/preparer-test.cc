@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/preparer.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_bool(enable_adaptive_group_replicate_batching);
+DECLARE_int32(max_adaptive_group_replicate_batch_size);
+
+namespace yb {
+namespace tablet {
+
+class PreparerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_max_group_replicate_batch_size = 16;
+    FLAGS_max_adaptive_group_replicate_batch_size = 128;
+    FLAGS_enable_adaptive_group_replicate_batching = true;
+  }
+};
+
+TEST_F(PreparerTest, AdaptiveBatchSizeLimit) {
+  AdaptiveBatchSizeLimit limit;
+  ASSERT_EQ(16U, limit.value());
+
+  // Batches cut by the limit while operations are waiting grow the limit up to the max.
+  for (size_t expected : {32U, 64U, 128U, 128U}) {
+    limit.Update(limit.value(), /* queue_depth= */ 10);
+    ASSERT_EQ(expected, limit.value());
+  }
+
+  // Full batch that drained the queue, or batch that is not much smaller than the limit, keep it.
+  limit.Update(128, /* queue_depth= */ 0);
+  ASSERT_EQ(128U, limit.value());
+  limit.Update(64, /* queue_depth= */ 10);
+  ASSERT_EQ(128U, limit.value());
+
+  // Small batches shrink the limit down to max_group_replicate_batch_size.
+  for (size_t expected : {64U, 32U, 16U, 16U}) {
+    limit.Update(1, /* queue_depth= */ 0);
+    ASSERT_EQ(expected, limit.value());
+  }
+
+  // The limit is bounded by the current flag values.
+  limit.Update(16, /* queue_depth= */ 10);
+  ASSERT_EQ(32U, limit.value());
+  FLAGS_max_adaptive_group_replicate_batch_size = 8;
+  limit.Update(32, /* queue_depth= */ 10);
+  ASSERT_EQ(16U, limit.value());
+
+  // Without adaptive batching the limit is max_group_replicate_batch_size.
+  FLAGS_max_adaptive_group_replicate_batch_size = 128;
+  limit.Update(16, /* queue_depth= */ 10);
+  ASSERT_EQ(32U, limit.value());
+  FLAGS_enable_adaptive_group_replicate_batching = false;
+  limit.Update(32, /* queue_depth= */ 10);
+  ASSERT_EQ(16U, limit.value());
+}
+
+} // namespace tablet
+} // namespace yb
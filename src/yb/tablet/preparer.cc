@@ -25,13 +25,44 @@
 #include "yb/tablet/preparer.h"
 #include "yb/tablet/operations/operation_driver.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/lockfree.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(max_group_replicate_batch_size, 16,
-             "Maximum number of operations to submit to consensus for replication in a batch.");
+             "Maximum number of operations to submit to consensus for replication in a batch. "
+             "When adaptive group replicate batching is enabled, this is the lower bound of the "
+             "adaptive limit.");
+
+DEFINE_bool(enable_adaptive_group_replicate_batching, true,
+            "Grow the limit on the number of operations submitted to consensus in a batch while "
+            "operations are waiting in the prepare queue, and shrink it back when the queue is "
+            "drained.");
+TAG_FLAG(enable_adaptive_group_replicate_batching, advanced);
+TAG_FLAG(enable_adaptive_group_replicate_batching, runtime);
+
+DEFINE_int32(max_adaptive_group_replicate_batch_size, 128,
+             "Upper bound of the adaptive limit on the number of operations submitted to consensus "
+             "in a batch.");
+TAG_FLAG(max_adaptive_group_replicate_batch_size, advanced);
+TAG_FLAG(max_adaptive_group_replicate_batch_size, runtime);
+
+DEFINE_int64(max_group_replicate_batch_bytes, 4_MB,
+             "Maximum total size of operations submitted to consensus for replication in a batch. "
+             "0 means no limit.");
+TAG_FLAG(max_group_replicate_batch_bytes, advanced);
+TAG_FLAG(max_group_replicate_batch_bytes, runtime);
+
+METRIC_DEFINE_coarse_histogram(tablet, group_replicate_batch_size,
+                               "Group Replicate Batch Size", yb::MetricUnit::kOperations,
+                               "Number of leader-side operations prepared and submitted to "
+                               "consensus together in a batch.");
 
 DEFINE_test_flag(int32, preparer_batch_inject_latency_ms, 0,
                  "Inject latency before replicating batch.");
@@ -50,7 +81,8 @@ namespace tablet {
 
 class PreparerImpl {
  public:
-  explicit PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
+  PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+               const scoped_refptr<MetricEntity>& tablet_metric_entity);
   ~PreparerImpl();
   CHECKED_STATUS Start();
   void Stop();
@@ -100,6 +132,15 @@ class PreparerImpl {
 
   OperationDrivers leader_side_batch_;
 
+  // Total size of operations in leader_side_batch_, tracked only when
+  // max_group_replicate_batch_bytes is set.
+  int64_t leader_side_batch_bytes_ = 0;
+
+  // Current limit on the number of operations in leader_side_batch_.
+  AdaptiveBatchSizeLimit batch_size_limit_;
+
+  scoped_refptr<Histogram> batch_size_histogram_;
+
   std::unique_ptr<ThreadPoolToken> tablet_prepare_pool_token_;
 
   // A temporary buffer of rounds to replicate, used to reduce reallocation.
@@ -117,10 +158,14 @@ class PreparerImpl {
                          OperationDrivers::iterator end);
 };
 
-PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool)
+PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+                           const scoped_refptr<MetricEntity>& tablet_metric_entity)
     : consensus_(consensus),
       tablet_prepare_pool_token_(tablet_prepare_pool
                                      ->NewToken(ThreadPool::ExecutionMode::SERIAL)) {
+  if (tablet_metric_entity) {
+    batch_size_histogram_ = METRIC_group_replicate_batch_size.Instantiate(tablet_metric_entity);
+  }
 }
 
 PreparerImpl::~PreparerImpl() {
@@ -247,15 +292,20 @@ void PreparerImpl::ProcessItem(OperationDriver* item) {
   const bool apply_separately = ShouldApplySeparately(operation_type);
   const int64_t bound_term = apply_separately ? -1 : item->consensus_round()->bound_term();
 
-  // Don't add more than the max number of operations to a batch, and also don't add
+  const auto max_batch_bytes = GetAtomicFlag(&FLAGS_max_group_replicate_batch_bytes);
+  const int64_t item_bytes = max_batch_bytes > 0 ? item->replicate_msg_byte_size() : 0;
+
+  // Don't add more than the max number of operations or bytes to a batch, and also don't add
   // operations bound to different terms, so as not to fail unrelated operations
   // unnecessarily in case of a bound term mismatch.
-  if (leader_side_batch_.size() >= FLAGS_max_group_replicate_batch_size ||
+  if (leader_side_batch_.size() >= batch_size_limit_.value() ||
       (!leader_side_batch_.empty() &&
-          bound_term != leader_side_batch_.back()->consensus_round()->bound_term())) {
+          (bound_term != leader_side_batch_.back()->consensus_round()->bound_term() ||
+           (max_batch_bytes > 0 && leader_side_batch_bytes_ + item_bytes > max_batch_bytes)))) {
     ProcessAndClearLeaderSideBatch();
   }
   leader_side_batch_.push_back(item);
+  leader_side_batch_bytes_ += item_bytes;
   if (apply_separately) {
     ProcessAndClearLeaderSideBatch();
   }
@@ -268,6 +318,13 @@ void PreparerImpl::ProcessAndClearLeaderSideBatch() {
 
   VLOG(2) << "Preparing a batch of " << leader_side_batch_.size() << " leader-side operations";
 
+  if (batch_size_histogram_) {
+    batch_size_histogram_->Increment(leader_side_batch_.size());
+  }
+  // Number of operations that were submitted to the preparer, but not popped from the queue yet.
+  batch_size_limit_.Update(
+      leader_side_batch_.size(), active_tasks_.load(std::memory_order_acquire));
+
   auto iter = leader_side_batch_.begin();
   auto replication_subbatch_begin = iter;
   auto replication_subbatch_end = iter;
@@ -298,6 +355,7 @@ void PreparerImpl::ProcessAndClearLeaderSideBatch() {
   ReplicateSubBatch(replication_subbatch_begin, replication_subbatch_end);
 
   leader_side_batch_.clear();
+  leader_side_batch_bytes_ = 0;
 }
 
 void PreparerImpl::ReplicateSubBatch(
@@ -338,11 +396,44 @@ void PreparerImpl::ReplicateSubBatch(
   }
 }
 
+// ------------------------------------------------------------------------------------------------
+// AdaptiveBatchSizeLimit
+
+AdaptiveBatchSizeLimit::AdaptiveBatchSizeLimit()
+    : value_(std::max(FLAGS_max_group_replicate_batch_size, 1)) {
+}
+
+void AdaptiveBatchSizeLimit::Update(size_t batch_size, int64_t queue_depth) {
+  const size_t min_limit = std::max(FLAGS_max_group_replicate_batch_size, 1);
+  if (!GetAtomicFlag(&FLAGS_enable_adaptive_group_replicate_batching)) {
+    value_ = min_limit;
+    return;
+  }
+  const size_t max_limit = std::max<size_t>(
+      GetAtomicFlag(&FLAGS_max_adaptive_group_replicate_batch_size), min_limit);
+
+  size_t new_limit = value_;
+  if (batch_size >= value_ && queue_depth > 0) {
+    new_limit = value_ * 2;
+  } else if (batch_size * 4 <= value_) {
+    new_limit = value_ / 2;
+  }
+  new_limit = std::min(std::max(new_limit, min_limit), max_limit);
+
+  if (new_limit != value_) {
+    VLOG(3) << "Changing group replicate batch size limit from " << value_ << " to "
+            << new_limit << ", batch size: " << batch_size << ", queue depth: " << queue_depth;
+    value_ = new_limit;
+  }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Preparer
 
-Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread)
-    : impl_(std::make_unique<PreparerImpl>(consensus, tablet_prepare_thread)) {
+Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread,
+                   const scoped_refptr<MetricEntity>& tablet_metric_entity)
+    : impl_(std::make_unique<PreparerImpl>(
+          consensus, tablet_prepare_thread, tablet_metric_entity)) {
 }
 
 Preparer::~Preparer() = default;
@@ -16,6 +16,8 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/gutil/ref_counted.h"
+
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 
@@ -23,6 +25,7 @@ DECLARE_int32(max_group_replicate_batch_size);
 DECLARE_int32(prepare_queue_max_size);
 
 namespace yb {
+class MetricEntity;
 class ThreadPool;
 
 namespace consensus {
@@ -35,13 +38,35 @@ class OperationDriver;
 
 class PreparerImpl;
 
+// Limit on the number of operations that the preparer submits to consensus in a batch.
+// The limit is doubled when the batch was cut by the limit while more operations are waiting in
+// the queue, and halved when batches are much smaller than the limit, i.e. the tablet is idle.
+// Since the preparer never waits for a batch to fill up, a high limit does not add latency at
+// low load.
+class AdaptiveBatchSizeLimit {
+ public:
+  AdaptiveBatchSizeLimit();
+
+  size_t value() const {
+    return value_;
+  }
+
+  // Adjusts the limit after a batch of the specified size was formed, while queue_depth operations
+  // were waiting in the prepare queue.
+  void Update(size_t batch_size, int64_t queue_depth);
+
+ private:
+  size_t value_;
+};
+
 // This is a thread that invokes the "prepare" step on single-shard transactions and, for
 // leader-side transactions, submits them for replication to the consensus in batches. This is
 // useful because we have a "fat lock" in the consensus.
 // Preparer does not manage a thread but only submits to a token in a thread pool.
 class Preparer {
  public:
-  explicit Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
+  Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+           const scoped_refptr<MetricEntity>& tablet_metric_entity = nullptr);
   ~Preparer();
 
   CHECKED_STATUS Start();
@@ -81,6 +81,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/data_block_hybrid_time_index.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
@@ -279,6 +280,7 @@ DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
+DECLARE_bool(docdb_data_block_hybrid_time_index);
 
 using namespace std::placeholders;
 
@@ -517,7 +519,11 @@ Status Tablet::Open() {
     case TableType::PGSQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
     case TableType::YQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
     case TableType::REDIS_TABLE_TYPE:
-      RETURN_NOT_OK(OpenKeyValueTablet());
+      if (is_witness()) {
+        LOG_WITH_PREFIX(INFO) << "Witness replica, not opening RocksDB";
+      } else {
+        RETURN_NOT_OK(OpenKeyValueTablet());
+      }
       state_ = kBootstrapping;
       return Status::OK();
     case TableType::TRANSACTION_STATUS_TABLE_TYPE:
@@ -668,6 +674,10 @@ Status Tablet::OpenKeyValueTablet() {
         VERIFY_RESULT(docdb::GetConfiguredKeyValueEncodingFormat(
             FLAGS_regular_tablets_data_block_key_value_encoding));
   }
+  if (FLAGS_docdb_data_block_hybrid_time_index) {
+    table_options.data_block_properties_collector_factory =
+        docdb::DocHybridTimeDataBlockPropertiesCollectorFactory();
+  }
   rocksdb::Options rocksdb_options;
   InitRocksDBOptions(
       &rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular), std::move(table_options));
@@ -805,7 +815,7 @@ void Tablet::SetCleanupPool(ThreadPool* thread_pool) {
 void Tablet::CleanupIntentFiles() {
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation();
   if (!scoped_read_operation.ok() || state_ != State::kOpen || !FLAGS_delete_intents_sst_files ||
-      !cleanup_intent_files_token_) {
+      !cleanup_intent_files_token_ || !intents_db_) {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Skip";
     return;
   }
@@ -1138,6 +1148,10 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
 
 Status Tablet::ApplyRowOperations(
     WriteOperation* operation, AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+  if (is_witness()) {
+    return Status::OK();
+  }
+
   const auto& write_request =
       operation->consensus_round() && operation->consensus_round()->replicate_msg()
           // Online case.
@@ -1145,6 +1159,9 @@ Status Tablet::ApplyRowOperations(
           // Bootstrap case.
           : *operation->request();
   const KeyValueWriteBatchPB& put_batch = write_request.write_batch();
+  if (operation->op_id().index <= batch_applied_op_index_.load(std::memory_order_acquire)) {
+    already_applied_to_regular_db = AlreadyAppliedToRegularDB::kTrue;
+  }
   if (metrics_) {
     VLOG(3) << "Applying write batch (write_pairs=" << put_batch.write_pairs().size() << "): "
             << put_batch.ShortDebugString();
@@ -1155,6 +1172,89 @@ Status Tablet::ApplyRowOperations(
       *operation, write_request.batch_idx(), put_batch, already_applied_to_regular_db);
 }
 
+namespace {
+
+// Returns true if data of the write batch goes only to regular DB and does not depend on the
+// state of transactions.
+bool CanApplyWriteInBatch(const KeyValueWriteBatchPB& put_batch) {
+  if (put_batch.has_transaction() || !put_batch.read_pairs().empty() ||
+      !put_batch.apply_external_transactions().empty()) {
+    return false;
+  }
+  for (const auto& pair : put_batch.write_pairs()) {
+    if (!pair.key().empty() && pair.key()[0] == docdb::ValueTypeAsChar::kExternalTransactionId) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int64_t Tablet::ApplyWritesInBatch(const consensus::ConsensusRounds& rounds) {
+  if (is_witness()) {
+    return 0;
+  }
+
+  rocksdb::WriteBatch regular_write_batch;
+  // Batchable operations do not produce intents, see CanApplyWriteInBatch.
+  rocksdb::WriteBatch intents_write_batch;
+  docdb::ConsensusFrontiers frontiers;
+  docdb::ConsensusFrontiers* frontiers_ptr = nullptr;
+  int64_t last_index = 0;
+  // Apply could stop in the middle of the previous batch, so its tail is passed here again.
+  const auto batch_applied_op_index = batch_applied_op_index_.load(std::memory_order_acquire);
+  int64_t already_written_index = 0;
+  for (const auto& round : rounds) {
+    if (round->id().index <= batch_applied_op_index) {
+      already_written_index = round->id().index;
+      continue;
+    }
+    const auto& replicate_msg = *round->replicate_msg();
+    const auto& write_request = replicate_msg.write_request();
+    const auto& put_batch = write_request.write_batch();
+    if (!CanApplyWriteInBatch(put_batch)) {
+      break;
+    }
+
+    const auto op_id = round->id();
+    const HybridTime hybrid_time(replicate_msg.hybrid_time());
+    // Same as WriteOperation::WriteHybridTime.
+    const auto write_hybrid_time = write_request.has_external_hybrid_time()
+        ? HybridTime(write_request.external_hybrid_time()) : hybrid_time;
+    PrepareNonTransactionWriteBatch(
+        put_batch, write_hybrid_time, intents_db_.get(), &regular_write_batch,
+        &intents_write_batch);
+    DCHECK_EQ(intents_write_batch.Count(), 0);
+
+    docdb::ConsensusFrontiers op_frontiers;
+    if (InitFrontiers(op_id, hybrid_time, &op_frontiers)) {
+      auto ttl = put_batch.has_ttl()
+          ? MonoDelta::FromNanoseconds(put_batch.ttl())
+          : docdb::Value::kMaxTtl;
+      op_frontiers.Largest().set_max_value_level_ttl_expiration_time(
+          docdb::FileExpirationFromValueTTL(hybrid_time, ttl));
+      if (frontiers_ptr) {
+        frontiers.MergeFrontiers(op_frontiers);
+      } else {
+        frontiers = op_frontiers;
+        frontiers_ptr = &frontiers;
+      }
+    }
+    last_index = op_id.index;
+  }
+
+  if (last_index == 0) {
+    return already_written_index;
+  }
+
+  VLOG_WITH_PREFIX(3) << "Applying " << regular_write_batch.Count() << " records of operations "
+                      << rounds.front()->id() << " - " << last_index << " in batch";
+  WriteToRocksDB(frontiers_ptr, &regular_write_batch, StorageDbType::kRegular);
+  batch_applied_op_index_.store(last_index, std::memory_order_release);
+  return last_index;
+}
+
 Status Tablet::ApplyOperation(
     const Operation& operation, int64_t batch_idx,
     const docdb::KeyValueWriteBatchPB& write_batch,
@@ -3268,8 +3368,8 @@ Status Tablet::ModifyFlushedFrontier(
 }
 
 Status Tablet::Truncate(TruncateOperation* operation) {
-  if (metadata_->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
-    // We use only Raft log for transaction status table.
+  if (metadata_->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE || is_witness()) {
+    // We use only Raft log for transaction status table and witness replica.
     return Status::OK();
   }
 
@@ -3583,6 +3683,7 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
         read_time_ ? read_time_.read : HybridTime::kMax,
         tablet_.doc_db(), partial_range_key_intents,
         transaction_participant, tablet_.metrics()->transaction_conflicts.get(),
+        &prepare_result_.lock_batch, operation_->deadline(),
         [self = shared_from_this()](const Result<HybridTime>& result) {
           if (!result.ok()) {
             self->InvokeCallback(result.status());
@@ -4025,6 +4126,11 @@ Result<RaftGroupMetadataPtr> Tablet::CreateSubtablet(
   auto metadata = VERIFY_RESULT(metadata_->CreateSubtabletMetadata(
       tablet_id, partition, key_bounds.lower.ToStringBuffer(), key_bounds.upper.ToStringBuffer()));
 
+  if (is_witness()) {
+    // After-split tablets of a witness are witnesses as well, so there is no RocksDB to copy.
+    return metadata;
+  }
+
   RETURN_NOT_OK(snapshots_->CreateCheckpoint(
       metadata->rocksdb_dir(), CreateIntentsCheckpointIn::kSubDir));
 
@@ -47,6 +47,7 @@
 #include "yb/common/transaction.h"
 #include "yb/common/ql_storage_interface.h"
 
+#include "yb/consensus/consensus_fwd.h"
 #include "yb/consensus/log_fwd.h"
 
 #include "yb/docdb/docdb.pb.h"
@@ -326,6 +327,13 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       WriteOperation* operation,
       AlreadyAppliedToRegularDB already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse);
 
+  // Writes data of consecutive committed non-transactional write operations to the regular DB
+  // using a single RocksDB write. Stops at the first operation that should be applied in a
+  // different way. Operations written here skip regular DB when applied by ApplyRowOperations.
+  // Returns index of the last operation of rounds whose data is written to regular DB, or 0 if
+  // there is no such operation.
+  int64_t ApplyWritesInBatch(const consensus::ConsensusRounds& rounds);
+
   CHECKED_STATUS ApplyOperation(
       const Operation& operation, int64_t batch_idx,
       const docdb::KeyValueWriteBatchPB& write_batch,
@@ -671,6 +679,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void FlushIntentsDbIfNecessary(const yb::OpId& lastest_log_entry_op_id);
 
   bool is_sys_catalog() const { return is_sys_catalog_; }
+
+  // Witness replica keeps only WAL and consensus metadata, so it does not open RocksDB and skips
+  // replicated writes.
+  bool is_witness() const { return metadata_->witness(); }
+
   bool IsTransactionalRequest(bool is_ysql_request) const override;
 
   void SetCleanupPool(ThreadPool* thread_pool);
@@ -896,6 +909,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   std::unique_ptr<rocksdb::DB> intents_db_;
   std::atomic<bool> rocksdb_shutdown_requested_{false};
 
+  // Index of the last operation whose data was written to regular DB by ApplyWritesInBatch.
+  std::atomic<int64_t> batch_applied_op_index_{0};
+
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
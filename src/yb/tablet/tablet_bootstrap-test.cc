@@ -47,6 +47,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/path_util.h"
 #include "yb/util/random_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/util/env_util.h"
@@ -167,6 +168,12 @@ class BootstrapTest : public LogTestBase {
   void SetUp() override {
     LogTestBase::SetUp();
     test_hooks_ = std::make_shared<BootstrapTestHooksImpl>();
+    ASSERT_OK(ThreadPoolBuilder("read-ahead").set_max_threads(1).Build(&read_ahead_pool_));
+  }
+
+  void TearDown() override {
+    read_ahead_pool_->Shutdown();
+    LogTestBase::TearDown();
   }
 
   Status LoadTestRaftGroupMetadata(RaftGroupMetadataPtr* meta) {
@@ -222,6 +229,7 @@ class BootstrapTest : public LogTestBase {
       .listener = listener.get(),
       .append_pool = log_thread_pool_.get(),
       .allocation_pool = log_thread_pool_.get(),
+      .read_ahead_pool = read_ahead_pool_.get(),
       .retryable_requests = nullptr,
       .test_hooks = test_hooks_
     };
@@ -264,6 +272,7 @@ class BootstrapTest : public LogTestBase {
   }
 
   std::shared_ptr<BootstrapTestHooksImpl> test_hooks_;
+  std::unique_ptr<ThreadPool> read_ahead_pool_;
 };
 
 // ===============================================================================================
@@ -507,6 +516,85 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Tests replay of the log with several segments, that are read ahead of the replay.
+TEST_F(BootstrapTest, MultiSegmentReplayWithReadAhead) {
+  const int kNumSegments = 5;
+  const int kOpsPerSegment = 10;
+  BuildLog();
+  std::vector<OpId> expected_replayed;
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    if (segment != 0) {
+      ASSERT_OK(RollLog());
+    }
+    for (int i = 0; i != kOpsPerSegment; ++i) {
+      expected_replayed.emplace_back(1, current_index_);
+      AppendReplicateBatchToLog(1);
+    }
+  }
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_VECTORS_EQ(expected_replayed, test_hooks_->actual_report.replayed);
+  ASSERT_EQ(expected_replayed.back(), OpId::FromPB(boot_info.last_id));
+  ASSERT_EQ(expected_replayed.back(), OpId::FromPB(boot_info.last_committed_id));
+}
+
+// Tests that data written by follower apply batch is consistent with flushed op ids when tablet
+// crashes before operations of the batch are applied one by one.
+TEST_F(BootstrapTest, CrashAfterFollowerApplyBatch) {
+  const int kNumOps = 6;
+  const int kNumBatchedOps = 4;
+  const std::string kTestStr("this is a test insert");
+
+  BuildLog();
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+
+  consensus::ConsensusRounds rounds;
+  for (int index = 1; index <= kNumOps; ++index) {
+    auto replicate = std::make_shared<ReplicateMsg>();
+    replicate->set_op_type(consensus::OperationType::WRITE_OP);
+    *replicate->mutable_id() = MakeOpId(1, index);
+    *replicate->mutable_committed_op_id() = MakeOpId(1, index);
+    replicate->set_hybrid_time(clock_->Now().ToUint64());
+    auto* write_request = replicate->mutable_write_request();
+    write_request->set_tablet_id(log::kTestTablet);
+    AddKVToPB(index, 0, kTestStr, write_request->mutable_write_batch());
+    AppendReplicateBatch(replicate);
+    if (index <= kNumBatchedOps) {
+      rounds.push_back(make_scoped_refptr<consensus::ConsensusRound>(
+          nullptr /* consensus */, replicate));
+    }
+  }
+
+  // Write the batch and flush it, but "crash" before any operation is applied.
+  ASSERT_EQ(kNumBatchedOps, tablet->ApplyWritesInBatch(rounds));
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  auto flushed_op_ids = ASSERT_RESULT(tablet->MaxPersistentOpId());
+  ASSERT_EQ(OpId(1, kNumBatchedOps), flushed_op_ids.regular);
+
+  tablet->StartShutdown();
+  tablet->CompleteShutdown();
+  tablet.reset();
+  ASSERT_OK(log_->Close());
+
+  // Only operations after the batch are replayed, and all rows are present.
+  test_hooks_->Clear();
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  std::vector<OpId> expected_replayed;
+  for (int index = kNumBatchedOps + 1; index <= kNumOps; ++index) {
+    expected_replayed.emplace_back(1, index);
+  }
+  ASSERT_VECTORS_EQ(expected_replayed, test_hooks_->actual_report.replayed);
+  ASSERT_EQ(OpId(1, kNumOps), OpId::FromPB(boot_info.last_committed_id));
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumOps, results.size());
+}
+
 struct BootstrapInputEntry {
   const OpId& op_id() const { return batch_data.op_id; }
 
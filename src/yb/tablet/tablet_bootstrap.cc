@@ -119,6 +119,24 @@ DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
                  "Time (in ms) to delay tablet bootstrap by.");
 
+DEFINE_bool(tablet_bootstrap_read_ahead, true,
+            "Read and decode the next log segment on a separate thread, while entries of the "
+            "current segment are replayed. Used only when skip_wal_rewrite is true.");
+TAG_FLAG(tablet_bootstrap_read_ahead, advanced);
+
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_duration_ms,
+                           "Tablet Bootstrap Duration",
+                           yb::MetricUnit::kMilliseconds,
+                           "Time it took to bootstrap the tablet during the last start.");
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_replayed_ops,
+                           "Tablet Bootstrap Replayed Operations",
+                           yb::MetricUnit::kOperations,
+                           "Number of operations read from the log during the last bootstrap.");
+METRIC_DEFINE_gauge_uint64(tablet, tablet_bootstrap_log_read_wait_ms,
+                           "Tablet Bootstrap Log Read Wait Time",
+                           yb::MetricUnit::kMilliseconds,
+                           "Time the last bootstrap spent waiting for log segments to be read.");
+
 namespace yb {
 namespace tablet {
 
@@ -477,12 +495,26 @@ class TabletBootstrap {
         listener_(data.listener),
         append_pool_(data.append_pool),
         allocation_pool_(data.allocation_pool),
+        read_ahead_pool_(data.read_ahead_pool),
       skip_wal_rewrite_(FLAGS_skip_wal_rewrite) ,
         test_hooks_(data.test_hooks) {
   }
 
   ~TabletBootstrap() {}
 
+  // Exposes replay statistics of the bootstrap in metrics of the tablet.
+  void UpdateMetrics(MonoDelta bootstrap_duration, const scoped_refptr<MetricEntity>& entity) {
+    auto set_gauge = [&entity](const GaugePrototype<uint64_t>& prototype, uint64_t value) {
+      auto gauge = prototype.Instantiate(entity, value);
+      gauge->set_value(value);
+      // Nobody else refers these gauges, so they should not be retired.
+      entity->NeverRetire(gauge);
+    };
+    set_gauge(METRIC_tablet_bootstrap_duration_ms, bootstrap_duration.ToMilliseconds());
+    set_gauge(METRIC_tablet_bootstrap_replayed_ops, stats_.ops_read);
+    set_gauge(METRIC_tablet_bootstrap_log_read_wait_ms, stats_.log_read_wait.ToMilliseconds());
+  }
+
   CHECKED_STATUS Bootstrap(
       TabletPtr* rebuilt_tablet,
       scoped_refptr<log::Log>* rebuilt_log,
@@ -1181,6 +1213,19 @@ class TabletBootstrap {
     return iter;
   }
 
+  // Reads entries of the segment on read_ahead_pool_. The segment is read in the calling thread if
+  // the pool does not accept tasks.
+  std::future<log::ReadEntriesResult> ReadSegmentAhead(
+      const scoped_refptr<ReadableLogSegment>& segment) {
+    auto task = std::make_shared<std::packaged_task<log::ReadEntriesResult()>>(
+        [segment] { return segment->ReadEntries(); });
+    auto result = task->get_future();
+    if (!read_ahead_pool_->SubmitFunc([task] { (*task)(); }).ok()) {
+      (*task)();
+    }
+    return result;
+  }
+
   // Plays the log segments into the tablet being built.  The process of playing the segments can
   // work in two modes:
   //
@@ -1236,13 +1281,30 @@ class TabletBootstrap {
     // Find the earliest log segment we need to read, so the rest can be ignored.
     auto iter = FLAGS_skip_flushed_entries ? SkipFlushedEntries(&segments) : segments.begin();
 
+    // Segments are read and decoded on read_ahead_pool_, one segment ahead of the replay.
+    // When the WAL is rewritten, entries are appended to the log while it is replayed, so segments
+    // are read sequentially in that case.
+    const bool read_ahead =
+        skip_wal_rewrite_ && FLAGS_tablet_bootstrap_read_ahead && read_ahead_pool_ != nullptr;
+    std::future<log::ReadEntriesResult> next_read_result;
+    if (read_ahead && iter != segments.end()) {
+      next_read_result = ReadSegmentAhead(*iter);
+    }
+
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      auto read_start = MonoTime::Now();
+      auto read_result = next_read_result.valid() ? next_read_result.get()
+                                                  : segment->ReadEntries();
+      stats_.log_read_wait += MonoTime::Now() - read_start;
+      ++stats_.segments_read;
+      if (read_ahead && std::next(iter) != segments.end()) {
+        next_read_result = ReadSegmentAhead(*std::next(iter));
+      }
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1494,6 +1556,11 @@ class TabletBootstrap {
       return Status::OK();
     }
 
+    if (tablet_->is_witness()) {
+      // Witness does not have intents to apply or remove.
+      return Status::OK();
+    }
+
     auto transaction_participant = tablet_->transaction_participant();
     if (transaction_participant) {
       TransactionParticipant::ReplicatedData replicated_data = {
@@ -1611,6 +1678,9 @@ class TabletBootstrap {
 
   ThreadPool* allocation_pool_;
 
+  // Thread pool for reading log segments ahead of the replay, shared between bootstraps.
+  ThreadPool* read_ahead_pool_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     std::string ToString() const;
@@ -1620,6 +1690,12 @@ class TabletBootstrap {
 
     // Number of REPLICATE messages which were overwritten by later entries.
     int ops_overwritten = 0;
+
+    // Number of log segments read.
+    int segments_read = 0;
+
+    // Time replay waited for log segments to be read and decoded.
+    MonoDelta log_read_wait = MonoDelta::kZero;
   } stats_;
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
@@ -1644,8 +1720,9 @@ class TabletBootstrap {
 // ============================================================================
 
 string TabletBootstrap::Stats::ToString() const {
-  return Format("Read operations: $0, overwritten operations: $1",
-                ops_read, ops_overwritten);
+  return Format("Read operations: $0, overwritten operations: $1, read segments: $2, "
+                    "log read wait: $3",
+                ops_read, ops_overwritten, segments_read, log_read_wait);
 }
 
 CHECKED_STATUS BootstrapTabletImpl(
@@ -1654,10 +1731,14 @@ CHECKED_STATUS BootstrapTabletImpl(
     scoped_refptr<log::Log>* rebuilt_log,
     consensus::ConsensusBootstrapInfo* results) {
   TabletBootstrap tablet_bootstrap(data);
+  auto start = MonoTime::Now();
   auto bootstrap_status = tablet_bootstrap.Bootstrap(rebuilt_tablet, rebuilt_log, results);
   if (!bootstrap_status.ok()) {
     LOG(WARNING) << "T " << (*rebuilt_tablet ? (*rebuilt_tablet)->tablet_id() : "N/A")
                  << " Tablet bootstrap failed: " << bootstrap_status;
+  } else if (*rebuilt_tablet && (*rebuilt_tablet)->GetTabletMetricsEntity()) {
+    tablet_bootstrap.UpdateMetrics(
+        MonoTime::Now() - start, (*rebuilt_tablet)->GetTabletMetricsEntity());
   }
   return bootstrap_status;
 }
@@ -163,6 +163,8 @@ struct BootstrapTabletData {
   TabletStatusListener* listener = nullptr;
   ThreadPool* append_pool = nullptr;
   ThreadPool* allocation_pool = nullptr;
+  // Pool for reading log segments ahead of the replay. Segments are read sequentially if not set.
+  ThreadPool* read_ahead_pool = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
 
   std::shared_ptr<TabletBootstrapTestHooksIf> test_hooks = nullptr;
@@ -488,6 +488,9 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   bool colocated() const;
 
+  // Witness replica keeps only WAL and consensus metadata, and does not have RocksDB.
+  bool witness() const;
+
   Result<std::string> TopSnapshotsDir() const;
 
   // Return standard "T xxx P yyy" log prefix.
@@ -599,6 +602,8 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   bool is_under_twodc_replication_ GUARDED_BY(data_mutex_) = false;
 
+  bool witness_ GUARDED_BY(data_mutex_) = false;
+
   bool hidden_ GUARDED_BY(data_mutex_) = false;
 
   HybridTime restoration_hybrid_time_ GUARDED_BY(data_mutex_) = HybridTime::kMin;
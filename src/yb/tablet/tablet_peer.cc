@@ -186,7 +186,8 @@ Status TabletPeer::InitTabletPeer(
     const scoped_refptr<MetricEntity>& tablet_metric_entity,
     ThreadPool* raft_pool,
     ThreadPool* tablet_prepare_pool,
-    consensus::RetryableRequests* retryable_requests) {
+    consensus::RetryableRequests* retryable_requests,
+    consensus::MultiRaftManager* multi_raft_manager) {
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
 
@@ -267,14 +268,16 @@ Status TabletPeer::InitTabletPeer(
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
     operation_tracker_.SetPostTracker(
         std::bind(&RaftConsensus::TrackOperationMemory, consensus_.get(), _1));
 
-    prepare_thread_ = std::make_unique<Preparer>(consensus_.get(), tablet_prepare_pool);
+    prepare_thread_ = std::make_unique<Preparer>(
+        consensus_.get(), tablet_prepare_pool, tablet_metric_entity);
 
     ChangeConfigReplicated(RaftConfig()); // Set initial flag value.
   }
@@ -1073,6 +1076,10 @@ bool TabletPeer::ShouldApplyWrite() {
   return tablet_->ShouldApplyWrite();
 }
 
+int64_t TabletPeer::ApplyWritesInBatch(const consensus::ConsensusRounds& rounds) {
+  return tablet_->ApplyWritesInBatch(rounds);
+}
+
 consensus::Consensus* TabletPeer::consensus() const {
   return raft_consensus();
 }
@@ -161,7 +161,8 @@ class TabletPeer : public consensus::ConsensusContext,
       const scoped_refptr<MetricEntity>& tablet_metric_entity,
       ThreadPool* raft_pool,
       ThreadPool* tablet_prepare_pool,
-      consensus::RetryableRequests* retryable_requests);
+      consensus::RetryableRequests* retryable_requests,
+      consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -228,6 +229,8 @@ class TabletPeer : public consensus::ConsensusContext,
   // Returns false if it is preferable to don't apply write operation.
   bool ShouldApplyWrite() override;
 
+  int64_t ApplyWritesInBatch(const consensus::ConsensusRounds& rounds) override;
+
   consensus::Consensus* consensus() const;
   consensus::RaftConsensus* raft_consensus() const;
 
@@ -38,6 +38,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/rpc/poller.h"
 #include "yb/rpc/rpc.h"
@@ -169,6 +170,7 @@ class TransactionParticipant::Impl
       status_resolvers.swap(status_resolvers_);
     }
 
+    wait_queue_->Shutdown(STATUS(Aborted, "Transaction participant is shutting down"));
     rpcs_.Shutdown();
     loader_.Shutdown();
     for (auto& resolver : status_resolvers) {
@@ -418,6 +420,40 @@ class TransactionParticipant::Impl
         *client_result, std::move(callback), &lock_and_iterator.lock);
   }
 
+  bool WaitForTransactions(
+      const TransactionId& waiter, const std::vector<TransactionId>& blockers,
+      CoarseTimePoint deadline, StdStatusCallback callback) {
+    if (Closing()) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loader_.complete()) {
+      return false;
+    }
+    for (const auto& id : blockers) {
+      if (transactions_.find(id) == transactions_.end()) {
+        // Blocker was already removed, so conflicts could be resolved again right away.
+        participant_context_.scheduler().Schedule(
+            [callback = std::move(callback)](const Status& status) {
+              callback(status);
+            },
+            std::chrono::steady_clock::duration::zero());
+        return true;
+      }
+    }
+    // Transactions are removed under the same mutex, so blocker could not be missed between the
+    // check above and registering the waiter.
+    return wait_queue_->Wait(waiter, blockers, deadline, std::move(callback));
+  }
+
+  void FillWaitForEdges(docdb::WaitForEdges* edges) {
+    wait_queue_->FillWaitForEdges(edges);
+  }
+
+  void DeadlocksDetected(const TransactionIdSet& waiters) {
+    wait_queue_->DeadlocksDetected(waiters);
+  }
+
   CHECKED_STATUS CheckAborted(const TransactionId& id) {
     // We are not trying to cleanup intents here because we don't know whether this transaction
     // has intents of not.
@@ -1267,6 +1303,14 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    if (wait_queue_->HasWaiters()) {
+      // Waiters resolve conflicts in callbacks, that could require this mutex.
+      participant_context_.scheduler().Schedule(
+          [wait_queue = wait_queue_, id = transaction.id()](const Status&) {
+            wait_queue->TransactionFinished(id);
+          },
+          std::chrono::steady_clock::duration::zero());
+    }
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1410,6 +1454,7 @@ class TransactionParticipant::Impl
         CheckForAbortedTransactions();
       }
     }
+    wait_queue_->Poll(CoarseMonoClock::now());
     CleanupStatusResolvers();
   }
 
@@ -1555,6 +1600,9 @@ class TransactionParticipant::Impl
 
   LRUCache<TransactionId> cleanup_cache_{FLAGS_transactions_cleanup_cache_size};
 
+  // Shared with scheduled notifications about removed transactions.
+  std::shared_ptr<docdb::WaitQueue> wait_queue_ = std::make_shared<docdb::WaitQueue>();
+
   rpc::Poller poller_;
 };
 
@@ -1631,6 +1679,20 @@ void TransactionParticipant::Cleanup(TransactionIdSet&& set) {
   return impl_->Cleanup(std::move(set), this);
 }
 
+bool TransactionParticipant::WaitForTransactions(
+    const TransactionId& waiter, const std::vector<TransactionId>& blockers,
+    CoarseTimePoint deadline, StdStatusCallback callback) {
+  return impl_->WaitForTransactions(waiter, blockers, deadline, std::move(callback));
+}
+
+void TransactionParticipant::FillWaitForEdges(docdb::WaitForEdges* edges) {
+  impl_->FillWaitForEdges(edges);
+}
+
+void TransactionParticipant::DeadlocksDetected(const TransactionIdSet& waiters) {
+  impl_->DeadlocksDetected(waiters);
+}
+
 Status TransactionParticipant::ProcessReplicated(const ReplicatedData& data) {
   return impl_->ProcessReplicated(data);
 }
@@ -31,6 +31,7 @@
 #include "yb/consensus/opid_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -189,6 +190,16 @@ class TransactionParticipant : public TransactionStatusManager {
 
   void Cleanup(TransactionIdSet&& set) override;
 
+  bool WaitForTransactions(
+      const TransactionId& waiter, const std::vector<TransactionId>& blockers,
+      CoarseTimePoint deadline, StdStatusCallback callback) override;
+
+  // Appends wait-for edges of transactions waiting for conflicting transactions on this tablet.
+  void FillWaitForEdges(docdb::WaitForEdges* edges);
+
+  // Fails waits of specified transactions, that are part of deadlocks spanning several tablets.
+  void DeadlocksDetected(const TransactionIdSet& waiters);
+
   // Used to pass arguments to ProcessReplicated.
   struct ReplicatedData {
     int64_t leader_term = -1;
@@ -286,7 +286,7 @@ void ClusterAdminCli::RegisterCommandHandlers(ClusterAdminClientClass* client) {
 
   Register(
       "change_config",
-      " <tablet_id> <ADD_SERVER|REMOVE_SERVER> <peer_uuid> [PRE_VOTER|PRE_OBSERVER]",
+      " <tablet_id> <ADD_SERVER|REMOVE_SERVER> <peer_uuid> [PRE_VOTER|PRE_OBSERVER|WITNESS]",
       [client](const CLIArguments& args) -> Status {
         if (args.size() < 3) {
           return ClusterAdminCli::kInvalidArguments;
@@ -668,8 +668,9 @@ Status ClusterAdminClient::ChangeConfig(
     if (!RaftPeerPB::MemberType_Parse(uppercase_member_type, &member_type_val)) {
       return STATUS(InvalidArgument, "Unrecognized member_type", *member_type);
     }
-    if (member_type_val != RaftPeerPB::PRE_VOTER && member_type_val != RaftPeerPB::PRE_OBSERVER) {
-      return STATUS(InvalidArgument, "member_type should be PRE_VOTER or PRE_OBSERVER");
+    if (member_type_val != RaftPeerPB::PRE_VOTER && member_type_val != RaftPeerPB::PRE_OBSERVER &&
+        member_type_val != RaftPeerPB::WITNESS) {
+      return STATUS(InvalidArgument, "member_type should be PRE_VOTER, PRE_OBSERVER or WITNESS");
     }
     peer_pb.set_member_type(member_type_val);
   }
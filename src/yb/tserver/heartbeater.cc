@@ -408,6 +408,7 @@ Status Heartbeater::Thread::TryHeartbeat() {
   req.mutable_tablet_report()->set_is_incremental(!sending_full_report_);
   req.set_num_live_tablets(server_->tablet_manager()->GetNumLiveTablets());
   req.set_leader_count(server_->tablet_manager()->GetLeaderCount());
+  server_->tablet_manager()->FillWaitForEdges(req.mutable_wait_for_edges());
 
   for (auto& data_provider : data_providers_) {
     data_provider->AddData(last_hb_response_, &req);
@@ -538,6 +539,9 @@ Status Heartbeater::Thread::TryHeartbeat() {
 
   RETURN_NOT_OK(server_->tablet_manager()->UpdateSnapshotsInfo(last_hb_response_.snapshots_info()));
 
+  RETURN_NOT_OK(server_->tablet_manager()->DeadlocksDetected(
+      last_hb_response_.deadlocked_waiters()));
+
   if (last_hb_response_.has_txn_table_versions_hash()) {
     server_->UpdateTxnTableVersionsHash(last_hb_response_.txn_table_versions_hash());
   }
@@ -196,6 +196,7 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
   BeginRemoteBootstrapSessionRequestPB req;
   req.set_requestor_uuid(permanent_uuid());
   req.set_tablet_id(tablet_id_);
+  req.set_witness(witness_);
 
   rpc::RpcController controller;
   controller.set_timeout(MonoDelta::FromMilliseconds(
@@ -383,11 +384,19 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   new_superblock_ = *superblock_;
   // Replace rocksdb_dir with our rocksdb_dir
   new_superblock_.mutable_kv_store()->set_rocksdb_dir(meta_->rocksdb_dir());
+  new_superblock_.set_witness(witness_);
 
-  RETURN_NOT_OK(DownloadRocksDBFiles());
-  RETURN_NOT_OK(DownloadWALs());
-  for (const auto& component : components_) {
-    RETURN_NOT_OK(component->Download());
+  if (witness_) {
+    LOG_WITH_PREFIX(INFO) << "Witness replica, skipping download of RocksDB and snapshot files";
+    new_superblock_.mutable_kv_store()->clear_rocksdb_files();
+    new_superblock_.mutable_kv_store()->clear_snapshot_files();
+    RETURN_NOT_OK(DownloadWALs());
+  } else {
+    RETURN_NOT_OK(DownloadRocksDBFiles());
+    RETURN_NOT_OK(DownloadWALs());
+    for (const auto& component : components_) {
+      RETURN_NOT_OK(component->Download());
+    }
   }
 
   // We sleep here to simulate the transfer of very large files.
@@ -404,7 +413,7 @@ Status RemoteBootstrapClient::Finish() {
   CHECK(started_);
 
   CHECK(downloaded_wal_);
-  CHECK(downloaded_rocksdb_files_) << "files not downloaded";
+  CHECK(downloaded_rocksdb_files_ || witness_) << "files not downloaded";
 
   RETURN_NOT_OK(WriteConsensusMetadata());
 
@@ -453,7 +462,8 @@ Status RemoteBootstrapClient::VerifyChangeRoleSucceeded(
         continue;
       }
 
-      if (peer.member_type() == RaftPeerPB::VOTER || peer.member_type() == RaftPeerPB::OBSERVER) {
+      if (peer.member_type() == RaftPeerPB::VOTER || peer.member_type() == RaftPeerPB::OBSERVER ||
+          peer.member_type() == RaftPeerPB::WITNESS) {
         return Status::OK();
       } else {
         SleepFor(MonoDelta::FromMilliseconds(backoff_ms));
@@ -112,6 +112,12 @@ class RemoteBootstrapClient {
   CHECKED_STATUS SetTabletToReplace(const scoped_refptr<tablet::RaftGroupMetadata>& meta,
                                     int64_t caller_term);
 
+  // Bootstrap a witness replica, copying only WAL segments and consensus metadata.
+  // Should be called before Start().
+  void SetWitness() {
+    witness_ = true;
+  }
+
   // Start up a remote bootstrap session to bootstrap from the specified
   // bootstrap peer. Place a new superblock indicating that remote bootstrap is
   // in progress. If the 'metadata' pointer is passed as NULL, it is ignored,
@@ -205,6 +211,8 @@ class RemoteBootstrapClient {
   // Session-specific data items.
   bool replace_tombstoned_tablet_ = false;
 
+  bool witness_ = false;
+
   bool remove_required_ = false;
 
   // Local tablet metadata file.
@@ -179,7 +179,7 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
     it->second.ResetExpiration();
   }
 
-  RPC_RETURN_NOT_OK(session->Init(),
+  RPC_RETURN_NOT_OK(session->Init(req->witness()),
                     RemoteBootstrapErrorPB::UNKNOWN_ERROR,
                     Substitute("Error initializing remote bootstrap session for tablet $0",
                                tablet_id));
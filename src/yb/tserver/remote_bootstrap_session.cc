@@ -123,6 +123,12 @@ Status RemoteBootstrapSession::ChangeRole() {
     }
 
     switch(peer_pb.member_type()) {
+      case RaftPeerPB::WITNESS:
+        // Witness is added to the config with its final member type.
+        LOG(INFO) << "Peer " << peer_pb.permanent_uuid() << " is a WITNESS, not changing its role "
+                  << "after remote bootstrap";
+        return Status::OK();
+
       case RaftPeerPB::OBSERVER: FALLTHROUGH_INTENDED;
       case RaftPeerPB::VOTER:
         LOG(ERROR) << "Peer " << peer_pb.permanent_uuid() << " is a "
@@ -210,7 +216,7 @@ Result<google::protobuf::RepeatedPtrField<tablet::FilePB>> ListFiles(const std::
 
 const std::string RemoteBootstrapSession::kCheckpointsDir = "checkpoints";
 
-Status RemoteBootstrapSession::Init() {
+Status RemoteBootstrapSession::Init(bool witness) {
   // Take locks to support re-initialization of the same session.
   std::lock_guard<std::mutex> lock(mutex_);
   RETURN_NOT_OK(UnregisterAnchorIfNeededUnlocked());
@@ -239,26 +245,31 @@ Status RemoteBootstrapSession::Init() {
     return STATUS(IllegalState, "Tablet is not running");
   }
 
-  MonoTime now = MonoTime::Now();
   auto* kv_store = tablet_superblock_.mutable_kv_store();
-  const auto checkpoints_dir = JoinPathSegments(kv_store->rocksdb_dir(), kCheckpointsDir);
-
-  auto session_checkpoint_dir = std::to_string(last_logged_opid.index) + "_" + now.ToString();
-  checkpoint_dir_ = JoinPathSegments(checkpoints_dir, session_checkpoint_dir);
 
   // Clear any previous RocksDB files in the superblock. Each session should create a new list
   // based the checkpoint directory files.
   kv_store->clear_rocksdb_files();
-  auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
-  if (status.ok()) {
-    *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
-  } else if (!status.IsNotSupported()) {
-    RETURN_NOT_OK(status);
-  }
+  if (witness) {
+    // Witness keeps only WAL and consensus metadata, so there is no need for a checkpoint.
+    kv_store->clear_snapshot_files();
+  } else {
+    const auto checkpoints_dir = JoinPathSegments(kv_store->rocksdb_dir(), kCheckpointsDir);
+    auto session_checkpoint_dir =
+        std::to_string(last_logged_opid.index) + "_" + MonoTime::Now().ToString();
+    checkpoint_dir_ = JoinPathSegments(checkpoints_dir, session_checkpoint_dir);
+
+    auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
+    if (status.ok()) {
+      *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
+    } else if (!status.IsNotSupported()) {
+      RETURN_NOT_OK(status);
+    }
 
-  for (const auto& source : sources_) {
-    if (source) {
-      RETURN_NOT_OK(source->Init());
+    for (const auto& source : sources_) {
+      if (source) {
+        RETURN_NOT_OK(source->Init());
+      }
     }
   }
 
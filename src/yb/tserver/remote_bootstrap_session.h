@@ -98,7 +98,8 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   // Initialize the session, including anchoring files (TODO) and fetching the
   // tablet superblock and list of WAL segments.
-  CHECKED_STATUS Init();
+  // RocksDB and snapshot files are not listed for a witness requestor.
+  CHECKED_STATUS Init(bool witness = false);
 
   // Return ID of tablet corresponding to this session.
   const std::string& tablet_id() const;
@@ -31,6 +31,7 @@
 //
 
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/consensus.proxy.h"
 
 #include "yb/common/ql_value.h"
 
@@ -642,6 +643,42 @@ TEST_F(TabletServerTest, TestDeleteTablet_TabletNotCreated) {
   ASSERT_TRUE(s.IsNotFound()) << s.ToString();
 }
 
+// Each update in the MultiRaftUpdateConsensus batch should get its own response, and errors of
+// one update should not affect others.
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensus) {
+  const auto& local_uuid = mini_server_->server()->fs_manager()->uuid();
+
+  consensus::MultiRaftConsensusRequestPB req;
+  auto* not_found = req.add_consensus_request();
+  not_found->set_tablet_id("NotPresentTabletId");
+  not_found->set_dest_uuid(local_uuid);
+  not_found->set_caller_uuid("peer");
+  not_found->set_caller_term(0);
+
+  auto* wrong_uuid = req.add_consensus_request();
+  wrong_uuid->CopyFrom(*not_found);
+  wrong_uuid->set_tablet_id(kTabletId);
+  wrong_uuid->set_dest_uuid("WrongUuid");
+
+  // Request from a stale leader is rejected by consensus, but the error is reported in status.
+  auto* stale_term = req.add_consensus_request();
+  stale_term->CopyFrom(*not_found);
+  stale_term->set_tablet_id(kTabletId);
+
+  consensus::MultiRaftConsensusResponsePB resp;
+  rpc::RpcController controller;
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &controller));
+  ASSERT_EQ(3, resp.consensus_response_size());
+
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, resp.consensus_response(0).error().code());
+  ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, resp.consensus_response(1).error().code());
+
+  const auto& stale_term_resp = resp.consensus_response(2);
+  ASSERT_FALSE(stale_term_resp.has_error()) << stale_term_resp.ShortDebugString();
+  ASSERT_TRUE(stale_term_resp.has_status()) << stale_term_resp.ShortDebugString();
+  ASSERT_TRUE(stale_term_resp.has_propagated_hybrid_time());
+}
+
 // Test that with concurrent requests to delete the same tablet, one wins and
 // the other fails, with no assertion failures. Regression test for KUDU-345.
 TEST_F(TabletServerTest, TestConcurrentDeleteTablet) {
@@ -75,6 +75,7 @@
 #include "yb/tserver/tserver_error.h"
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/debug/long_operation_tracker.h"
 #include "yb/util/debug/trace_event.h"
@@ -90,6 +91,7 @@
 #include "yb/util/status_callback.h"
 #include "yb/util/trace.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/tserver/service_util.h"
 
@@ -126,6 +128,11 @@ DEFINE_test_flag(int32, scanner_inject_latency_on_each_batch_ms, 0,
 
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
+DEFINE_int32(multi_raft_update_consensus_threads, 8,
+             "Max number of threads that apply updates from a single MultiRaftUpdateConsensus "
+             "batch in parallel.");
+TAG_FLAG(multi_raft_update_consensus_threads, advanced);
+
 DEFINE_int32(max_wait_for_safe_time_ms, 5000,
              "Maximum time in milliseconds to wait for the safe time to advance when trying to "
              "scan at the given hybrid_time.");
@@ -1800,6 +1807,12 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     // Peer is not the leader, so check that the time since it last heard from the leader is less
     // than FLAGS_max_stale_read_bound_time_ms.
     if (PREDICT_FALSE(!s.ok())) {
+      if (tablet_peer->tablet()->is_witness()) {
+        // Witness does not apply writes to its RocksDB, so client should retry at another replica.
+        SetupErrorAndRespond(resp->mutable_error(), STATUS(IllegalState, "Witness replica"),
+                             TabletServerErrorPB::STALE_FOLLOWER, context);
+        return false;
+      }
       if (FLAGS_max_stale_read_bound_time_ms > 0) {
         shared_ptr <consensus::Consensus> consensus = tablet_peer->shared_consensus();
         // TODO(hector): This safe time could be reused by the read operation.
@@ -2459,9 +2472,13 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
                                            TabletPeerLookupIf* tablet_manager)
     : ConsensusServiceIf(metric_entity),
       tablet_manager_(tablet_manager) {
+  CHECK_OK(ThreadPoolBuilder("multi_raft_update")
+               .set_max_threads(FLAGS_multi_raft_update_consensus_threads)
+               .Build(&multi_raft_update_pool_));
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
+  multi_raft_update_pool_->Shutdown();
 }
 
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
@@ -2503,6 +2520,92 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC: " << req->ShortDebugString();
+  const auto deadline = context.GetClientDeadline();
+  const int count = req->consensus_request_size();
+  for (int idx = 0; idx != count; ++idx) {
+    resp->add_consensus_response();
+  }
+
+  // Updates of different tablets are independent, so apply them in parallel instead of adding up
+  // their latencies. The last one is applied in the RPC thread.
+  CountDownLatch latch(count);
+  for (int idx = 0; idx != count; ++idx) {
+    auto func = [this, req, resp, idx, deadline, &latch] {
+      UpdateConsensusInBatch(
+          &req->consensus_request(idx), resp->mutable_consensus_response(idx), deadline);
+      latch.CountDown();
+    };
+    if (idx == count - 1 || !multi_raft_update_pool_->SubmitFunc(func).ok()) {
+      func();
+    }
+  }
+  latch.Wait();
+  context.RespondSuccess();
+}
+
+void ConsensusServiceImpl::UpdateConsensusInBatch(const ConsensusRequestPB* req,
+                                                  ConsensusResponsePB* resp,
+                                                  CoarseTimePoint deadline) {
+  auto set_error = [resp](const Status& status, TabletServerErrorPB::Code code) {
+    resp->Clear();
+    StatusToPB(status, resp->mutable_error()->mutable_status());
+    resp->mutable_error()->set_code(code);
+  };
+
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  if (PREDICT_FALSE(!req->dest_uuid().empty() && req->dest_uuid() != local_uuid)) {
+    set_error(
+        STATUS_FORMAT(InvalidArgument,
+                      "MultiRaftUpdateConsensus: Wrong destination UUID requested. "
+                          "Local UUID: $0. Requested UUID: $1",
+                      local_uuid, req->dest_uuid()),
+        TabletServerErrorPB::WRONG_SERVER_UUID);
+    return;
+  }
+
+  std::shared_ptr<TabletPeer> tablet_peer;
+  Status s = tablet_manager_->GetTabletPeer(req->tablet_id(), &tablet_peer);
+  if (PREDICT_FALSE(!s.ok())) {
+    set_error(s, s.IsServiceUnavailable() ? TabletServerErrorPB::UNKNOWN_ERROR
+                                          : TabletServerErrorPB::TABLET_NOT_FOUND);
+    return;
+  }
+
+  tablet::RaftGroupStatePB state = tablet_peer->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    set_error(STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state)),
+              TabletServerErrorPB::TABLET_NOT_RUNNING);
+    return;
+  }
+
+  shared_ptr<Consensus> consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    set_error(STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running"),
+              TabletServerErrorPB::TABLET_NOT_RUNNING);
+    return;
+  }
+
+  // See UpdateConsensus for the reason of const_cast.
+  s = consensus->Update(const_cast<ConsensusRequestPB*>(req), resp, deadline);
+  if (PREDICT_FALSE(!s.ok())) {
+    auto ts_error = TabletServerError::FromStatus(s);
+    set_error(s, ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR);
+    return;
+  }
+
+  auto tablet = tablet_peer->shared_tablet();
+  if (tablet) {
+    resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
+  }
+
+  resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
@@ -53,6 +53,7 @@ namespace yb {
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tserver {
 
@@ -290,6 +291,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  virtual void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                        consensus::MultiRaftConsensusResponsePB *resp,
+                                        rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -327,7 +332,16 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies single update from a MultiRaftUpdateConsensus batch. Errors are reported in
+  // resp->error(), since the RPC itself is shared with updates of other tablets.
+  void UpdateConsensusInBatch(const consensus::ConsensusRequestPB* req,
+                              consensus::ConsensusResponsePB* resp,
+                              CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
+
+  // Applies updates of different tablets from the same MultiRaftUpdateConsensus batch in parallel.
+  std::unique_ptr<ThreadPool> multi_raft_update_pool_;
 };
 
 class TabletServerForwardServiceImpl : public TabletServerForwardServiceIf {
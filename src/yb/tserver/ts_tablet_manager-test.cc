@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <set>
@@ -52,7 +53,10 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tablet_memory_manager.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/env.h"
 #include "yb/util/format.h"
+#include "yb/util/path_util.h"
+#include "yb/util/size_literals.h"
 
 #define ASSERT_REPORT_HAS_UPDATED_TABLET(report, tablet_id) \
   ASSERT_NO_FATALS(AssertReportHasUpdatedTablet(report, tablet_id))
@@ -62,6 +66,8 @@
 
 DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
 
+using namespace yb::size_literals;
+
 namespace yb {
 namespace tserver {
 
@@ -303,6 +309,30 @@ TEST_F(TsTabletManagerTest, TestProperBackgroundFlushOnStartup) {
   }
 }
 
+// Tablets with more log to replay should be opened first on startup.
+TEST_F(TsTabletManagerTest, OrderTabletsForBootstrap) {
+  // Size of the extra log segment written to the WAL directory of each tablet.
+  const std::vector<size_t> kExtraLogSizes = {1_MB, 3_MB, 2_MB};
+
+  std::deque<tablet::RaftGroupMetadataPtr> metas;
+  for (size_t i = 0; i != kExtraLogSizes.size(); ++i) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_OK(CreateNewTablet(kTableId, Format("my-tablet-$0", i + 1), schema_, &peer));
+    const auto& meta = peer->tablet_metadata();
+    ASSERT_OK(WriteStringToFile(
+        fs_manager_->env(), std::string(kExtraLogSizes[i], 'x'),
+        JoinPathSegments(meta->wal_dir(), "wal-000000099")));
+    metas.push_back(meta);
+  }
+
+  OrderTabletsForBootstrap(fs_manager_->env(), &metas);
+  std::vector<TabletId> ordered_ids;
+  for (const auto& meta : metas) {
+    ordered_ids.push_back(meta->raft_group_id());
+  }
+  ASSERT_EQ((std::vector<TabletId>{"my-tablet-2", "my-tablet-3", "my-tablet-1"}), ordered_ids);
+}
+
 static void AssertMonotonicReportSeqno(int64_t* report_seqno,
                                        const TabletReportPB &report) {
   ASSERT_LT(*report_seqno, report.sequence_number());
@@ -56,6 +56,7 @@
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
 #include "yb/consensus/raft_consensus.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
 
 #include "yb/docdb/docdb_rocksdb_util.h"
@@ -215,6 +216,12 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
 DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_bool(bootstrap_largest_tablets_first, true,
+            "Open tablets with the largest amount of log to replay first, so long bootstraps do "
+            "not delay the end of the tablet server startup. Transaction status tablets are still "
+            "opened first, when enable_restart_transaction_status_tablets_first is set.");
+TAG_FLAG(bootstrap_largest_tablets_first, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -316,6 +323,51 @@ void TSTabletManager::VerifyTabletData() {
   }
 }
 
+namespace {
+
+// Estimates amount of log that will be replayed during the tablet bootstrap by the total size of
+// its log segments.
+uint64_t EstimateLogReplaySize(Env* env, const RaftGroupMetadata& meta) {
+  auto children = env->GetChildren(meta.wal_dir(), ExcludeDots::kTrue);
+  if (!children.ok()) {
+    return 0;
+  }
+  uint64_t result = 0;
+  for (const auto& child : *children) {
+    if (!log::IsLogFileName(child)) {
+      continue;
+    }
+    auto size = env->GetFileSize(JoinPathSegments(meta.wal_dir(), child));
+    if (size.ok()) {
+      result += *size;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+void OrderTabletsForBootstrap(Env* env, std::deque<RaftGroupMetadataPtr>* metas) {
+  std::unordered_map<const RaftGroupMetadata*, uint64_t> replay_sizes;
+  for (const auto& meta : *metas) {
+    replay_sizes[meta.get()] = EstimateLogReplaySize(env, *meta);
+  }
+  auto first_priority = [](const RaftGroupMetadataPtr& meta) {
+    return FLAGS_enable_restart_transaction_status_tablets_first &&
+           meta->table_type() == TRANSACTION_STATUS_TABLE_TYPE;
+  };
+  std::stable_sort(
+      metas->begin(), metas->end(),
+      [&replay_sizes, &first_priority](const auto& lhs, const auto& rhs) {
+        auto lhs_first = first_priority(lhs);
+        auto rhs_first = first_priority(rhs);
+        if (lhs_first != rhs_first) {
+          return lhs_first;
+        }
+        return replay_sizes[lhs.get()] > replay_sizes[rhs.get()];
+      });
+}
+
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
                                  TabletServer* server,
                                  MetricRegistry* metric_registry)
@@ -431,6 +483,13 @@ Status TSTabletManager::Init() {
                 .set_max_threads(max_bootstrap_threads)
                 .set_metrics(std::move(bootstrap_metrics))
                 .Build(&open_tablet_pool_));
+  // Each bootstrap reads at most one log segment ahead.
+  RETURN_NOT_OK(ThreadPoolBuilder("bootstrap-read-ahead")
+                .set_max_threads(max_bootstrap_threads)
+                .Build(&bootstrap_read_ahead_pool_));
+
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
 
   CleanupCheckpoints();
 
@@ -473,6 +532,12 @@ Status TSTabletManager::Init() {
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
             << elapsed.ToMilliseconds() << " ms";
 
+  if (FLAGS_bootstrap_largest_tablets_first) {
+    // open_tablet_pool_ bootstraps a bounded number of tablets at once, so starting the longest
+    // bootstraps first shortens the total startup time.
+    OrderTabletsForBootstrap(fs_manager_->env(), &metas);
+  }
+
   // Now submit the "Open" task for each.
   for (const RaftGroupMetadataPtr& meta : metas) {
     scoped_refptr<TransitionInProgressDeleter> deleter;
@@ -1042,6 +1107,9 @@ Status TSTabletManager::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB
   TRACE(init_msg);
 
   auto rb_client = std::make_unique<RemoteBootstrapClient>(tablet_id, fs_manager_);
+  if (req.witness()) {
+    rb_client->SetWitness();
+  }
 
   // Download and persist the remote superblock in TABLET_DATA_COPYING state.
   if (replacing_tablet) {
@@ -1370,6 +1438,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .listener = tablet_peer->status_listener(),
       .append_pool = append_pool(),
       .allocation_pool = allocation_pool_.get(),
+      .read_ahead_pool = bootstrap_read_ahead_pool_.get(),
       .retryable_requests = &retryable_requests,
     };
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
@@ -1393,7 +1462,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         tablet->GetTabletMetricsEntity(),
         raft_pool(),
         tablet_prepare_pool(),
-        &retryable_requests);
+        &retryable_requests,
+        multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1521,6 +1591,9 @@ void TSTabletManager::StartShutdown() {
 
   // Shut down the bootstrap pool, so new tablets are registered after this point.
   open_tablet_pool_->Shutdown();
+  if (bootstrap_read_ahead_pool_) {
+    bootstrap_read_ahead_pool_->Shutdown();
+  }
 
   // Take a snapshot of the peers list -- that way we don't have to hold
   // on to the lock while shutting them down, which might cause a lock
@@ -2364,6 +2437,43 @@ Status TSTabletManager::UpdateSnapshotsInfo(const master::TSSnapshotsInfoPB& inf
   return Status::OK();
 }
 
+void TSTabletManager::FillWaitForEdges(
+    google::protobuf::RepeatedPtrField<master::WaitForEdgePB>* out) {
+  docdb::WaitForEdges edges;
+  for (const auto& peer : GetTabletPeers()) {
+    auto tablet = peer->shared_tablet();
+    auto* participant = tablet ? tablet->transaction_participant() : nullptr;
+    if (participant) {
+      participant->FillWaitForEdges(&edges);
+    }
+  }
+  for (const auto& edge : edges) {
+    auto* edge_pb = out->Add();
+    edge_pb->set_waiter(edge.first.data(), edge.first.size());
+    edge_pb->set_blocker(edge.second.data(), edge.second.size());
+  }
+}
+
+Status TSTabletManager::DeadlocksDetected(
+    const google::protobuf::RepeatedPtrField<std::string>& waiters) {
+  if (waiters.empty()) {
+    return Status::OK();
+  }
+  TransactionIdSet ids;
+  for (const auto& waiter : waiters) {
+    ids.insert(VERIFY_RESULT(FullyDecodeTransactionId(waiter)));
+  }
+  LOG_WITH_PREFIX(INFO) << "Deadlocks detected, failing waits of: " << AsString(ids);
+  for (const auto& peer : GetTabletPeers()) {
+    auto tablet = peer->shared_tablet();
+    auto* participant = tablet ? tablet->transaction_participant() : nullptr;
+    if (participant) {
+      participant->DeadlocksDetected(ids);
+    }
+  }
+  return Status::OK();
+}
+
 HybridTime TSTabletManager::AllowedHistoryCutoff(tablet::RaftGroupMetadata* metadata) {
   auto schedules = metadata->SnapshotSchedules();
   if (schedules.empty()) {
@@ -32,6 +32,7 @@
 #ifndef YB_TSERVER_TS_TABLET_MANAGER_H
 #define YB_TSERVER_TS_TABLET_MANAGER_H
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -75,6 +76,7 @@
 
 namespace yb {
 
+class Env;
 class GarbageCollector;
 class PartitionSchema;
 class FsManager;
@@ -319,6 +321,13 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   CHECKED_STATUS UpdateSnapshotsInfo(const master::TSSnapshotsInfoPB& info);
 
+  // Fills wait-for edges of transactions waiting for conflicting transactions on tablets of this
+  // server.
+  void FillWaitForEdges(google::protobuf::RepeatedPtrField<master::WaitForEdgePB>* out);
+
+  // Fails waits of transactions that master found in deadlocks spanning several tablets.
+  CHECKED_STATUS DeadlocksDetected(const google::protobuf::RepeatedPtrField<std::string>& waiters);
+
   // Background task that verifies the data on each tablet for consistency.
   void VerifyTabletData();
 
@@ -540,6 +549,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool used to open the tablets async, whether bootstrap is required or not.
   std::unique_ptr<ThreadPool> open_tablet_pool_;
 
+  // Thread pool used by bootstraps to read log segments ahead of the replay.
+  std::unique_ptr<ThreadPool> bootstrap_read_ahead_pool_;
+
   // Thread pool for preparing transactions, shared between all tablets.
   std::unique_ptr<ThreadPool> tablet_prepare_pool_;
 
@@ -555,6 +567,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool for log allocation threads, shared between all tablets.
   std::unique_ptr<ThreadPool> allocation_pool_;
 
+  // Batches heartbeats of tablet leaders hosted on this server, shared between all tablets.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
@@ -644,6 +659,11 @@ Status HandleReplacingStaleTablet(scoped_refptr<tablet::RaftGroupMetadata> meta,
                                   const std::string& uuid,
                                   const int64_t& leader_term);
 
+// Orders tablets to open on startup. Transaction status tablets go first when
+// enable_restart_transaction_status_tablets_first is set, followed by tablets with the largest
+// amount of log to replay.
+void OrderTabletsForBootstrap(Env* env, std::deque<tablet::RaftGroupMetadataPtr>* metas);
+
 CHECKED_STATUS ShutdownAndTombstoneTabletPeerNotOk(
     const Status& status, const tablet::TabletPeerPtr& tablet_peer,
     const tablet::RaftGroupMetadataPtr& meta, const std::string& uuid, const char* msg,
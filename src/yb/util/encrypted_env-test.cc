@@ -59,5 +59,31 @@ TEST_F(TestEncryptedEnv, FileOps) {
   }
 }
 
+TEST_F(TestEncryptedEnv, AppendSlices) {
+  auto header_manager = GetMockHeaderManager();
+  down_cast<HeaderManagerMockImpl*>(header_manager.get())->SetFileEncryption(true);
+
+  auto env = yb::NewEncryptedEnv(std::move(header_manager));
+  auto bytes = RandomBytes(kDataSize);
+  Slice data(bytes.data(), kDataSize);
+
+  string fname;
+  std::unique_ptr<WritableFile> writable_file;
+  ASSERT_OK(env->NewTempWritableFile(
+      WritableFileOptions(), "test-fileXXXXXX", &fname, &writable_file));
+  const Slice slices[] = {
+      Slice(data.data(), kDataSize / 3),
+      Slice(data.data() + kDataSize / 3, data.data() + kDataSize),
+  };
+  ASSERT_OK(writable_file->AppendSlices(slices, arraysize(slices)));
+  ASSERT_OK(writable_file->Close());
+
+  std::unique_ptr<RandomAccessFile> ra_file;
+  ASSERT_OK(env->NewRandomAccessFile(fname, &ra_file));
+  TestRandomAccessReads<RandomAccessFile, uint8_t>(ra_file.get(), data);
+
+  ASSERT_OK(env->DeleteFile(fname));
+}
+
 } // namespace enterprise
 } // namespace yb
@@ -49,6 +49,10 @@ class EncryptedRandomAccessFile : public RandomAccessFileWrapper {
     return VERIFY_RESULT(RandomAccessFileWrapper::Size()) - header_size_;
   }
 
+  CHECKED_STATUS Prefetch(uint64_t offset, size_t length) override {
+    return RandomAccessFileWrapper::Prefetch(offset + header_size_, length);
+  }
+
   virtual bool IsEncrypted() const override {
     return true;
   }
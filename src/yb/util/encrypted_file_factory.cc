@@ -49,6 +49,14 @@ class EncryptedWritableFile : public WritableFileWrapper {
     return Status::OK();
   }
 
+  // Each slice has to be encrypted at its own offset, so it is not passed to the wrapped file.
+  Status AppendSlices(const Slice* slices, size_t num) override {
+    for (auto end = slices + num; slices != end; ++slices) {
+      RETURN_NOT_OK(Append(*slices));
+    }
+    return Status::OK();
+  }
+
  private:
   std::unique_ptr<BlockAccessCipherStream> stream_;
   uint32_t header_size_;
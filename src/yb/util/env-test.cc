@@ -619,6 +619,29 @@ TEST_F(TestEnv, TestReopen) {
   ASSERT_EQ(first + second, s.ToString());
 }
 
+TEST_F(TestEnv, TestMapForRead) {
+  string test_path = GetTestPath("test_env_wf");
+  string data = "The quick brown fox jumps over the lazy dog";
+
+  shared_ptr<WritableFile> writer;
+  ASSERT_OK(env_util::OpenFileForWrite(env_.get(), test_path, &writer));
+  ASSERT_OK(writer->Append(data));
+  ASSERT_OK(writer->Close());
+
+  shared_ptr<RandomAccessFile> reader;
+  ASSERT_OK(env_util::OpenFileForRandom(env_.get(), test_path, &reader));
+  auto mapped = ASSERT_RESULT(reader->MapForRead());
+  ASSERT_EQ(data, mapped.ToBuffer());
+  // The file is mapped only once.
+  ASSERT_EQ(mapped.data(), ASSERT_RESULT(reader->MapForRead()).data());
+
+  // Wrapper does not expose raw content of the file it wraps.
+  std::unique_ptr<RandomAccessFile> file;
+  ASSERT_OK(env_->NewRandomAccessFile(test_path, &file));
+  RandomAccessFileWrapper wrapper(std::move(file));
+  ASSERT_TRUE(wrapper.MapForRead().status().IsNotSupported());
+}
+
 TEST_F(TestEnv, TestIsDirectory) {
   string dir = GetTestPath("a_directory");
   ASSERT_OK(env_->CreateDir(dir));
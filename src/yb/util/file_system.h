@@ -182,6 +182,21 @@ class RandomAccessFile : public FileWithUniqueId {
   virtual Status InvalidateCache(size_t offset, size_t length) {
     return STATUS(NotSupported, "InvalidateCache not supported.");
   }
+
+  // Asks the system to start reading the specified range of the file into its cache in the
+  // background, so subsequent reads of this range don't have to wait for the disk.
+  virtual Status Prefetch(uint64_t offset, size_t length) {
+    return STATUS(NotSupported, "Prefetch not supported.");
+  }
+
+  // Maps the whole file to memory for reading and returns its content. The mapping is created on
+  // the first call and stays valid while the file is alive, so the file should not be modified.
+  // Raw content of the file is mapped, so RandomAccessFileWrapper does not forward this call,
+  // since wrappers could transform the content, e.g. decrypt it.
+  // An I/O error while the mapped data is accessed is delivered as SIGBUS instead of status.
+  virtual Result<Slice> MapForRead() {
+    return STATUS(NotSupported, "MapForRead not supported.");
+  }
 };
 
 class SequentialFileWrapper : public SequentialFile {
@@ -242,6 +257,10 @@ class RandomAccessFileWrapper : public RandomAccessFile {
     return target_->InvalidateCache(offset, length);
   }
 
+  Status Prefetch(uint64_t offset, size_t length) override {
+    return target_->Prefetch(offset, length);
+  }
+
  private:
   std::unique_ptr<RandomAccessFile> target_;
 };
@@ -16,6 +16,7 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -28,6 +29,7 @@
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
+#include "yb/util/logging.h"
 #include "yb/util/malloc.h"
 #include "yb/util/thread_restrictions.h"
 
@@ -157,7 +159,12 @@ PosixRandomAccessFile::PosixRandomAccessFile(const std::string& fname, int fd,
   assert(!options.use_mmap_reads || sizeof(void*) < 8);
 }
 
-PosixRandomAccessFile::~PosixRandomAccessFile() { close(fd_); }
+PosixRandomAccessFile::~PosixRandomAccessFile() {
+  if (mapped_data_ && munmap(mapped_data_, mapped_size_) != 0) {
+    LOG(WARNING) << "Failed to unmap " << filename_ << ": " << ErrnoToString(errno);
+  }
+  close(fd_);
+}
 
 Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
                                    uint8_t* scratch) const {
@@ -259,4 +266,34 @@ Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #endif
 }
 
+Status PosixRandomAccessFile::Prefetch(uint64_t offset, size_t length) {
+#ifndef __linux__
+  return STATUS(NotSupported, "Prefetch not supported.");
+#else
+  // Unlike reading, readahead does not wait for the data, unless the device request queue is full.
+  if (readahead(fd_, offset, length) == 0) {
+    return Status::OK();
+  }
+  return STATUS_IO_ERROR(filename_, errno);
+#endif
+}
+
+Result<Slice> PosixRandomAccessFile::MapForRead() {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  if (!mapped_data_) {
+    auto size = VERIFY_RESULT(Size());
+    if (size == 0) {
+      return Slice();
+    }
+    ThreadRestrictions::AssertIOAllowed();
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    mapped_data_ = static_cast<uint8_t*>(data);
+    mapped_size_ = size;
+  }
+  return Slice(mapped_data_, mapped_size_);
+}
+
 } // namespace yb
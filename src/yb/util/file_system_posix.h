@@ -14,6 +14,8 @@
 #ifndef YB_UTIL_FILE_SYSTEM_POSIX_H
 #define YB_UTIL_FILE_SYSTEM_POSIX_H
 
+#include <mutex>
+
 #include "yb/util/file_system.h"
 
 namespace yb {
@@ -63,11 +65,17 @@ class PosixRandomAccessFile : public RandomAccessFile {
 #endif
   virtual void Hint(AccessPattern pattern) override;
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
+  CHECKED_STATUS Prefetch(uint64_t offset, size_t length) override;
+  Result<Slice> MapForRead() override;
 
  private:
   std::string filename_;
   int fd_;
   bool use_os_buffer_;
+
+  std::mutex map_mutex_;
+  uint8_t* mapped_data_ = nullptr;
+  size_t mapped_size_ = 0;
 };
 
 } // namespace yb
@@ -412,6 +412,12 @@ Status PgTxnManager::CommitTransaction() {
   return status;
 }
 
+void PgTxnManager::SetLastFlushBeforeCommit() {
+  if (txn_in_progress_ && txn_) {
+    txn_->SetLastFlushBeforeCommit();
+  }
+}
+
 void PgTxnManager::AbortTransaction() {
   // If a DDL operation during a DDL txn fails the txn will be aborted before we get here.
   // However if there are failures afterwards (i.e. during COMMIT or catalog version increment),
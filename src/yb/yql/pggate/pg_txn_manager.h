@@ -67,6 +67,8 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   CHECKED_STATUS MaybeResetTransactionReadPoint();
   CHECKED_STATUS CommitTransaction();
   void AbortTransaction();
+  // Notifies transaction that the next flush of buffered operations is the last one before commit.
+  void SetLastFlushBeforeCommit();
   CHECKED_STATUS SetIsolationLevel(int isolation);
   CHECKED_STATUS SetReadOnly(bool read_only);
   CHECKED_STATUS EnableFollowerReads(bool enable_follower_reads, int32_t staleness);
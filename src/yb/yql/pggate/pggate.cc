@@ -1387,6 +1387,7 @@ Status PgApiImpl::MaybeResetTransactionReadPoint() {
 
 Status PgApiImpl::CommitTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
+  pg_txn_manager_->SetLastFlushBeforeCommit();
   RETURN_NOT_OK(pg_session_->FlushBufferedOperations());
   return pg_txn_manager_->CommitTransaction();
 }